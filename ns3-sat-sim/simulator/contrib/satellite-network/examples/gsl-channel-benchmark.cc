@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/gsl-channel.h"
+#include "ns3/gsl-net-device.h"
+
+using namespace ns3;
+
+/**
+ * Micro-benchmark of the per-packet cost of GSLChannel::TransmitStart() with many
+ * attached network devices. It is measured both for devices with a contiguous MAC address
+ * range (as installed by the GSLHelper, direct index look-up) and for devices of which
+ * the MAC addresses are scattered (fall-back to the MAC address map).
+ */
+double benchmark_ns_per_packet(uint32_t num_devices, uint32_t num_packets, bool contiguous_macs) {
+
+    // Nodes with a position
+    NodeContainer nodes;
+    nodes.Create(num_devices);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+    for (uint32_t i = 0; i < num_devices; i++) {
+        nodes.Get(i)->GetObject<MobilityModel>()->SetPosition(Vector(i * 1000.0, 0.0, 550000.0));
+    }
+
+    // One network device per node, all attached to the same channel
+    GSLHelper gsl_helper;
+    Ptr<GSLChannel> channel = CreateObject<GSLChannel>();
+    std::vector<Ptr<GSLNetDevice>> devices;
+    std::vector<Address> addresses;
+    for (uint32_t i = 0; i < num_devices; i++) {
+        if (!contiguous_macs) {
+            Mac48Address::Allocate(); // Leave a gap in the range
+        }
+        devices.push_back(gsl_helper.Install(nodes.Get(i), channel));
+        addresses.push_back(devices.back()->GetAddress());
+    }
+
+    // Random source-destination pairs
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (uint32_t i = 0; i < num_packets; i++) {
+        pairs.push_back(std::make_pair(random->GetInteger(0, num_devices - 1), random->GetInteger(0, num_devices - 1)));
+    }
+
+    // Transmit (the arrival events are scheduled, but never run)
+    Ptr<Packet> packet = Create<Packet>(1500);
+    Time txTime = MicroSeconds(120);
+    auto start = std::chrono::steady_clock::now();
+    for (const std::pair<uint32_t, uint32_t>& pair : pairs) {
+        channel->TransmitStart(packet, devices[pair.first], addresses[pair.second], txTime);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    Simulator::Destroy();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (double) num_packets;
+}
+
+int main(int argc, char *argv[]) {
+
+    uint32_t num_devices = 10000;
+    uint32_t num_packets = 200000;
+    CommandLine cmd;
+    cmd.AddValue("num_devices", "Number of network devices attached to the GSL channel", num_devices);
+    cmd.AddValue("num_packets", "Number of packets transmitted", num_packets);
+    cmd.Parse(argc, argv);
+
+    std::cout << "GSL CHANNEL BENCHMARK" << std::endl;
+    std::cout << "  > Devices attached.............. " << num_devices << std::endl;
+    std::cout << "  > Packets transmitted........... " << num_packets << std::endl;
+    std::cout << "  > Contiguous MACs (direct index) " << benchmark_ns_per_packet(num_devices, num_packets, true) << " ns/packet" << std::endl;
+    std::cout << "  > Scattered MACs (hash map)..... " << benchmark_ns_per_packet(num_devices, num_packets, false) << " ns/packet" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+using namespace ns3;
+
+/**
+ * ARP cache as populated for a +grid constellation: the GSL interface of every satellite and
+ * ground station, and optionally also the four ISL interfaces of every satellite. The GSL
+ * addresses are returned in gsl_addresses.
+ */
+Ptr<ArpCache> create_arp_cache(uint32_t num_satellites, uint32_t num_ground_stations, bool include_isls, std::vector<Ipv4Address>& gsl_addresses) {
+    Ptr<ArpCache> cache = CreateObject<ArpCache>();
+    cache->SetAliveTimeout(Seconds(3600 * 24 * 365));
+    gsl_addresses.clear();
+    uint32_t network = 0;
+    auto add = [&](bool is_gsl) {
+        Ipv4Address address(0x0A000001 + (network << 8)); // 10.x.y.1, one network per interface
+        network++;
+        ArpCache::Entry* entry = cache->Add(address);
+        entry->SetMacAddress(Mac48Address::Allocate());
+        if (is_gsl) {
+            gsl_addresses.push_back(address);
+        }
+    };
+    for (uint32_t i = 0; i < num_satellites; i++) {
+        for (uint32_t j = 0; include_isls && j < 4; j++) {
+            add(false);
+        }
+        add(true);
+    }
+    for (uint32_t i = 0; i < num_ground_stations; i++) {
+        add(true);
+    }
+    return cache;
+}
+
+/**
+ * Time (ns) per lookup of the next hop MAC address of a packet sent over a GSL, done as by
+ * ArpL3Protocol::Lookup() for a cache hit, over random GSL addresses.
+ */
+double time_per_lookup_ns(Ptr<ArpCache> cache, const std::vector<Ipv4Address>& gsl_addresses, uint32_t num_lookups) {
+    std::mt19937 rng(123456789);
+    std::uniform_int_distribution<size_t> uniform(0, gsl_addresses.size() - 1);
+    std::vector<Ipv4Address> lookups;
+    for (uint32_t i = 0; i < num_lookups; i++) {
+        lookups.push_back(gsl_addresses[uniform(rng)]);
+    }
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const Ipv4Address& address : lookups) {
+        ArpCache::Entry* entry = cache->Lookup(address);
+        if (entry != 0 && !entry->IsExpired()) {
+            uint8_t buffer[6];
+            Mac48Address::ConvertFrom(entry->GetMacAddress()).CopyTo(buffer);
+            checksum += buffer[5];
+        }
+    }
+    double elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    NS_ABORT_MSG_IF(checksum == 0 && num_lookups > 256, "Lookups did not find the GSL addresses");
+    return elapsed_ns / num_lookups;
+}
+
+/**
+ * Compares the ARP cache of all interfaces against the one of only the GSL interfaces (as
+ * now populated by the topology), on the time to populate it and per packet sent over a GSL.
+ */
+int main(int argc, char *argv[]) {
+
+    uint32_t num_satellites = 1584;
+    uint32_t num_ground_stations = 100;
+    uint32_t num_lookups = 10000000;
+    CommandLine cmd;
+    cmd.AddValue("num_satellites", "Number of satellites (four ISLs and one GSL each)", num_satellites);
+    cmd.AddValue("num_ground_stations", "Number of ground stations (one GSL each)", num_ground_stations);
+    cmd.AddValue("num_lookups", "Number of lookups timed", num_lookups);
+    cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(num_satellites + num_ground_stations == 0, "There must be at least one GSL interface");
+
+    std::cout << "ARP CACHE BENCHMARK" << std::endl;
+    std::cout << "  > Satellites............... " << num_satellites << std::endl;
+    std::cout << "  > Ground stations.......... " << num_ground_stations << std::endl;
+    for (bool include_isls : {true, false}) {
+        std::vector<Ipv4Address> gsl_addresses;
+        auto start = std::chrono::steady_clock::now();
+        Ptr<ArpCache> cache = create_arp_cache(num_satellites, num_ground_stations, include_isls, gsl_addresses);
+        double populate_s = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+        uint32_t num_entries = (include_isls ? 5 : 1) * num_satellites + num_ground_stations;
+        std::cout << "  > " << (include_isls ? "All interfaces" : "GSL interfaces only") << std::endl;
+        std::cout << "    >> Entries.............. " << num_entries << std::endl;
+        std::cout << "    >> Populate............. " << populate_s * 1e3 << " ms" << std::endl;
+        std::cout << "    >> Per GSL packet....... " << time_per_lookup_ns(cache, gsl_addresses, num_lookups) << " ns" << std::endl;
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
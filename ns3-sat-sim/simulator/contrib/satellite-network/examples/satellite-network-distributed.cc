@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/arbiter-single-forward-helper.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/gsl-if-bandwidth-helper.h"
+
+using namespace ns3;
+
+/**
+ * Distributed (MPI) simulation of a satellite network: the nodes are partitioned over the
+ * systems by orbital plane, and a UDP echo client at one ground station sends to a UDP echo
+ * server at another ground station, of which the echoes cross systems over ISLs and GSLs.
+ *
+ * It requires ns-3 to be configured with --enable-mpi, and can be run on a single machine:
+ *
+ * ./waf --run="satellite-network-distributed --run_dir='<path/to/run/directory>'" --command-template="mpirun -np 2 %s"
+ *
+ * Each system only installs applications on the nodes it simulates itself, and the system which
+ * simulates the client reports how many echoes came back.
+ */
+static void
+CountEcho(uint32_t* num_echoes, Ptr<const Packet> packet) {
+    (*num_echoes)++;
+}
+
+int main(int argc, char *argv[]) {
+
+    // The distributed simulator must be selected before anything is created or scheduled
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DistributedSimulatorImpl"));
+    MpiInterface::Enable(&argc, &argv);
+    uint32_t system_id = MpiInterface::GetSystemId();
+
+    // Arguments
+    CommandLine cmd;
+    std::string run_dir = "";
+    uint32_t from_gid = 0;
+    uint32_t to_gid = 1;
+    uint32_t num_packets = 100;
+    int64_t interval_ns = 10000000;
+    cmd.AddValue("run_dir", "Run directory", run_dir);
+    cmd.AddValue("from_gid", "Ground station of the echo client", from_gid);
+    cmd.AddValue("to_gid", "Ground station of the echo server", to_gid);
+    cmd.AddValue("num_packets", "Number of packets the client sends", num_packets);
+    cmd.AddValue("interval_ns", "Interval between the packets the client sends", interval_ns);
+    cmd.Parse(argc, argv);
+    if (run_dir.compare("") == 0) {
+        std::cout << "Usage: ./waf --run=\"satellite-network-distributed --run_dir='<path/to/run/directory>'\" --command-template=\"mpirun -np <systems> %s\"" << std::endl;
+        MpiInterface::Disable();
+        return 0;
+    }
+
+    // Topology (partitioned) with routing and GSL bandwidth
+    Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(run_dir);
+    Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+    ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+    GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+
+    // Echo server and client, each only on the system which simulates its node
+    NS_ABORT_MSG_IF(from_gid >= topology->GetNumGroundStations() || to_gid >= topology->GetNumGroundStations(), "Invalid ground station id");
+    Ptr<Node> from_node = topology->GetGroundStationNodes().Get(from_gid);
+    Ptr<Node> to_node = topology->GetGroundStationNodes().Get(to_gid);
+    uint32_t num_echoes = 0;
+    if (to_node->GetSystemId() == system_id) {
+        UdpEchoServerHelper server(9);
+        server.Install(to_node);
+    }
+    if (from_node->GetSystemId() == system_id) {
+        UdpEchoClientHelper client(to_node->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(), 9);
+        client.SetAttribute("MaxPackets", UintegerValue(num_packets));
+        client.SetAttribute("Interval", TimeValue(NanoSeconds(interval_ns)));
+        client.SetAttribute("PacketSize", UintegerValue(1024));
+        ApplicationContainer apps = client.Install(from_node);
+        apps.Get(0)->TraceConnectWithoutContext("Rx", MakeBoundCallback(&CountEcho, &num_echoes));
+    }
+    std::cout << "DISTRIBUTED" << std::endl;
+    std::cout << "  > System " << system_id << " of " << MpiInterface::GetSize() << std::endl;
+    std::cout << "  > Client on system " << from_node->GetSystemId() << ", server on system " << to_node->GetSystemId() << std::endl;
+    std::cout << std::endl;
+
+    // Run simulation
+    basicSimulation->Run();
+
+    // Echoes which came back
+    if (from_node->GetSystemId() == system_id) {
+        std::cout << "  > System " << system_id << ": received " << num_echoes << "/" << num_packets << " echoes" << std::endl;
+    }
+
+    // Finalize
+    basicSimulation->Finalize();
+    MpiInterface::Disable();
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-ephemeris.h"
+
+using namespace ns3;
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+}
+
+/**
+ * Measures how the precomputation of satellite ephemerides scales with the number of threads
+ * (the same way as TopologySatelliteNetwork::PrecomputeSatelliteEphemerides), and what it costs
+ * to propagate a copy of the SGP4 record for every position instead of the record itself.
+ */
+int main(int argc, char *argv[]) {
+
+    uint32_t num_satellites = 1000;
+    int64_t step_ns = 100000000;
+    int64_t duration_ns = 200000000000;
+    uint32_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t num_propagations = 1000000;
+    CommandLine cmd;
+    cmd.AddValue("num_satellites", "Number of satellites", num_satellites);
+    cmd.AddValue("step_ns", "Ephemeris step (ns)", step_ns);
+    cmd.AddValue("duration_ns", "Ephemeris duration (ns)", duration_ns);
+    cmd.AddValue("max_threads", "Maximum number of threads", max_threads);
+    cmd.AddValue("num_propagations", "Number of single propagations", num_propagations);
+    cmd.Parse(argc, argv);
+
+    // All satellites have the same orbit, the cost of propagating does not depend on it
+    std::vector<Ptr<Satellite>> satellites;
+    for (uint32_t i = 0; i < num_satellites; i++) {
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName("ISS (ZARYA)");
+        satellite->SetTleInfo(
+                "1 25544U 98067A   20274.52061263  .00002472  00000-0  53335-4 0  9998",
+                "2 25544  51.6445 187.2657 0001412 107.7286  78.8629 15.48811122248346"
+        );
+        satellites.push_back(satellite);
+    }
+
+    std::cout << "SATELLITE EPHEMERIS BENCHMARK" << std::endl;
+    std::cout << "  > Satellites............... " << num_satellites << std::endl;
+    std::cout << "  > Step..................... " << step_ns / 1e6 << " ms" << std::endl;
+    std::cout << "  > Duration................. " << duration_ns / 1e9 << " s" << std::endl;
+    std::cout << "  > Single propagations...... " << num_propagations << std::endl;
+
+    // Single propagations, on the record itself and on a copy of it made for each
+    const Satellite* sat = PeekPointer(satellites[0]);
+    std::vector<double> in_place_x(num_propagations);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_propagations; i++) {
+        in_place_x[i] = sat->GetPositionAtTsince(i * 0.001).x;
+    }
+    double in_place_s = elapsed_s(start);
+    std::vector<double> copied_x(num_propagations);
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_propagations; i++) {
+        elsetrec record = sat->GetSgp4Record();
+        copied_x[i] = sat->GetPositionAtTsince(i * 0.001, record).x;
+    }
+    double copied_s = elapsed_s(start);
+    NS_ABORT_MSG_IF(in_place_x != copied_x, "Propagation of a copied record differs");
+    std::cout << "  > Per propagation" << std::endl;
+    std::cout << "    >> Record itself........ " << in_place_s / num_propagations * 1e9 << " ns" << std::endl;
+    std::cout << "    >> Copy of the record... " << copied_s / num_propagations * 1e9 << " ns" << std::endl;
+
+    // Precomputation with 1, 2, 4, ... threads (and the maximum)
+    std::vector<uint32_t> thread_counts;
+    for (uint32_t num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+        thread_counts.push_back(num_threads);
+    }
+    thread_counts.push_back(max_threads);
+    std::cout << "  > Precomputation" << std::endl;
+    double single_thread_s = 0;
+    for (uint32_t num_threads : thread_counts) {
+        std::vector<Ptr<SatelliteEphemeris>> ephemerides(num_satellites);
+        std::atomic<size_t> next_satellite(0);
+        auto sample_satellites = [&]() {
+            size_t i;
+            while ((i = next_satellite.fetch_add(1)) < num_satellites) {
+                ephemerides[i] = Create<SatelliteEphemeris>(
+                        satellites[i], satellites[i]->GetTleEpoch(), NanoSeconds(step_ns), NanoSeconds(duration_ns),
+                        SatelliteEphemeris::STORAGE_FLOAT32
+                );
+            }
+        };
+        start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < num_threads; t++) {
+            threads.emplace_back(sample_satellites);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double precompute_s = elapsed_s(start);
+        if (num_threads == 1) {
+            single_thread_s = precompute_s;
+        }
+        std::cout << "    >> " << num_threads << " thread(s)........ " << precompute_s << " s (speed-up "
+                  << single_thread_s / precompute_s << "x)" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/node-interface-table.h"
+
+using namespace ns3;
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+}
+
+/**
+ * Lookups of one forwarding state update (for every node to every other node: the interface
+ * checks of the own interface and the gateway address of the next hop) and of one GSL
+ * bandwidth update (the GSL device of every node), through NodeContainer::Get() and
+ * GetObject() chains. The returned checksum prevents the lookups from being optimized away.
+ */
+uint64_t update_with_get_object(NodeContainer& nodes) {
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        for (uint32_t target = 0; target < nodes.GetN(); target++) {
+            uint32_t num_interfaces = nodes.Get(i)->GetObject<Ipv4>()->GetNInterfaces();
+            uint32_t if_id = 1 + target % (num_interfaces - 1);
+            bool is_gsl = nodes.Get(i)->GetObject<Ipv4>()->GetNetDevice(if_id)->GetObject<GSLNetDevice>() != 0;
+            bool is_isl = nodes.Get(i)->GetObject<Ipv4>()->GetNetDevice(if_id)->GetObject<PointToPointLaserNetDevice>() != 0;
+            uint32_t next_if_id = 1 + i % (nodes.Get(target)->GetObject<Ipv4>()->GetNInterfaces() - 1);
+            checksum += is_gsl + 2 * is_isl + nodes.Get(target)->GetObject<Ipv4>()->GetAddress(next_if_id, 0).GetLocal().Get();
+        }
+    }
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        uint32_t gsl_if_id = nodes.Get(i)->GetObject<Ipv4>()->GetNInterfaces() - 1;
+        checksum += nodes.Get(i)->GetObject<Ipv4>()->GetNetDevice(gsl_if_id)->GetObject<GSLNetDevice>()->GetIfIndex();
+    }
+    return checksum;
+}
+
+/**
+ * Same lookups through the node interface table.
+ */
+uint64_t update_with_table(const NodeInterfaceTable& table) {
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < table.GetNNodes(); i++) {
+        for (uint32_t target = 0; target < table.GetNNodes(); target++) {
+            uint32_t num_interfaces = table.GetNInterfaces(i);
+            uint32_t if_id = 1 + target % (num_interfaces - 1);
+            bool is_gsl = table.GetGslNetDevice(i, if_id) != nullptr;
+            bool is_isl = table.GetIslNetDevice(i, if_id) != nullptr;
+            uint32_t next_if_id = 1 + i % (table.GetNInterfaces(target) - 1);
+            checksum += is_gsl + 2 * is_isl + table.GetLocalAddress(target, next_if_id).Get();
+        }
+    }
+    for (uint32_t i = 0; i < table.GetNNodes(); i++) {
+        uint32_t gsl_if_id = table.GetNInterfaces(i) - 1;
+        checksum += table.GetGslNetDevice(i, gsl_if_id)->GetIfIndex();
+    }
+    return checksum;
+}
+
+/**
+ * Compares the per-update cost of looking up the IPv4 interfaces and network devices of the
+ * nodes through GetObject() chains against the node interface table, on a +grid
+ * constellation with ground stations (every node having one GSL interface).
+ */
+int main(int argc, char *argv[]) {
+
+    uint32_t num_planes = 72;
+    uint32_t sats_per_plane = 22;
+    uint32_t num_ground_stations = 100;
+    uint32_t num_updates = 3;
+    CommandLine cmd;
+    cmd.AddValue("num_planes", "Number of orbital planes", num_planes);
+    cmd.AddValue("sats_per_plane", "Number of satellites per orbital plane", sats_per_plane);
+    cmd.AddValue("num_ground_stations", "Number of ground stations", num_ground_stations);
+    cmd.AddValue("num_updates", "Number of updates timed", num_updates);
+    cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(num_planes < 3 || sats_per_plane < 3, "The +grid needs at least 3 planes of 3 satellites");
+
+    // Nodes (positions do not matter, nothing is sent)
+    NodeContainer satellites;
+    satellites.Create(num_planes * sats_per_plane);
+    NodeContainer ground_stations;
+    ground_stations.Create(num_ground_stations);
+    NodeContainer nodes;
+    nodes.Add(satellites);
+    nodes.Add(ground_stations);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4_helper("10.0.0.0", "255.255.255.0");
+
+    // +grid ISLs (to the next satellite in the plane, and to the same satellite in the next plane)
+    PointToPointLaserHelper p2p_laser_helper;
+    for (uint32_t p = 0; p < num_planes; p++) {
+        for (uint32_t s = 0; s < sats_per_plane; s++) {
+            uint32_t sat_id = p * sats_per_plane + s;
+            ipv4_helper.Assign(p2p_laser_helper.Install(satellites.Get(sat_id), satellites.Get(p * sats_per_plane + (s + 1) % sats_per_plane)));
+            ipv4_helper.NewNetwork();
+            ipv4_helper.Assign(p2p_laser_helper.Install(satellites.Get(sat_id), satellites.Get(((p + 1) % num_planes) * sats_per_plane + s)));
+            ipv4_helper.NewNetwork();
+        }
+    }
+
+    // One GSL interface on each node
+    GSLHelper gsl_helper;
+    std::vector<std::tuple<int32_t, double>> node_gsl_if_info(nodes.GetN(), std::make_tuple(1, 1.0));
+    NetDeviceContainer gsl_devices = gsl_helper.Install(satellites, ground_stations, node_gsl_if_info);
+    for (uint32_t i = 0; i < gsl_devices.GetN(); i++) {
+        ipv4_helper.Assign(gsl_devices.Get(i));
+        ipv4_helper.NewNetwork();
+    }
+
+    std::cout << "NODE INTERFACE TABLE BENCHMARK" << std::endl;
+    std::cout << "  > Satellites............... " << satellites.GetN() << std::endl;
+    std::cout << "  > Ground stations.......... " << ground_stations.GetN() << std::endl;
+    std::cout << "  > Updates.................. " << num_updates << std::endl;
+
+    // Building the table
+    auto start = std::chrono::steady_clock::now();
+    Ptr<NodeInterfaceTable> table = Create<NodeInterfaceTable>(nodes);
+    double build_s = elapsed_s(start);
+
+    // Updates
+    double get_object_s = 0;
+    double table_s = 0;
+    for (uint32_t u = 0; u < num_updates; u++) {
+        start = std::chrono::steady_clock::now();
+        uint64_t checksum_get_object = update_with_get_object(nodes);
+        get_object_s += elapsed_s(start);
+        start = std::chrono::steady_clock::now();
+        uint64_t checksum_table = update_with_table(*table);
+        table_s += elapsed_s(start);
+        NS_ABORT_MSG_IF(checksum_get_object != checksum_table, "Node interface table differs from the nodes");
+    }
+
+    std::cout << "  > Table build.............. " << build_s * 1e3 << " ms (once)" << std::endl;
+    std::cout << "  > Per update" << std::endl;
+    std::cout << "    >> GetObject() chains.... " << get_object_s / num_updates * 1e3 << " ms" << std::endl;
+    std::cout << "    >> Interface table....... " << table_s / num_updates * 1e3 << " ms" << std::endl;
+    std::cout << "  > Speed-up................. " << get_object_s / table_s << "x" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-network-partitioner.h"
+
+using namespace ns3;
+
+/**
+ * Reports how a satellite network would be partitioned over a number of systems, to choose
+ * the number of processes of a distributed run (see satellite-network-distributed) before
+ * starting it. For each number of systems, it shows the satellites and ground stations each
+ * system gets, and how many ISLs cross systems (each of which synchronizes two systems).
+ *
+ * ./waf --run="satellite-network-partitioning --satellite_network_dir='<path/to/satellite/network/dir>' --num_systems='2,4,8'"
+ */
+int main(int argc, char *argv[]) {
+
+    // Arguments
+    CommandLine cmd;
+    std::string satellite_network_dir = "";
+    std::string num_systems_str = "2,4,8,16";
+    cmd.AddValue("satellite_network_dir", "Directory with tles.txt, isls.txt and ground_stations.txt", satellite_network_dir);
+    cmd.AddValue("num_systems", "Comma-separated numbers of systems to evaluate", num_systems_str);
+    cmd.Parse(argc, argv);
+    if (satellite_network_dir.compare("") == 0) {
+        std::cout << "Usage: ./waf --run=\"satellite-network-partitioning --satellite_network_dir='<path/to/satellite/network/dir>' [--num_systems='2,4,8']\"" << std::endl;
+        return 0;
+    }
+
+    // Satellites (first line is the number of orbits and satellites per orbit)
+    std::vector<Ptr<Satellite>> satellites;
+    std::ifstream tles_file(satellite_network_dir + "/tles.txt");
+    NS_ABORT_MSG_UNLESS(tles_file.is_open(), "File tles.txt could not be opened");
+    std::string line, tle1, tle2;
+    std::getline(tles_file, line);
+    while (std::getline(tles_file, line)) {
+        std::getline(tles_file, tle1);
+        std::getline(tles_file, tle2);
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName(line);
+        satellite->SetTleInfo(tle1, tle2);
+        satellites.push_back(satellite);
+    }
+
+    // ISLs
+    std::vector<std::pair<int32_t, int32_t>> isls;
+    std::ifstream isls_file(satellite_network_dir + "/isls.txt");
+    NS_ABORT_MSG_UNLESS(isls_file.is_open(), "File isls.txt could not be opened");
+    while (std::getline(isls_file, line)) {
+        std::vector<std::string> res = split_string(line, " ", 2);
+        isls.push_back(std::make_pair(parse_positive_int64(res.at(0)), parse_positive_int64(res.at(1))));
+    }
+
+    // Ground station positions
+    std::vector<Vector> ground_station_positions;
+    std::ifstream ground_stations_file(satellite_network_dir + "/ground_stations.txt");
+    NS_ABORT_MSG_UNLESS(ground_stations_file.is_open(), "File ground_stations.txt could not be opened");
+    while (std::getline(ground_stations_file, line)) {
+        std::vector<std::string> res = split_string(line, ",", 8);
+        ground_station_positions.push_back(Vector(parse_double(res[5]), parse_double(res[6]), parse_double(res[7])));
+    }
+
+    // Number of orbital planes
+    uint32_t num_planes = 0;
+    for (uint32_t plane : SatelliteNetworkPartitioner::DetermineOrbitalPlanes(satellites)) {
+        num_planes = std::max(num_planes, plane + 1);
+    }
+
+    std::cout << "PARTITIONING" << std::endl;
+    std::cout << "  > Satellites.................. " << satellites.size() << std::endl;
+    std::cout << "  > Orbital planes.............. " << num_planes << std::endl;
+    std::cout << "  > ISLs........................ " << isls.size() << std::endl;
+    std::cout << "  > Ground stations............. " << ground_station_positions.size() << std::endl;
+    for (const std::string& num_systems_entry : split_string(num_systems_str, ",")) {
+        uint32_t num_systems = parse_positive_int64(num_systems_entry);
+        SatelliteNetworkPartitioner partitioner(num_systems);
+        std::vector<uint32_t> satellite_system_ids = partitioner.AssignSatellites(satellites);
+        std::vector<uint32_t> ground_station_system_ids = partitioner.AssignGroundStations(ground_station_positions);
+        std::cout << "  > " << num_systems << " systems" << std::endl;
+        SatelliteNetworkPartitioner::PrintStatistics(
+                SatelliteNetworkPartitioner::Evaluate(num_systems, satellite_system_ids, ground_station_system_ids, isls),
+                "    >> "
+        );
+    }
+
+    return 0;
+}
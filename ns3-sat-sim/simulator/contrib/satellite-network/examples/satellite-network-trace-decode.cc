@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/packet-event-tracer.h"
+
+using namespace ns3;
+
+/**
+ * Converts a binary packet event trace (logs_ns3/packet_events.bin, written if
+ * enable_packet_event_tracing=true) into CSV, with a line per event:
+ *
+ * <time (ns)>,<node id>,<interface id>,<packet uid>,<size (byte)>,<event type>
+ *
+ * ./waf --run="satellite-network-trace-decode --input='<path/to/packet_events.bin>' --output='<path/to/packet_events.csv>'"
+ */
+int main(int argc, char *argv[]) {
+
+    // Arguments
+    CommandLine cmd;
+    std::string input = "";
+    std::string output = "";
+    cmd.AddValue("input", "Binary packet event trace", input);
+    cmd.AddValue("output", "CSV file to write (default: input with .csv instead of .bin)", output);
+    cmd.Parse(argc, argv);
+    if (input.compare("") == 0) {
+        std::cout << "Usage: ./waf --run=\"satellite-network-trace-decode --input='<path/to/packet_events.bin>' [--output='<path/to/packet_events.csv>']\"" << std::endl;
+        return 0;
+    }
+    if (output.compare("") == 0) {
+        size_t extension = input.rfind(".bin");
+        output = (extension == std::string::npos ? input : input.substr(0, extension)) + ".csv";
+    }
+
+    // Decode
+    uint64_t num_records = PacketEventTracer::DecodeToCsv(input, output);
+    std::cout << "Decoded " << num_records << " packet events into " << output << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-visibility-index.h"
+
+using namespace ns3;
+
+static const double EARTH_RADIUS_M = 6371000.0;
+static const double EARTH_MU_M3_PER_S2 = 3.986004418e14;
+
+/**
+ * Positions of a Walker delta constellation of circular orbits (in an Earth-centered frame
+ * which does not rotate, which does not matter for the cost of the queries).
+ */
+std::vector<Vector> walker_delta_positions(uint32_t num_planes, uint32_t sats_per_plane, double altitude_m, double inclination_deg, double t_s) {
+    double radius_m = EARTH_RADIUS_M + altitude_m;
+    double mean_motion_rad_per_s = std::sqrt(EARTH_MU_M3_PER_S2 / (radius_m * radius_m * radius_m));
+    double inclination = inclination_deg * M_PI / 180.0;
+    std::vector<Vector> positions;
+    for (uint32_t p = 0; p < num_planes; p++) {
+        double raan = 2.0 * M_PI * p / num_planes;
+        for (uint32_t s = 0; s < sats_per_plane; s++) {
+            double u = 2.0 * M_PI * s / sats_per_plane + 2.0 * M_PI * p / (num_planes * sats_per_plane) + mean_motion_rad_per_s * t_s;
+            double x = std::cos(u);
+            double y = std::sin(u) * std::cos(inclination);
+            double z = std::sin(u) * std::sin(inclination);
+            positions.push_back(Vector(
+                    radius_m * (x * std::cos(raan) - y * std::sin(raan)),
+                    radius_m * (x * std::sin(raan) + y * std::cos(raan)),
+                    radius_m * z
+            ));
+        }
+    }
+    return positions;
+}
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+}
+
+/**
+ * Compares finding the visible satellites of every ground station with the visibility index
+ * (rebuilt every time step) against checking the elevation of every satellite. Both must
+ * give exactly the same satellites.
+ */
+int main(int argc, char *argv[]) {
+
+    uint32_t num_planes = 72;
+    uint32_t sats_per_plane = 56;
+    uint32_t num_ground_stations = 100;
+    uint32_t num_time_steps = 100;
+    double min_elevation_deg = 25.0;
+    double cell_size_deg = 5.0;
+    CommandLine cmd;
+    cmd.AddValue("num_planes", "Number of orbital planes", num_planes);
+    cmd.AddValue("sats_per_plane", "Number of satellites per orbital plane", sats_per_plane);
+    cmd.AddValue("num_ground_stations", "Number of ground stations", num_ground_stations);
+    cmd.AddValue("num_time_steps", "Number of time steps (1 s apart)", num_time_steps);
+    cmd.AddValue("min_elevation_deg", "Minimum elevation (degrees)", min_elevation_deg);
+    cmd.AddValue("cell_size_deg", "Cell size of the index (degrees)", cell_size_deg);
+    cmd.Parse(argc, argv);
+
+    // Ground stations spread uniformly over the sphere between -60 and 60 degrees latitude
+    std::mt19937 rng(123456789);
+    std::uniform_real_distribution<double> uniform_sin_lat(std::sin(-M_PI / 3.0), std::sin(M_PI / 3.0));
+    std::uniform_real_distribution<double> uniform_lon(-M_PI, M_PI);
+    std::vector<Vector> ground_stations;
+    for (uint32_t i = 0; i < num_ground_stations; i++) {
+        double lat = std::asin(uniform_sin_lat(rng));
+        double lon = uniform_lon(rng);
+        ground_stations.push_back(Vector(
+                EARTH_RADIUS_M * std::cos(lat) * std::cos(lon),
+                EARTH_RADIUS_M * std::cos(lat) * std::sin(lon),
+                EARTH_RADIUS_M * std::sin(lat)
+        ));
+    }
+
+    std::cout << "VISIBILITY INDEX BENCHMARK" << std::endl;
+    std::cout << "  > Satellites............... " << num_planes * sats_per_plane << std::endl;
+    std::cout << "  > Ground stations.......... " << num_ground_stations << std::endl;
+    std::cout << "  > Time steps............... " << num_time_steps << std::endl;
+    std::cout << "  > Minimum elevation........ " << min_elevation_deg << " deg" << std::endl;
+    std::cout << "  > Cell size................ " << cell_size_deg << " deg" << std::endl;
+
+    SatelliteVisibilityIndex index(cell_size_deg);
+    double build_s = 0;
+    double index_query_s = 0;
+    double brute_force_query_s = 0;
+    uint64_t num_visible = 0;
+    for (uint32_t step = 0; step < num_time_steps; step++) {
+        std::vector<Vector> positions = walker_delta_positions(num_planes, sats_per_plane, 550000.0, 53.0, step);
+
+        auto start = std::chrono::steady_clock::now();
+        index.Build(positions);
+        build_s += elapsed_s(start);
+
+        start = std::chrono::steady_clock::now();
+        std::vector<std::vector<uint32_t>> visible_index;
+        for (const Vector& gs : ground_stations) {
+            visible_index.push_back(index.GetVisibleSatellites(gs, min_elevation_deg));
+        }
+        index_query_s += elapsed_s(start);
+
+        start = std::chrono::steady_clock::now();
+        std::vector<std::vector<uint32_t>> visible_brute_force;
+        for (const Vector& gs : ground_stations) {
+            visible_brute_force.push_back(index.GetVisibleSatellitesBruteForce(gs, min_elevation_deg));
+        }
+        brute_force_query_s += elapsed_s(start);
+
+        NS_ABORT_MSG_IF(visible_index != visible_brute_force, "Visibility index differs from brute force at step " << step);
+        for (const std::vector<uint32_t>& visible : visible_index) {
+            num_visible += visible.size();
+        }
+    }
+
+    std::cout << "  > Visible per ground station " << (double) num_visible / (num_time_steps * num_ground_stations) << " (on average)" << std::endl;
+    std::cout << "  > Per time step" << std::endl;
+    std::cout << "    >> Index build.......... " << build_s / num_time_steps * 1e6 << " us" << std::endl;
+    std::cout << "    >> Index queries........ " << index_query_s / num_time_steps * 1e6 << " us" << std::endl;
+    std::cout << "    >> Brute force queries.. " << brute_force_query_s / num_time_steps * 1e6 << " us" << std::endl;
+    std::cout << "  > Speed-up (incl. build)... " << brute_force_query_s / (build_s + index_query_s) << "x" << std::endl;
+
+    return 0;
+}
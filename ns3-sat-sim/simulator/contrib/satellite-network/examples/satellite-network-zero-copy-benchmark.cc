@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/point-to-point-laser-helper.h"
+
+using namespace ns3;
+
+// Every allocation of the process is counted (the simulation is single-threaded)
+static uint64_t g_num_allocations = 0;
+static uint64_t g_num_allocated_bytes = 0;
+
+void* operator new(std::size_t size) {
+    g_num_allocations++;
+    g_num_allocated_bytes += size;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+struct BenchmarkResult {
+    uint64_t num_allocations;
+    uint64_t num_allocated_bytes;
+    uint64_t rx_bytes;
+    double wall_time_s;
+};
+
+/**
+ * Runs a single TCP bulk flow over a chain of num_hops inter-satellite links, and counts the
+ * allocations during the simulation run (so not those of setting up the chain).
+ */
+BenchmarkResult run_chain(uint32_t num_hops, double duration_s, bool zero_copy) {
+    Ipv4AddressGenerator::Reset();
+
+    // Satellites 1000 km apart
+    NodeContainer nodes;
+    nodes.Create(num_hops + 1);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        nodes.Get(i)->GetObject<MobilityModel>()->SetPosition(Vector(i * 1000000.0, 0.0, 7000000.0));
+    }
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    // Chain of ISLs, each its own subnet
+    PointToPointLaserHelper p2p_laser_helper;
+    p2p_laser_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("100p")));
+    p2p_laser_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Mbps")));
+    p2p_laser_helper.SetChannelAttribute("ZeroCopy", BooleanValue(zero_copy));
+    Ipv4AddressHelper ipv4_helper("10.0.0.0", "255.255.255.0");
+    std::vector<Ipv4InterfaceContainer> links;
+    for (uint32_t i = 0; i < num_hops; i++) {
+        links.push_back(ipv4_helper.Assign(p2p_laser_helper.Install(nodes.Get(i), nodes.Get(i + 1))));
+        ipv4_helper.NewNetwork();
+    }
+
+    // Static routes to both ends of the chain
+    Ipv4Address first_address = links[0].GetAddress(0);
+    Ipv4Address last_address = links[num_hops - 1].GetAddress(1);
+    Ipv4StaticRoutingHelper static_routing_helper;
+    for (uint32_t i = 0; i <= num_hops; i++) {
+        Ptr<Ipv4StaticRouting> routing = static_routing_helper.GetStaticRouting(nodes.Get(i)->GetObject<Ipv4>());
+        if (i < num_hops) {
+            routing->AddHostRouteTo(last_address, links[i].GetAddress(1), links[i].Get(0).second);
+        }
+        if (i > 0) {
+            routing->AddHostRouteTo(first_address, links[i - 1].GetAddress(0), links[i - 1].Get(1).second);
+        }
+    }
+
+    // TCP flow from the first to the last satellite
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1380));
+    BulkSendHelper source("ns3::TcpSocketFactory", InetSocketAddress(last_address, 1024));
+    source.Install(nodes.Get(0)).Start(Seconds(0.0));
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), 1024));
+    ApplicationContainer sink_app = sink.Install(nodes.Get(num_hops));
+    sink_app.Start(Seconds(0.0));
+
+    // Run
+    Simulator::Stop(Seconds(duration_s));
+    BenchmarkResult result;
+    uint64_t num_allocations_before = g_num_allocations;
+    uint64_t num_allocated_bytes_before = g_num_allocated_bytes;
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto end = std::chrono::steady_clock::now();
+    result.num_allocations = g_num_allocations - num_allocations_before;
+    result.num_allocated_bytes = g_num_allocated_bytes - num_allocated_bytes_before;
+    result.wall_time_s = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    result.rx_bytes = sink_app.Get(0)->GetObject<PacketSink>()->GetTotalRx();
+
+    Simulator::Destroy();
+    return result;
+}
+
+void print_result(const std::string& name, const BenchmarkResult& result) {
+    std::cout << "  > " << name << std::endl;
+    std::cout << "    >> Received............. " << result.rx_bytes << " byte" << std::endl;
+    std::cout << "    >> Allocations.......... " << result.num_allocations << " (" << result.num_allocated_bytes << " byte)" << std::endl;
+    std::cout << "    >> Wall time............ " << result.wall_time_s << " s" << std::endl;
+}
+
+/**
+ * Compares the number of allocations and the wall time of a multi-hop TCP flow with and
+ * without the ZeroCopy channel attribute. As the simulated behavior is the same, both
+ * receive exactly the same number of bytes.
+ */
+int main(int argc, char *argv[]) {
+
+    uint32_t num_hops = 15;
+    double duration_s = 5.0;
+    CommandLine cmd;
+    cmd.AddValue("num_hops", "Number of inter-satellite links of the chain", num_hops);
+    cmd.AddValue("duration_s", "Simulated duration of the TCP flow (s)", duration_s);
+    cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(num_hops == 0, "There must be at least one hop");
+
+    std::cout << "ZERO-COPY BENCHMARK" << std::endl;
+    std::cout << "  > Hops..................... " << num_hops << std::endl;
+    std::cout << "  > Duration................. " << duration_s << " s" << std::endl;
+    BenchmarkResult copy = run_chain(num_hops, duration_s, false);
+    BenchmarkResult zero_copy = run_chain(num_hops, duration_s, true);
+    print_result("Copy per hop", copy);
+    print_result("Zero-copy", zero_copy);
+    NS_ABORT_MSG_IF(copy.rx_bytes != zero_copy.rx_bytes, "Zero-copy changed the simulated behavior");
+    std::cout << "  > Allocations saved........ " << (int64_t) (copy.num_allocations - zero_copy.num_allocations)
+              << " (" << 100.0 * (1.0 - (double) zero_copy.num_allocations / (double) copy.num_allocations) << "%)" << std::endl;
+
+    return 0;
+}
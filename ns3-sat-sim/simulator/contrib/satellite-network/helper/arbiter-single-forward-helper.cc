@@ -18,13 +18,16 @@
  */
 
 #include "arbiter-single-forward-helper.h"
+#include "ns3/hot-path-profiler.h"
 
 namespace ns3 {
 
-ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes) {
+ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, Ptr<NodeInterfaceTable> nodeInterfaceTable) {
     std::cout << "SETUP SINGLE FORWARDING ROUTING" << std::endl;
     m_basicSimulation = basicSimulation;
     m_nodes = nodes;
+    m_nodeInterfaceTable = nodeInterfaceTable != 0 ? nodeInterfaceTable : Create<NodeInterfaceTable>(nodes);
+    NS_ABORT_MSG_IF(m_nodeInterfaceTable->GetNNodes() != m_nodes.GetN(), "Interface table does not match the nodes");
 
     // Read in initial forwarding state
     std::cout << "  > Create initial single forwarding state" << std::endl;
@@ -35,8 +38,9 @@ ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> bas
     std::cout << "  > Setting the routing arbiter on each node" << std::endl;
     for (size_t i = 0; i < m_nodes.GetN(); i++) {
         Ptr<ArbiterSingleForward> arbiter = CreateObject<ArbiterSingleForward>(m_nodes.Get(i), m_nodes, initial_forwarding_state[i]);
+        arbiter->SetNodeInterfaceTable(m_nodeInterfaceTable);
         m_arbiters.push_back(arbiter);
-        m_nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetArbiter(arbiter);
+        m_nodeInterfaceTable->GetIpv4(i)->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetArbiter(arbiter);
     }
     basicSimulation->RegisterTimestamp("Setup routing arbiter on each node");
 
@@ -64,6 +68,7 @@ ArbiterSingleForwardHelper::InitialEmptyForwardingState() {
 }
 
 void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
+    SATNET_PROFILE_SCOPE(FORWARDING_STATE_UPDATE);
 
     // Filename
     std::ostringstream res;
@@ -109,33 +114,34 @@ void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
             );
 
             // Check the interfaces exist
-            NS_ABORT_MSG_UNLESS(my_if_id == -1 || (my_if_id >= 0 && my_if_id + 1 < m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNInterfaces()), "Invalid current interface");
-            NS_ABORT_MSG_UNLESS(next_if_id == -1 || (next_if_id >= 0 && next_if_id + 1 < m_nodes.Get(next_hop_node_id)->GetObject<Ipv4>()->GetNInterfaces()), "Invalid next hop interface");
+            NS_ABORT_MSG_UNLESS(my_if_id == -1 || (my_if_id >= 0 && my_if_id + 1 < m_nodeInterfaceTable->GetNInterfaces(current_node_id)), "Invalid current interface");
+            NS_ABORT_MSG_UNLESS(next_if_id == -1 || (next_if_id >= 0 && next_if_id + 1 < m_nodeInterfaceTable->GetNInterfaces(next_hop_node_id)), "Invalid next hop interface");
 
             // Node id and interface id checks are only necessary for non-drops
             if (next_hop_node_id != -1 && my_if_id != -1 && next_if_id != -1) {
 
                 // It must be either GSL or ISL
-                bool source_is_gsl = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<GSLNetDevice>() != 0;
-                bool source_is_isl = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<PointToPointLaserNetDevice>() != 0;
+                PointToPointLaserNetDevice* source_isl = m_nodeInterfaceTable->GetIslNetDevice(current_node_id, 1 + my_if_id);
+                bool source_is_gsl = m_nodeInterfaceTable->GetGslNetDevice(current_node_id, 1 + my_if_id) != nullptr;
+                bool source_is_isl = source_isl != nullptr;
                 NS_ABORT_MSG_IF((!source_is_gsl) && (!source_is_isl), "Only GSL and ISL network devices are supported");
 
                 // If current is a GSL interface, the destination must also be a GSL interface
                 NS_ABORT_MSG_IF(
                     source_is_gsl &&
-                    m_nodes.Get(next_hop_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + next_if_id)->GetObject<GSLNetDevice>() == 0,
+                    m_nodeInterfaceTable->GetGslNetDevice(next_hop_node_id, 1 + next_if_id) == nullptr,
                     "Destination interface must be attached to a GSL network device"
                 );
 
                 // If current is a p2p laser interface, the destination must match exactly its counter-part
                 NS_ABORT_MSG_IF(
                     source_is_isl &&
-                    m_nodes.Get(next_hop_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + next_if_id)->GetObject<PointToPointLaserNetDevice>() == 0,
+                    m_nodeInterfaceTable->GetIslNetDevice(next_hop_node_id, 1 + next_if_id) == nullptr,
                     "Destination interface must be an ISL network device"
                 );
                 if (source_is_isl) {
-                    Ptr<NetDevice> device0 = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<PointToPointLaserNetDevice>()->GetChannel()->GetDevice(0);
-                    Ptr<NetDevice> device1 = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<PointToPointLaserNetDevice>()->GetChannel()->GetDevice(1);
+                    Ptr<NetDevice> device0 = source_isl->GetChannel()->GetDevice(0);
+                    Ptr<NetDevice> device1 = source_isl->GetChannel()->GetDevice(1);
                     Ptr<NetDevice> other_device = device0->GetNode()->GetId() == current_node_id ? device1 : device0;
                     NS_ABORT_MSG_IF(other_device->GetNode()->GetId() != next_hop_node_id, "Next hop node id across does not match");
                     NS_ABORT_MSG_IF(other_device->GetIfIndex() != 1 + next_if_id, "Next hop interface id across does not match");
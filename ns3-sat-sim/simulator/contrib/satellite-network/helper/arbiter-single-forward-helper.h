@@ -25,6 +25,7 @@
 #include "ns3/topology-satellite-network.h"
 #include "ns3/ipv4-arbiter-routing.h"
 #include "ns3/arbiter-single-forward.h"
+#include "ns3/node-interface-table.h"
 #include "ns3/abort.h"
 
 namespace ns3 {
@@ -32,7 +33,8 @@ namespace ns3 {
     class ArbiterSingleForwardHelper
     {
     public:
-        ArbiterSingleForwardHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes);
+        // The interface table of the nodes is built if none is given (e.g., TopologySatelliteNetwork::GetNodeInterfaceTable())
+        ArbiterSingleForwardHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, Ptr<NodeInterfaceTable> nodeInterfaceTable = 0);
     private:
         std::vector<std::vector<std::tuple<int32_t, int32_t, int32_t>>> InitialEmptyForwardingState();
         void UpdateForwardingState(int64_t t);
@@ -40,6 +42,7 @@ namespace ns3 {
         // Parameters
         Ptr<BasicSimulation> m_basicSimulation;
         NodeContainer m_nodes;
+        Ptr<NodeInterfaceTable> m_nodeInterfaceTable;
         int64_t m_dynamicStateUpdateIntervalNs;
         std::vector<Ptr<ArbiterSingleForward>> m_arbiters;
 
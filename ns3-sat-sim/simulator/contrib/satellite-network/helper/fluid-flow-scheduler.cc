@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+
+#include "fluid-flow-scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+    FluidFlowScheduler::FluidFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<TopologySatelliteNetwork> topology) {
+        m_basicSimulation = basicSimulation;
+        m_topology = topology;
+        m_nodeInterfaceTable = topology->GetNodeInterfaceTable();
+        m_last_progress_ns = 0;
+        m_reallocation_pending = false;
+
+        printf("FLUID FLOW SCHEDULER\n");
+
+        m_enabled = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_fluid_flow_scheduler", "false"));
+        if (!m_enabled) {
+            printf("  > Not enabled explicitly, so disabled\n\n");
+            return;
+        }
+        printf("  > Fluid flow scheduler is enabled\n");
+
+        // Either instead of the TCP flow scheduler, or as background load of the packet-level traffic
+        m_background = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("fluid_flow_background", "false"));
+        if (m_background) {
+            m_background_max_utilization = parse_double(m_basicSimulation->GetConfigParamOrDefault("fluid_flow_background_max_utilization", "0.9"));
+            NS_ABORT_MSG_IF(
+                    m_background_max_utilization <= 0 || m_background_max_utilization >= 1,
+                    "Maximum background utilization must be in (0, 1)"
+            );
+            m_background_packet_size_byte = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("fluid_flow_background_packet_size_byte", "1500"));
+            printf("  > Background load of the packet-level traffic (at most %.2f of each link)\n", m_background_max_utilization);
+        } else {
+            m_background_max_utilization = 1.0;
+            m_background_packet_size_byte = 0;
+            NS_ABORT_MSG_IF(
+                    parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_tcp_flow_scheduler", "false")),
+                    "The fluid flow scheduler replaces the TCP flow scheduler, they cannot both be enabled (unless fluid_flow_background is)"
+            );
+
+            // Packets would mark the links busy or idle in the same utilization trackers in
+            // which the fluid flows set their utilization
+            NS_ABORT_MSG_IF(
+                    parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_udp_burst_scheduler", "false"))
+                    || parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_pingmesh_scheduler", "false")),
+                    "Packet-level traffic (UDP bursts or pings) can only be combined with fluid flows if fluid_flow_background is enabled"
+            );
+        }
+        m_simulation_end_time_ns = m_basicSimulation->GetSimulationEndTimeNs();
+        m_dynamicStateUpdateIntervalNs = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("dynamic_state_update_interval_ns"));
+        m_enable_isl_utilization_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrFail("enable_isl_utilization_tracking"));
+        m_enable_gsl_utilization_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_gsl_utilization_tracking", "false"));
+
+        // Routing arbiters which give the path of the flows
+        for (uint32_t i = 0; i < m_nodeInterfaceTable->GetNNodes(); i++) {
+            Ptr<ArbiterSatnet> arbiter = m_nodeInterfaceTable->GetIpv4(i)->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()->GetObject<ArbiterSatnet>();
+            NS_ABORT_MSG_IF(arbiter == nullptr, "Node " << i << " does not have a satellite network routing arbiter");
+            m_arbiters.push_back(arbiter);
+        }
+
+        // Flow schedule
+        std::vector<TcpFlowScheduleEntry> schedule = read_tcp_flow_schedule(
+                m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("fluid_flow_schedule_filename"),
+                m_topology,
+                m_simulation_end_time_ns
+        );
+        printf("  > Read schedule (total flow start events: %lu)\n", schedule.size());
+        m_basicSimulation->RegisterTimestamp("Read fluid flow schedule");
+
+        // Link capacities at the start
+        m_link_capacity_bps.assign(m_nodeInterfaceTable->GetNEntries(), 0.0);
+        m_link_utilization.assign(m_nodeInterfaceTable->GetNEntries(), 0.0);
+        UpdateLinkCapacities();
+
+        // Schedule the flow starts, and the updates of the paths and capacities
+        for (const TcpFlowScheduleEntry& entry : schedule) {
+            NS_ABORT_MSG_IF(entry.GetFromNodeId() == entry.GetToNodeId(), "Fluid flow " << entry.GetTcpFlowId() << " has the same source and destination");
+            m_flows.push_back({entry, false, false, -1, 0.0, 0.0, false, std::vector<uint32_t>()});
+            Simulator::Schedule(NanoSeconds(entry.GetStartTimeNs()), &FluidFlowScheduler::StartFlow, this, m_flows.size() - 1);
+        }
+        if (!parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_force_static", "false"))
+            && m_dynamicStateUpdateIntervalNs < m_simulation_end_time_ns) {
+            Simulator::Schedule(NanoSeconds(m_dynamicStateUpdateIntervalNs), &FluidFlowScheduler::Update, this, m_dynamicStateUpdateIntervalNs);
+        }
+        m_basicSimulation->RegisterTimestamp("Schedule fluid flows");
+
+        std::cout << std::endl;
+    }
+
+    std::vector<double> FluidFlowScheduler::CalculateMaxMinFairRates(
+            const std::vector<std::vector<uint32_t>>& flow_links, const std::vector<double>& link_capacities
+    ) {
+
+        // Flows crossing each link, and the links in use
+        std::vector<uint32_t> num_unfrozen(link_capacities.size(), 0);
+        std::vector<uint32_t> used_links;
+        for (const std::vector<uint32_t>& links : flow_links) {
+            NS_ABORT_MSG_IF(links.empty(), "A flow must cross at least one link");
+            for (uint32_t link : links) {
+                if (num_unfrozen.at(link) == 0) {
+                    used_links.push_back(link);
+                }
+                num_unfrozen[link]++;
+            }
+        }
+        std::vector<uint32_t> link_flows_start(link_capacities.size() + 1, 0);
+        for (uint32_t link : used_links) {
+            link_flows_start[link + 1] = num_unfrozen[link];
+        }
+        for (size_t i = 0; i < link_capacities.size(); i++) {
+            link_flows_start[i + 1] += link_flows_start[i];
+        }
+        std::vector<uint32_t> link_flows(link_flows_start.back());
+        std::vector<uint32_t> link_flows_fill(link_flows_start.begin(), link_flows_start.end() - 1);
+        for (uint32_t f = 0; f < flow_links.size(); f++) {
+            for (uint32_t link : flow_links[f]) {
+                link_flows[link_flows_fill[link]++] = f;
+            }
+        }
+
+        // Progressive filling: the link with the smallest fair share is the bottleneck of all its
+        // flows which are not yet limited elsewhere, they get that share and the link is full
+        std::vector<double> remaining_capacity(link_capacities);
+        std::vector<double> rates(flow_links.size(), -1.0);
+        while (!used_links.empty()) {
+            size_t bottleneck_idx = 0;
+            double bottleneck_share = std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < used_links.size(); i++) {
+                double share = remaining_capacity[used_links[i]] / num_unfrozen[used_links[i]];
+                if (share < bottleneck_share) {
+                    bottleneck_share = share;
+                    bottleneck_idx = i;
+                }
+            }
+            bottleneck_share = std::max(0.0, bottleneck_share);
+            uint32_t bottleneck = used_links[bottleneck_idx];
+            for (uint32_t j = link_flows_start[bottleneck]; j < link_flows_start[bottleneck + 1]; j++) {
+                uint32_t f = link_flows[j];
+                if (rates[f] < 0) {
+                    rates[f] = bottleneck_share;
+                    for (uint32_t link : flow_links[f]) {
+                        remaining_capacity[link] -= bottleneck_share;
+                        num_unfrozen[link]--;
+                    }
+                }
+            }
+
+            // Links without flows left to limit are done
+            size_t num_left = 0;
+            for (uint32_t link : used_links) {
+                if (num_unfrozen[link] > 0) {
+                    used_links[num_left++] = link;
+                }
+            }
+            used_links.resize(num_left);
+        }
+        return rates;
+    }
+
+    void FluidFlowScheduler::UpdateLinkCapacities() {
+        for (uint32_t node_id = 0; node_id < m_nodeInterfaceTable->GetNNodes(); node_id++) {
+            for (uint32_t if_id = 0; if_id < m_nodeInterfaceTable->GetNInterfaces(node_id); if_id++) {
+                NetDevice* device = nullptr;
+                if (m_nodeInterfaceTable->GetGslNetDevice(node_id, if_id) != nullptr) {
+                    device = m_nodeInterfaceTable->GetGslNetDevice(node_id, if_id);
+                } else if (m_nodeInterfaceTable->GetIslNetDevice(node_id, if_id) != nullptr) {
+                    device = m_nodeInterfaceTable->GetIslNetDevice(node_id, if_id);
+                }
+                if (device != nullptr) {
+                    DataRateValue data_rate;
+                    device->GetAttribute("DataRate", data_rate);
+                    size_t link = m_nodeInterfaceTable->GetEntry(node_id, if_id);
+                    if (m_link_capacity_bps[link] != data_rate.Get().GetBitRate()) {
+                        m_link_capacity_bps[link] = data_rate.Get().GetBitRate();
+                        m_link_utilization[link] = -1.0;
+                    }
+                }
+            }
+        }
+    }
+
+    void FluidFlowScheduler::UpdatePath(Flow& flow) {
+        int32_t source_node_id = flow.entry.GetFromNodeId();
+        int32_t target_node_id = flow.entry.GetToNodeId();
+        flow.links.clear();
+        flow.has_path = false;
+
+        // Follow the forwarding state from the source, the packet is not needed to decide
+        int32_t current_node_id = source_node_id;
+        while (current_node_id != target_node_id) {
+            std::tuple<int32_t, int32_t, int32_t> next_hop = m_arbiters[current_node_id]->TopologySatelliteNetworkDecide(
+                    source_node_id, target_node_id, Ptr<const Packet>(), Ipv4Header(), false
+            );
+            if (std::get<0>(next_hop) < 0) {
+                flow.links.clear();
+                return;
+            }
+            flow.links.push_back(m_nodeInterfaceTable->GetEntry(current_node_id, std::get<1>(next_hop)));
+            current_node_id = std::get<0>(next_hop);
+            NS_ABORT_MSG_IF(
+                    flow.links.size() > m_nodeInterfaceTable->GetNNodes(),
+                    "Routing loop for fluid flow " << flow.entry.GetTcpFlowId() << " from " << source_node_id << " to " << target_node_id
+            );
+        }
+        flow.has_path = true;
+    }
+
+    void FluidFlowScheduler::Progress() {
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        double elapsed_s = (now_ns - m_last_progress_ns) / 1e9;
+        if (elapsed_s > 0) {
+            for (uint32_t flow_idx : m_active_flow_idxs) {
+                Flow& flow = m_flows[flow_idx];
+                flow.remaining_byte = std::max(0.0, flow.remaining_byte - flow.rate_bps * elapsed_s / 8.0);
+            }
+        }
+        m_last_progress_ns = now_ns;
+    }
+
+    void FluidFlowScheduler::StartFlow(uint32_t flow_idx) {
+        Progress();
+        Flow& flow = m_flows[flow_idx];
+        flow.started = true;
+        flow.remaining_byte = flow.entry.GetSizeByte();
+        if (flow.remaining_byte == 0) {
+            flow.finished = true;
+            flow.end_time_ns = Simulator::Now().GetNanoSeconds();
+            return;
+        }
+        UpdatePath(flow);
+        m_active_flow_idxs.push_back(flow_idx);
+        RequestReallocation();
+    }
+
+    void FluidFlowScheduler::Update(int64_t t) {
+        Progress();
+        UpdateLinkCapacities();
+        for (uint32_t flow_idx : m_active_flow_idxs) {
+            UpdatePath(m_flows[flow_idx]);
+        }
+        RequestReallocation();
+
+        // Plan the next update
+        int64_t next_update_ns = t + m_dynamicStateUpdateIntervalNs;
+        if (next_update_ns < m_simulation_end_time_ns) {
+            Simulator::Schedule(NanoSeconds(m_dynamicStateUpdateIntervalNs), &FluidFlowScheduler::Update, this, next_update_ns);
+        }
+    }
+
+    void FluidFlowScheduler::Complete() {
+        Progress();
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        size_t num_left = 0;
+        for (uint32_t flow_idx : m_active_flow_idxs) {
+            Flow& flow = m_flows[flow_idx];
+            if (flow.remaining_byte < 0.5) { // Completion times are rounded up to the nanosecond
+                flow.remaining_byte = 0;
+                flow.rate_bps = 0;
+                flow.finished = true;
+                flow.end_time_ns = now_ns;
+            } else {
+                m_active_flow_idxs[num_left++] = flow_idx;
+            }
+        }
+        m_active_flow_idxs.resize(num_left);
+        RequestReallocation();
+    }
+
+    void FluidFlowScheduler::RequestReallocation() {
+
+        // Once for all the events at this time (e.g., many flows which start at the same time),
+        // as the reallocation is scheduled after those already scheduled for now
+        if (!m_reallocation_pending) {
+            m_reallocation_pending = true;
+            Simulator::ScheduleNow(&FluidFlowScheduler::Reallocate, this);
+        }
+    }
+
+    void FluidFlowScheduler::Reallocate() {
+        m_reallocation_pending = false;
+        Progress();
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+
+        // Max-min fair rates of the flows which have a path
+        std::vector<uint32_t> routed_flow_idxs;
+        std::vector<std::vector<uint32_t>> flow_links;
+        for (uint32_t flow_idx : m_active_flow_idxs) {
+            m_flows[flow_idx].rate_bps = 0;
+            if (m_flows[flow_idx].has_path) {
+                routed_flow_idxs.push_back(flow_idx);
+                flow_links.push_back(m_flows[flow_idx].links);
+            }
+        }
+        std::vector<double> rates;
+        if (m_background) {
+            std::vector<double> link_capacities(m_link_capacity_bps);
+            for (double& capacity : link_capacities) {
+                capacity *= m_background_max_utilization;
+            }
+            rates = CalculateMaxMinFairRates(flow_links, link_capacities);
+        } else {
+            rates = CalculateMaxMinFairRates(flow_links, m_link_capacity_bps);
+        }
+
+        // Link utilization
+        std::vector<double> link_load_bps(m_link_capacity_bps.size(), 0.0);
+        for (size_t i = 0; i < routed_flow_idxs.size(); i++) {
+            m_flows[routed_flow_idxs[i]].rate_bps = rates[i];
+            for (uint32_t link : flow_links[i]) {
+                link_load_bps[link] += rates[i];
+            }
+        }
+        for (uint32_t node_id = 0; node_id < m_nodeInterfaceTable->GetNNodes(); node_id++) {
+            for (uint32_t if_id = 0; if_id < m_nodeInterfaceTable->GetNInterfaces(node_id); if_id++) {
+                size_t link = m_nodeInterfaceTable->GetEntry(node_id, if_id);
+                double utilization = m_link_capacity_bps[link] > 0 ? std::min(1.0, link_load_bps[link] / m_link_capacity_bps[link]) : 0.0;
+                if (utilization == m_link_utilization[link]) {
+                    continue;
+                }
+                m_link_utilization[link] = utilization;
+                if (m_background) {
+                    SetBackgroundLoad(node_id, if_id, utilization);
+                } else if (m_enable_gsl_utilization_tracking && m_nodeInterfaceTable->GetGslNetDevice(node_id, if_id) != nullptr) {
+                    m_nodeInterfaceTable->GetGslNetDevice(node_id, if_id)->GetUtilizationTracker().TrackUtilization(now_ns, utilization);
+                } else if (m_enable_isl_utilization_tracking && m_nodeInterfaceTable->GetIslNetDevice(node_id, if_id) != nullptr) {
+                    m_nodeInterfaceTable->GetIslNetDevice(node_id, if_id)->GetUtilizationTracker().TrackUtilization(now_ns, utilization);
+                }
+            }
+        }
+
+        // Next flow to finish at these rates
+        m_completion_event.Cancel();
+        double min_completion_ns = std::numeric_limits<double>::infinity();
+        for (uint32_t flow_idx : m_active_flow_idxs) {
+            const Flow& flow = m_flows[flow_idx];
+            if (flow.rate_bps > 0) {
+                min_completion_ns = std::min(min_completion_ns, flow.remaining_byte * 8.0 / flow.rate_bps * 1e9);
+            }
+        }
+        if (min_completion_ns < m_simulation_end_time_ns - now_ns) {
+            int64_t delay_ns = std::max((int64_t) 1, (int64_t) std::ceil(min_completion_ns));
+            m_completion_event = Simulator::Schedule(NanoSeconds(delay_ns), &FluidFlowScheduler::Complete, this);
+        }
+
+    }
+
+    void FluidFlowScheduler::SetBackgroundLoad(uint32_t node_id, uint32_t if_id, double utilization) {
+
+        // Mean waiting time in an M/M/1 queue of the background packets
+        double capacity_bps = m_link_capacity_bps[m_nodeInterfaceTable->GetEntry(node_id, if_id)];
+        double queueing_delay_ns = 0.0;
+        if (capacity_bps > 0) {
+            queueing_delay_ns = utilization / (1.0 - utilization) * m_background_packet_size_byte * 8.0 / capacity_bps * 1e9;
+        }
+        if (m_nodeInterfaceTable->GetGslNetDevice(node_id, if_id) != nullptr) {
+            m_nodeInterfaceTable->GetGslNetDevice(node_id, if_id)->SetBackgroundLoad(utilization, NanoSeconds((int64_t) queueing_delay_ns));
+        } else if (m_nodeInterfaceTable->GetIslNetDevice(node_id, if_id) != nullptr) {
+            m_nodeInterfaceTable->GetIslNetDevice(node_id, if_id)->SetBackgroundLoad(utilization, NanoSeconds((int64_t) queueing_delay_ns));
+        }
+    }
+
+    void FluidFlowScheduler::WriteResults() {
+        if (!m_enabled) {
+            return;
+        }
+        std::cout << "STORE FLUID FLOW RESULTS" << std::endl;
+        Progress();
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+
+        // Same files as the TCP flow scheduler, unless it is the background of its flows
+        std::string prefix = m_background ? "/fluid_flows" : "/tcp_flows";
+        std::string filename_csv = m_basicSimulation->GetLogsDir() + prefix + ".csv";
+        std::string filename_txt = m_basicSimulation->GetLogsDir() + prefix + ".txt";
+        FILE* file_csv = fopen(filename_csv.c_str(), "w+");
+        NS_ABORT_MSG_IF(file_csv == nullptr, "Could not open " << filename_csv);
+        FILE* file_txt = fopen(filename_txt.c_str(), "w+");
+        NS_ABORT_MSG_IF(file_txt == nullptr, "Could not open " << filename_txt);
+        fprintf(
+                file_txt, "%-16s%-10s%-10s%-16s%-18s%-18s%-16s%-16s%-13s%-16s%-14s%s\n",
+                "TCP Flow ID", "Source", "Target", "Size", "Start time (ns)",
+                "End time (ns)", "Duration", "Sent", "Progress", "Avg. rate", "Finished?", "Metadata"
+        );
+        uint32_t num_finished = 0;
+        for (const Flow& flow : m_flows) {
+            const TcpFlowScheduleEntry& entry = flow.entry;
+            int64_t end_time_ns = flow.finished ? flow.end_time_ns : now_ns;
+            int64_t duration_ns = end_time_ns - entry.GetStartTimeNs();
+            int64_t sent_byte = flow.finished ? entry.GetSizeByte() : (int64_t) (entry.GetSizeByte() - std::ceil(flow.remaining_byte));
+            std::string finished_state = flow.finished ? "YES" : "NO_ONGOING";
+            num_finished += flow.finished ? 1 : 0;
+            fprintf(
+                    file_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s,%s\n",
+                    entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), entry.GetSizeByte(), entry.GetStartTimeNs(),
+                    end_time_ns, duration_ns, sent_byte, finished_state.c_str(), entry.GetMetadata().c_str()
+            );
+            fprintf(
+                    file_txt, "%-16" PRId64 "%-10" PRId64 "%-10" PRId64 "%-16s%-18s%-18s%-16s%-16s%-13s%-16s%-14s%s\n",
+                    entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(),
+                    format_string("%.2f Mbit", entry.GetSizeByte() * 8.0 / 1000000.0).c_str(),
+                    format_string("%.2f ms", entry.GetStartTimeNs() / 1000000.0).c_str(),
+                    format_string("%.2f ms", end_time_ns / 1000000.0).c_str(),
+                    format_string("%.2f ms", duration_ns / 1000000.0).c_str(),
+                    format_string("%.2f Mbit", sent_byte * 8.0 / 1000000.0).c_str(),
+                    format_string("%.1f%%", entry.GetSizeByte() > 0 ? 100.0 * sent_byte / entry.GetSizeByte() : 100.0).c_str(),
+                    format_string("%.2f Mbit/s", duration_ns > 0 ? sent_byte * 8.0 / (duration_ns / 1e9) / 1000000.0 : 0.0).c_str(),
+                    finished_state.c_str(),
+                    entry.GetMetadata().c_str()
+            );
+        }
+        fclose(file_csv);
+        fclose(file_txt);
+        std::cout << "  > Finished flows: " << num_finished << " out of " << m_flows.size() << std::endl;
+        m_basicSimulation->RegisterTimestamp("Write fluid flow results");
+        std::cout << std::endl;
+    }
+
+} // namespace ns3
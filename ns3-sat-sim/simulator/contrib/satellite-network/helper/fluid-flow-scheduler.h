@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+
+#ifndef FLUID_FLOW_SCHEDULER_H
+#define FLUID_FLOW_SCHEDULER_H
+
+#include <cinttypes>
+#include <vector>
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/tcp-flow-schedule-reader.h"
+#include "ns3/ipv4-arbiter-routing.h"
+#include "ns3/arbiter-satnet.h"
+#include "ns3/node-interface-table.h"
+#include "ns3/event-id.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+    /**
+     * Flow-level (fluid) alternative to the TCP flow scheduler, for traffic matrices which are too
+     * large to simulate packet by packet.
+     *
+     * The flows of fluid_flow_schedule_filename (same format as the TCP flow schedule) follow the
+     * path given by the forwarding state of the routing arbiters, and share the ISL and GSL
+     * capacities (the data rates of the devices) max-min fairly. Rates are recalculated when a
+     * flow starts or finishes, and at every dynamic state update (each dynamic_state_update_interval_ns)
+     * as the forwarding state and the GSL bandwidth change. A flow without a path does not progress.
+     *
+     * It does not model TCP (no slow start, congestion window or retransmissions), propagation
+     * delay or queueing, so completion times are a lower bound of what the packet-level
+     * simulation would give. The results are written in the same files as the TCP flow
+     * scheduler (tcp_flows.csv and tcp_flows.txt), and the load of the links goes into the ISL
+     * and GSL utilization tracking of the topology (if enabled). Packet-level traffic (the TCP
+     * flow, UDP burst or pingmesh scheduler) can then not be enabled as well.
+     *
+     * With fluid_flow_background enabled, the fluid flows are instead the background load of
+     * packet-level (foreground) traffic, e.g., of the TCP flow scheduler. They get at most
+     * fluid_flow_background_max_utilization of each link, and their load is set on the devices:
+     * packets are sent at the data rate which is left, and wait behind the background traffic
+     * (M/M/1 queueing delay of packets of fluid_flow_background_packet_size_byte). The results
+     * are then written to fluid_flows.csv and fluid_flows.txt.
+     */
+    class FluidFlowScheduler
+    {
+    public:
+        FluidFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<TopologySatelliteNetwork> topology);
+        void WriteResults();
+
+        // Max-min fair rate of each flow (progressive filling), flow_links[i] are the links crossed
+        // by flow i (at least one), each link is shared by the flows crossing it up to its capacity
+        static std::vector<double> CalculateMaxMinFairRates(
+                const std::vector<std::vector<uint32_t>>& flow_links, const std::vector<double>& link_capacities
+        );
+
+    private:
+        struct Flow {
+            TcpFlowScheduleEntry entry;
+            bool started;
+            bool finished;
+            int64_t end_time_ns;
+            double remaining_byte;
+            double rate_bps;
+            bool has_path;
+            std::vector<uint32_t> links;  // Entries of the node interface table
+        };
+
+        void StartFlow(uint32_t flow_idx);
+        void Update(int64_t t);
+        void Complete();
+        void Progress();
+        void RequestReallocation();
+        void Reallocate();
+        void UpdateLinkCapacities();
+        void UpdatePath(Flow& flow);
+        void SetBackgroundLoad(uint32_t node_id, uint32_t if_id, double utilization);
+
+        // Parameters
+        Ptr<BasicSimulation> m_basicSimulation;
+        Ptr<TopologySatelliteNetwork> m_topology;
+        Ptr<NodeInterfaceTable> m_nodeInterfaceTable;
+        bool m_enabled;
+        int64_t m_simulation_end_time_ns;
+        int64_t m_dynamicStateUpdateIntervalNs;
+        bool m_enable_isl_utilization_tracking;
+        bool m_enable_gsl_utilization_tracking;
+        bool m_background;
+        double m_background_max_utilization;
+        int64_t m_background_packet_size_byte;
+        std::vector<Ptr<ArbiterSatnet>> m_arbiters;
+
+        // Flows and links
+        std::vector<Flow> m_flows;
+        std::vector<uint32_t> m_active_flow_idxs;
+        std::vector<double> m_link_capacity_bps;  // Per entry of the node interface table
+        std::vector<double> m_link_utilization;   // Of the full capacity (-1 if it must be set again)
+
+        // State
+        int64_t m_last_progress_ns;
+        bool m_reallocation_pending;
+        EventId m_completion_event;
+
+    };
+
+} // namespace ns3
+
+#endif /* FLUID_FLOW_SCHEDULER_H */
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "gsl-handover-helper.h"
+#include <map>
+#include <queue>
+#include <limits>
+
+namespace ns3 {
+
+    GslHandoverHelper::GslHandoverHelper (Ptr<BasicSimulation> basicSimulation, Ptr<TopologySatelliteNetwork> topology) {
+        std::cout << "SETUP GSL HANDOVER HELPER" << std::endl;
+        m_basicSimulation = basicSimulation;
+        m_topology = topology;
+        m_nodes = topology->GetNodes();
+        m_nodeInterfaceTable = topology->GetNodeInterfaceTable();
+
+        // Selection of the serving satellites
+        std::string policy = m_basicSimulation->GetConfigParamOrFail("gsl_handover_policy");
+        if (policy == "nearest") {
+            m_policy = POLICY_NEAREST;
+        } else if (policy == "highest_elevation") {
+            m_policy = POLICY_HIGHEST_ELEVATION;
+        } else if (policy == "sticky") {
+            m_policy = POLICY_STICKY;
+        } else {
+            throw std::runtime_error(format_string("Invalid GSL handover policy: %s (must be nearest, highest_elevation or sticky)", policy.c_str()));
+        }
+        m_min_elevation_deg = parse_double(m_basicSimulation->GetConfigParamOrDefault("gsl_handover_min_elevation_deg", "25.0"));
+        m_share_satellite_bandwidth = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("gsl_handover_share_satellite_bandwidth", "false"));
+        m_gsl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("gsl_data_rate_megabit_per_s"));
+        std::cout << "  > Policy: " << policy << " (minimum elevation: " << m_min_elevation_deg << " deg)" << std::endl;
+
+        // Set the routing arbiters, with an empty forwarding state (-2 indicates an invalid entry)
+        std::cout << "  > Setting the routing arbiter on each node" << std::endl;
+        std::vector<std::tuple<int32_t, int32_t, int32_t>> empty_next_hop_list(m_nodes.GetN(), std::make_tuple(-2, -2, -2));
+        for (size_t i = 0; i < m_nodes.GetN(); i++) {
+            Ptr<ArbiterSingleForward> arbiter = CreateObject<ArbiterSingleForward>(m_nodes.Get(i), m_nodes, empty_next_hop_list);
+            arbiter->SetNodeInterfaceTable(m_nodeInterfaceTable);
+            m_arbiters.push_back(arbiter);
+            m_nodeInterfaceTable->GetIpv4(i)->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetArbiter(arbiter);
+        }
+        basicSimulation->RegisterTimestamp("Setup routing arbiter on each node");
+
+        // ISL and GSL interfaces of each node
+        ReadInterfaces();
+        m_serving_sat_ids.assign(m_topology->GetNumGroundStations(), -1);
+        m_num_served.assign(m_topology->GetNumSatellites(), 0);
+
+        // First handover
+        m_dynamicStateUpdateIntervalNs = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("dynamic_state_update_interval_ns"));
+        std::cout << "  > Handover update interval: " << m_dynamicStateUpdateIntervalNs << "ns" << std::endl;
+        std::cout << "  > Perform first handover for t=0" << std::endl;
+        Update(0);
+        basicSimulation->RegisterTimestamp("Perform first GSL handover");
+
+        std::cout << std::endl;
+    }
+
+    bool GslHandoverHelper::IsEnabled(Ptr<BasicSimulation> basicSimulation) {
+        return !basicSimulation->GetConfigParamOrDefault("gsl_handover_policy", "").empty();
+    }
+
+    void GslHandoverHelper::ReadInterfaces() {
+        uint32_t num_satellites = m_topology->GetNumSatellites();
+        m_isls.resize(num_satellites);
+        m_gsl_if.assign(m_nodes.GetN(), -1);
+        for (uint32_t node_id = 0; node_id < m_nodes.GetN(); node_id++) {
+            for (uint32_t i = 1; i < m_nodeInterfaceTable->GetNInterfaces(node_id); i++) {
+                Ptr<NetDevice> device = m_nodeInterfaceTable->GetNetDevice(node_id, i);
+                if (m_nodeInterfaceTable->GetGslNetDevice(node_id, i) != nullptr) {
+                    if (m_gsl_if[node_id] == -1) {
+                        m_gsl_if[node_id] = i;
+                    }
+                } else if (m_nodeInterfaceTable->GetIslNetDevice(node_id, i) != nullptr) {
+                    Ptr<Channel> channel = device->GetChannel();
+                    Ptr<NetDevice> other_device = channel->GetDevice(0) == device ? channel->GetDevice(1) : channel->GetDevice(0);
+                    Isl isl;
+                    isl.neighbor_sat_id = other_device->GetNode()->GetId();
+                    isl.own_if = i;
+                    isl.neighbor_if = other_device->GetNode()->GetObject<Ipv4>()->GetInterfaceForDevice(other_device);
+                    NS_ABORT_MSG_IF(node_id >= num_satellites || isl.neighbor_sat_id >= num_satellites, "ISLs can only be between satellites");
+                    m_isls[node_id].push_back(isl);
+                }
+            }
+            NS_ABORT_MSG_IF(node_id >= num_satellites && m_gsl_if[node_id] == -1, "Ground station node " << node_id << " has no GSL interface");
+        }
+    }
+
+    int32_t GslHandoverHelper::SelectServingSatellite(
+            Policy policy, int32_t current_sat_id, const std::vector<uint32_t>& visible_sat_ids,
+            const std::vector<Vector>& satellite_positions, const Vector& ground_station_position
+    ) {
+
+        // Sticky stays with the current satellite as long as it is visible
+        if (policy == POLICY_STICKY && current_sat_id != -1
+            && std::find(visible_sat_ids.begin(), visible_sat_ids.end(), (uint32_t) current_sat_id) != visible_sat_ids.end()) {
+            return current_sat_id;
+        }
+
+        // Nearest (also for a sticky handover) or highest elevation, ties go to the lowest id
+        int32_t best_sat_id = -1;
+        double best_score = std::numeric_limits<double>::lowest();
+        for (uint32_t sat_id : visible_sat_ids) {
+            const Vector& position = satellite_positions.at(sat_id);
+            double score = policy == POLICY_HIGHEST_ELEVATION
+                           ? SatelliteVisibilityIndex::CalculateElevationDeg(ground_station_position, position)
+                           : -CalculateDistance(ground_station_position, position);
+            if (score > best_score) {
+                best_score = score;
+                best_sat_id = sat_id;
+            }
+        }
+        return best_sat_id;
+    }
+
+    std::vector<int32_t> GslHandoverHelper::CalculateNextHopsTowards(
+            uint32_t root_sat_id, const std::vector<std::vector<std::pair<uint32_t, double>>>& weighted_isls
+    ) {
+
+        // Dijkstra from the root: as ISLs are bidirectional, the predecessor of a satellite on
+        // the shortest path from the root is its next hop towards the root
+        std::vector<double> distance(weighted_isls.size(), std::numeric_limits<double>::infinity());
+        std::vector<int32_t> next_hops(weighted_isls.size(), -1);
+        std::priority_queue<std::pair<double, uint32_t>, std::vector<std::pair<double, uint32_t>>, std::greater<std::pair<double, uint32_t>>> queue;
+        distance.at(root_sat_id) = 0;
+        next_hops.at(root_sat_id) = root_sat_id;
+        queue.push(std::make_pair(0.0, root_sat_id));
+        while (!queue.empty()) {
+            std::pair<double, uint32_t> top = queue.top();
+            queue.pop();
+            if (top.first > distance[top.second]) {
+                continue;
+            }
+            for (const std::pair<uint32_t, double>& isl : weighted_isls[top.second]) {
+                double d = top.first + isl.second;
+                if (d < distance[isl.first]) {
+                    distance[isl.first] = d;
+                    next_hops[isl.first] = top.second;
+                    queue.push(std::make_pair(d, isl.first));
+                }
+            }
+        }
+        return next_hops;
+    }
+
+    void GslHandoverHelper::Update(int64_t t) {
+
+        // Current satellite positions
+        uint32_t num_satellites = m_topology->GetNumSatellites();
+        std::vector<Vector> satellite_positions;
+        for (uint32_t i = 0; i < num_satellites; i++) {
+            satellite_positions.push_back(m_topology->GetSatelliteNodes().Get(i)->GetObject<MobilityModel>()->GetPosition());
+        }
+
+        // Serving satellite of each ground station
+        for (uint32_t gs_id = 0; gs_id < m_serving_sat_ids.size(); gs_id++) {
+            std::vector<uint32_t> visible_sat_ids = m_topology->GetVisibleSatellites(gs_id, m_min_elevation_deg);
+            int32_t current_sat_id = m_serving_sat_ids[gs_id];
+            int32_t new_sat_id = SelectServingSatellite(
+                    m_policy, current_sat_id, visible_sat_ids, satellite_positions,
+                    m_topology->GetGroundStations().at(gs_id)->GetCartesianPosition()
+            );
+            if (new_sat_id != current_sat_id) {
+                Handover handover;
+                handover.t_ns = t;
+                handover.gs_id = gs_id;
+                handover.from_sat_id = current_sat_id;
+                handover.to_sat_id = new_sat_id;
+                m_handovers.push_back(handover);
+                if (current_sat_id != -1) {
+                    m_num_served[current_sat_id]--;
+                }
+                if (new_sat_id != -1) {
+                    m_num_served[new_sat_id]++;
+                }
+                m_serving_sat_ids[gs_id] = new_sat_id;
+            }
+        }
+
+        UpdateForwardingState(satellite_positions);
+        if (m_share_satellite_bandwidth) {
+            UpdateGslBandwidth();
+        }
+
+        // Plan the next update
+        if (!parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_force_static", "false"))) {
+            int64_t next_update_ns = t + m_dynamicStateUpdateIntervalNs;
+            if (next_update_ns < m_basicSimulation->GetSimulationEndTimeNs()) {
+                Simulator::Schedule(NanoSeconds(m_dynamicStateUpdateIntervalNs), &GslHandoverHelper::Update, this, next_update_ns);
+            }
+        }
+
+    }
+
+    void GslHandoverHelper::UpdateForwardingState(const std::vector<Vector>& satellite_positions) {
+        uint32_t num_satellites = m_topology->GetNumSatellites();
+
+        // ISL lengths at the current positions
+        std::vector<std::vector<std::pair<uint32_t, double>>> weighted_isls(num_satellites);
+        for (uint32_t sat_id = 0; sat_id < num_satellites; sat_id++) {
+            for (const Isl& isl : m_isls[sat_id]) {
+                weighted_isls[sat_id].push_back(std::make_pair(
+                        isl.neighbor_sat_id, CalculateDistance(satellite_positions[sat_id], satellite_positions[isl.neighbor_sat_id])
+                ));
+            }
+        }
+
+        // Shortest paths are calculated once per serving satellite
+        std::map<uint32_t, std::vector<int32_t>> next_hops_towards;
+        for (uint32_t dst_gs_id = 0; dst_gs_id < m_serving_sat_ids.size(); dst_gs_id++) {
+            int32_t target_node_id = num_satellites + dst_gs_id;
+            int32_t root_sat_id = m_serving_sat_ids[dst_gs_id];
+            const std::vector<int32_t>* next_hops = nullptr;
+            if (root_sat_id != -1) {
+                if (next_hops_towards.find(root_sat_id) == next_hops_towards.end()) {
+                    next_hops_towards[root_sat_id] = CalculateNextHopsTowards(root_sat_id, weighted_isls);
+                }
+                next_hops = &next_hops_towards[root_sat_id];
+            }
+
+            // Satellites: down the GSL at the serving satellite, else over the ISL towards it (drop if unreachable)
+            for (uint32_t sat_id = 0; sat_id < num_satellites; sat_id++) {
+                if (next_hops == nullptr || (*next_hops)[sat_id] == -1) {
+                    m_arbiters[sat_id]->SetSingleForwardState(target_node_id, -1, 0, 0);
+                } else if ((int32_t) sat_id == root_sat_id) {
+                    m_arbiters[sat_id]->SetSingleForwardState(target_node_id, target_node_id, m_gsl_if[sat_id], m_gsl_if[target_node_id]);
+                } else {
+                    uint32_t next_sat_id = (*next_hops)[sat_id];
+                    for (const Isl& isl : m_isls[sat_id]) {
+                        if (isl.neighbor_sat_id == next_sat_id) {
+                            m_arbiters[sat_id]->SetSingleForwardState(target_node_id, next_sat_id, isl.own_if, isl.neighbor_if);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // Other ground stations: up the GSL to their serving satellite (drop if it cannot reach the destination)
+            for (uint32_t src_gs_id = 0; src_gs_id < m_serving_sat_ids.size(); src_gs_id++) {
+                if (src_gs_id == dst_gs_id) {
+                    continue;
+                }
+                uint32_t src_node_id = num_satellites + src_gs_id;
+                int32_t up_sat_id = m_serving_sat_ids[src_gs_id];
+                if (next_hops == nullptr || up_sat_id == -1 || (*next_hops)[up_sat_id] == -1) {
+                    m_arbiters[src_node_id]->SetSingleForwardState(target_node_id, -1, 0, 0);
+                } else {
+                    m_arbiters[src_node_id]->SetSingleForwardState(target_node_id, up_sat_id, m_gsl_if[src_node_id], m_gsl_if[up_sat_id]);
+                }
+            }
+        }
+
+    }
+
+    void GslHandoverHelper::UpdateGslBandwidth() {
+        for (uint32_t sat_id = 0; sat_id < m_num_served.size(); sat_id++) {
+            if (m_gsl_if[sat_id] != -1) {
+                double rate_megabit_per_s = m_gsl_data_rate_megabit_per_s / std::max((uint32_t) 1, m_num_served[sat_id]);
+                m_nodeInterfaceTable->GetGslNetDevice(sat_id, m_gsl_if[sat_id])->SetDataRate(
+                        DataRate(std::to_string(rate_megabit_per_s) + "Mbps")
+                );
+            }
+        }
+    }
+
+    void GslHandoverHelper::WriteResults(const std::string& logs_dir) {
+        std::cout << "WRITING GSL HANDOVER RESULTS" << std::endl;
+        FILE* file_csv = fopen((logs_dir + "/gsl_handovers.csv").c_str(), "w+");
+        NS_ABORT_MSG_IF(file_csv == nullptr, "Could not open " << logs_dir << "/gsl_handovers.csv");
+        for (const Handover& handover : m_handovers) {
+            fprintf(file_csv, "%" PRId64 ",%u,%d,%d\n", handover.t_ns, handover.gs_id, handover.from_sat_id, handover.to_sat_id);
+        }
+        fclose(file_csv);
+        std::cout << "  > Handovers: " << m_handovers.size() << std::endl;
+        std::cout << std::endl;
+    }
+
+    const std::vector<int32_t>& GslHandoverHelper::GetServingSatellites() {
+        return m_serving_sat_ids;
+    }
+
+    const std::vector<GslHandoverHelper::Handover>& GslHandoverHelper::GetHandovers() {
+        return m_handovers;
+    }
+
+} // namespace ns3
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef GSL_HANDOVER_HELPER
+#define GSL_HANDOVER_HELPER
+
+#include <algorithm>
+#include <cinttypes>
+#include "ns3/ipv4-routing-helper.h"
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/ipv4-arbiter-routing.h"
+#include "ns3/arbiter-single-forward.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/point-to-point-laser-net-device.h"
+#include "ns3/satellite-visibility-index.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+    /**
+     * Decides during the simulation which satellite serves each ground station, and from that
+     * the forwarding state and GSL interface bandwidth, instead of reading them from the
+     * precomputed fstate_<t>.txt and gsl_if_bandwidth_<t>.txt files.
+     *
+     * At every update (each dynamic_state_update_interval_ns) the serving satellite of each
+     * ground station is selected among the satellites visible above gsl_handover_min_elevation_deg
+     * at their current position, according to gsl_handover_policy:
+     *
+     *  - nearest: the satellite at the smallest distance
+     *  - highest_elevation: the satellite at the highest elevation
+     *  - sticky: the current satellite as long as it is visible, else the nearest
+     *
+     * Traffic to a ground station goes over the shortest path (ISL distance) to its serving
+     * satellite, which sends it down the GSL. If gsl_handover_share_satellite_bandwidth is
+     * enabled, the GSL data rate of a satellite is divided equally among the ground stations
+     * it serves. Every change of serving satellite is recorded, and written by WriteResults().
+     */
+    class GslHandoverHelper
+    {
+    public:
+        enum Policy {
+            POLICY_NEAREST,
+            POLICY_HIGHEST_ELEVATION,
+            POLICY_STICKY
+        };
+
+        struct Handover {
+            int64_t t_ns;
+            uint32_t gs_id;
+            int32_t from_sat_id;  // -1 if it was not served
+            int32_t to_sat_id;    // -1 if it is no longer served
+        };
+
+        GslHandoverHelper(Ptr<BasicSimulation> basicSimulation, Ptr<TopologySatelliteNetwork> topology);
+
+        // Whether the run uses the handover engine (gsl_handover_policy set) instead of state files
+        static bool IsEnabled(Ptr<BasicSimulation> basicSimulation);
+
+        // Writes <logs_dir>/gsl_handovers.csv with lines: <t_ns>,<gs_id>,<from_sat_id>,<to_sat_id>
+        void WriteResults(const std::string& logs_dir);
+
+        const std::vector<int32_t>& GetServingSatellites();
+        const std::vector<Handover>& GetHandovers();
+
+        // Serving satellite among the visible ones (-1 if none is visible)
+        static int32_t SelectServingSatellite(
+                Policy policy, int32_t current_sat_id, const std::vector<uint32_t>& visible_sat_ids,
+                const std::vector<Vector>& satellite_positions, const Vector& ground_station_position
+        );
+
+        // Next satellite from each satellite on the shortest path to the root (root for itself, -1 if unreachable)
+        static std::vector<int32_t> CalculateNextHopsTowards(
+                uint32_t root_sat_id, const std::vector<std::vector<std::pair<uint32_t, double>>>& weighted_isls
+        );
+
+    private:
+        struct Isl {
+            uint32_t neighbor_sat_id;
+            uint32_t own_if;       // Interface index (including the loop-back interface)
+            uint32_t neighbor_if;
+        };
+
+        void ReadInterfaces();
+        void Update(int64_t t);
+        void UpdateForwardingState(const std::vector<Vector>& satellite_positions);
+        void UpdateGslBandwidth();
+
+        // Parameters
+        Ptr<BasicSimulation> m_basicSimulation;
+        Ptr<TopologySatelliteNetwork> m_topology;
+        NodeContainer m_nodes;
+        Ptr<NodeInterfaceTable> m_nodeInterfaceTable;
+        Policy m_policy;
+        double m_min_elevation_deg;
+        bool m_share_satellite_bandwidth;
+        double m_gsl_data_rate_megabit_per_s;
+        int64_t m_dynamicStateUpdateIntervalNs;
+        std::vector<Ptr<ArbiterSingleForward>> m_arbiters;
+
+        // Interfaces
+        std::vector<std::vector<Isl>> m_isls;   // Per satellite
+        std::vector<int32_t> m_gsl_if;          // Per node, interface index of its (first) GSL device
+
+        // State
+        std::vector<int32_t> m_serving_sat_ids; // Per ground station
+        std::vector<uint32_t> m_num_served;     // Per satellite
+        std::vector<Handover> m_handovers;
+
+    };
+
+} // namespace ns3
+
+#endif /* GSL_HANDOVER_HELPER */
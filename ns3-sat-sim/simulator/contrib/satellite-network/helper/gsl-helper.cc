@@ -29,7 +29,7 @@
 #include "ns3/simulator.h"
 #include "ns3/gsl-net-device.h"
 #include "ns3/gsl-channel.h"
-#include "ns3/queue.h"
+#include "ns3/gsl-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/config.h"
 #include "ns3/packet.h"
@@ -47,7 +47,7 @@ NS_LOG_COMPONENT_DEFINE ("GSLHelper");
 
 GSLHelper::GSLHelper ()
 {
-  m_queueFactory.SetTypeId ("ns3::DropTailQueue<Packet>");
+  m_queueFactory.SetTypeId ("ns3::GSLQueue");
   m_deviceFactory.SetTypeId ("ns3::GSLNetDevice");
   m_channelFactory.SetTypeId ("ns3::GSLChannel");
 }
@@ -59,8 +59,6 @@ GSLHelper::SetQueue (std::string type,
                      std::string n3, const AttributeValue &v3,
                      std::string n4, const AttributeValue &v4)
 {
-  QueueBase::AppendItemTypeIfNotPresent (type, "Packet");
-
   m_queueFactory.SetTypeId (type);
   m_queueFactory.Set (n1, v1);
   m_queueFactory.Set (n2, v2);
@@ -113,11 +111,9 @@ GSLHelper::Install (NodeContainer satellites, NodeContainer ground_stations, std
 
     }
 
-    // The lower bound for the GSL channel must be set to facilitate distributed simulation.
-    // However, this is challenging, as delays vary over time based on the movement.
-    // As such, for now this delay = lookahead time is set to 0.
+    // The lower bound delay (lookahead) of the GSL channel is the "Delay" channel attribute,
+    // which must be set to the smallest delay a GSL can ever have for distributed simulation
     // (see also the Delay attribute in gsl-channel.cc)
-    channel->SetAttribute("Delay", TimeValue(Seconds(0)));
 
     return allNetDevices;
 }
@@ -128,23 +124,24 @@ GSLHelper::Install (Ptr<Node> node, Ptr<GSLChannel> channel) {
     // Create device
     Ptr<GSLNetDevice> dev = m_deviceFactory.Create<GSLNetDevice>();
 
-    // Set unique MAC address
+    // Set unique MAC address (devices installed one after the other get a contiguous
+    // range, which the channel then uses to directly index the destination device)
     dev->SetAddress (Mac48Address::Allocate ());
 
     // Add device to the node
     node->AddDevice (dev);
 
     // Set device queue
-    Ptr<Queue<Packet> > queue = m_queueFactory.Create<Queue<Packet>>();
+    Ptr<GSLQueue> queue = m_queueFactory.Create<GSLQueue>();
     dev->SetQueue (queue);
 
-    // Aggregate NetDeviceQueueInterface objects to connect
-    // the device queue to the interface (used by traffic control layer)
+    // Aggregate NetDeviceQueueInterface object (used by traffic control layer),
+    // its transmission queue is never stopped as the GSL queue is not a Queue<Packet>:
+    // a packet which does not fit in the GSL queue is dropped by the device (MacTxDrop)
     Ptr<NetDeviceQueueInterface> ndqi = CreateObject<NetDeviceQueueInterface>();
-    ndqi->GetTxQueue (0)->ConnectQueueTraces (queue);
     dev->AggregateObject (ndqi);
 
-    // Aggregate MPI receivers // TODO: Why?
+    // Aggregate MPI receiver, which receives packets sent to this device from another system
     Ptr<MpiReceiver> mpiRec = CreateObject<MpiReceiver> ();
     mpiRec->SetReceiveCallback (MakeCallback (&GSLNetDevice::Receive, dev));
     dev->AggregateObject(mpiRec);
@@ -18,13 +18,16 @@
  */
 
 #include "gsl-if-bandwidth-helper.h"
+#include "ns3/hot-path-profiler.h"
 
 namespace ns3 {
 
-    GslIfBandwidthHelper::GslIfBandwidthHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes) {
+    GslIfBandwidthHelper::GslIfBandwidthHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, Ptr<NodeInterfaceTable> nodeInterfaceTable) {
         std::cout << "SETUP GSL IF BANDWIDTH HELPER" << std::endl;
         m_basicSimulation = basicSimulation;
         m_nodes = nodes;
+        m_nodeInterfaceTable = nodeInterfaceTable != 0 ? nodeInterfaceTable : Create<NodeInterfaceTable>(nodes);
+        NS_ABORT_MSG_IF(m_nodeInterfaceTable->GetNNodes() != m_nodes.GetN(), "Interface table does not match the nodes");
         m_gsl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("gsl_data_rate_megabit_per_s"));
 
         // Load first forwarding state
@@ -38,6 +41,7 @@ namespace ns3 {
     }
 
     void GslIfBandwidthHelper::UpdateGslIfBandwidth(int64_t t) {
+        SATNET_PROFILE_SCOPE(GSL_BANDWIDTH_UPDATE);
 
         // Filename
         std::ostringstream res;
@@ -71,10 +75,12 @@ namespace ns3 {
                 NS_ABORT_MSG_IF(node_id < 0 || node_id >= m_nodes.GetN(), "Invalid node id.");
 
                 // Check the interface
-                NS_ABORT_MSG_IF(if_id < 0 || if_id + 1 >= m_nodes.Get(node_id)->GetObject<Ipv4>()->GetNInterfaces(), "Invalid interface");
+                NS_ABORT_MSG_IF(if_id < 0 || if_id + 1 >= m_nodeInterfaceTable->GetNInterfaces(node_id), "Invalid interface");
 
-                // Set data rate (the ->GetObject<GSLNetDevice>() will fail if it is not a GSL network device)
-                m_nodes.Get(node_id)->GetObject<Ipv4>()->GetNetDevice(1 + if_id)->GetObject<GSLNetDevice>()->SetDataRate(
+                // Set data rate
+                GSLNetDevice* gsl_device = m_nodeInterfaceTable->GetGslNetDevice(node_id, 1 + if_id);
+                NS_ABORT_MSG_IF(gsl_device == nullptr, "Interface is not attached to a GSL network device");
+                gsl_device->SetDataRate(
                         DataRate (std::to_string(m_gsl_data_rate_megabit_per_s * bandwidth_fraction) + "Mbps")
                 );
 
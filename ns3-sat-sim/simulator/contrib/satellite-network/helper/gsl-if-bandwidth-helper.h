@@ -25,19 +25,22 @@
 #include "ns3/topology-satellite-network.h"
 #include "ns3/ipv4-arbiter-routing.h"
 #include "ns3/arbiter-single-forward.h"
+#include "ns3/node-interface-table.h"
 
 namespace ns3 {
 
     class GslIfBandwidthHelper
     {
     public:
-        GslIfBandwidthHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes);
+        // The interface table of the nodes is built if none is given (e.g., TopologySatelliteNetwork::GetNodeInterfaceTable())
+        GslIfBandwidthHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, Ptr<NodeInterfaceTable> nodeInterfaceTable = 0);
     private:
         void UpdateGslIfBandwidth(int64_t t);
 
         // Parameters
         Ptr<BasicSimulation> m_basicSimulation;
         NodeContainer m_nodes;
+        Ptr<NodeInterfaceTable> m_nodeInterfaceTable;
         double m_gsl_data_rate_megabit_per_s;
         int64_t m_dynamicStateUpdateIntervalNs;
 
@@ -18,6 +18,7 @@
  */
 
 #include "ns3/arbiter-satnet.h"
+#include "ns3/hot-path-profiler.h"
 
 namespace ns3 {
 
@@ -38,6 +39,10 @@ ArbiterSatnet::ArbiterSatnet(
     // Intentionally left empty
 }
 
+void ArbiterSatnet::SetNodeInterfaceTable(Ptr<NodeInterfaceTable> nodeInterfaceTable) {
+    m_nodeInterfaceTable = nodeInterfaceTable;
+}
+
 ArbiterResult ArbiterSatnet::Decide(
         int32_t source_node_id,
         int32_t target_node_id,
@@ -45,6 +50,7 @@ ArbiterResult ArbiterSatnet::Decide(
         ns3::Ipv4Header const &ipHeader,
         bool is_socket_request_for_source_ip
 ) {
+    SATNET_PROFILE_SCOPE(ARBITER_DECIDE);
 
     // Decide the next node
     std::tuple<int32_t, int32_t, int32_t> next_node_id_my_if_next_if = TopologySatelliteNetworkDecide(
@@ -67,7 +73,12 @@ ArbiterResult ArbiterSatnet::Decide(
     if (next_node_id != -1) {
 
         // Retrieve the IP gateway
-        uint32_t select_ip_gateway = m_nodes.Get(next_node_id)->GetObject<Ipv4>()->GetAddress(next_if_id, 0).GetLocal().Get();
+        uint32_t select_ip_gateway;
+        if (m_nodeInterfaceTable != 0) {
+            select_ip_gateway = m_nodeInterfaceTable->GetLocalAddress(next_node_id, next_if_id).Get();
+        } else {
+            select_ip_gateway = m_nodes.Get(next_node_id)->GetObject<Ipv4>()->GetAddress(next_if_id, 0).GetLocal().Get();
+        }
 
         // We succeeded in finding the interface and gateway to the next hop
         return ArbiterResult(false, own_if_id, select_ip_gateway);
@@ -34,6 +34,7 @@
 #include <chrono>
 #include <stdexcept>
 #include "ns3/topology-satellite-network.h"
+#include "ns3/node-interface-table.h"
 #include "ns3/node-container.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-header.h"
@@ -81,6 +82,12 @@ public:
 
     virtual std::string StringReprOfForwardingState() = 0;
 
+    // Lookup table of the IP addresses of the next hops (without it, they are retrieved from the nodes)
+    void SetNodeInterfaceTable(Ptr<NodeInterfaceTable> nodeInterfaceTable);
+
+private:
+    Ptr<NodeInterfaceTable> m_nodeInterfaceTable;
+
 };
 
 }
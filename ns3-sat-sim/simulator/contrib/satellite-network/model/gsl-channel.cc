@@ -21,11 +21,14 @@
  */
 
 
+#include <functional>
 #include "gsl-channel.h"
 #include "ns3/core-module.h"
 #include "ns3/abort.h"
 #include "ns3/mpi-interface.h"
 #include "ns3/gsl-net-device.h"
+#include "ns3/hot-path-profiler.h"
+#include "ns3/boolean.h"
 
 namespace ns3 {
 
@@ -50,17 +53,52 @@ GSLChannel::GetTypeId (void)
                    DoubleValue (299792458.0), // Default is speed of light
                    MakeDoubleAccessor (&GSLChannel::m_propagationSpeedMetersPerSecond),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("DelayCacheTolerance",
+                   "The delay between a pair of network devices is calculated at most once within each quantum "
+                   "of this length, and re-used for all packets sent within the quantum (zero: calculated for every packet)",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&GSLChannel::m_delayCacheTolerance),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("DelayCacheSize",
+                   "Number of (source, destination) pairs of which the delay can be cached",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&GSLChannel::m_delayCacheSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("ZeroCopy",
+                   "Hand the transmitted packet itself over to the receiving network device instead of a copy "
+                   "(the sending device is done with it once its transmission completed, which is before the "
+                   "arrival; trace sinks must not hold on to packets, as the receiver modifies them)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&GSLChannel::m_zeroCopy),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 GSLChannel::GSLChannel()
   :
-    Channel ()
+    Channel (),
+    m_zeroCopy (false),
+    m_first_mac (0),
+    m_contiguous_macs (true),
+    m_delayCacheSize (4096)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
 
+static uint64_t
+Mac48AddressToInteger (Mac48Address const &x)
+{
+  uint8_t address[6];
+  x.CopyTo (address);
+  uint64_t value = 0;
+  for (size_t i = 0; i < 6; i++) {
+    value <<= 8;
+    value |= address[i];
+  }
+  return value;
+}
+
 bool
 GSLChannel::TransmitStart (
   Ptr<const Packet> p,
@@ -71,56 +109,103 @@ GSLChannel::TransmitStart (
   NS_LOG_FUNCTION (this << p << src);
   NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
 
-  Mac48Address address48 = Mac48Address::ConvertFrom (dst_address);
-  MacToNetDeviceI it = m_link.find (address48);
-  if (it != m_link.end ()) {
-    Ptr<GSLNetDevice> dst = it->second;
-    bool sameSystem = (src->GetNode()->GetSystemId() == dst->GetNode()->GetSystemId());
-    return TransmitTo(p, src, it->second, txTime, sameSystem);
+  int64_t dst_idx = GetDeviceIndex (dst_address);
+  NS_ABORT_MSG_IF (dst_idx < 0, "MAC address could not be mapped to a network device.");
+  int64_t src_idx = GetDeviceIndex (src->GetAddress ());
+  NS_ASSERT_MSG (src_idx >= 0, "Source network device is not attached to this channel.");
+  return TransmitStart (p, (uint32_t) src_idx, (uint32_t) dst_idx, txTime);
+}
+
+bool
+GSLChannel::TransmitStart (
+  Ptr<const Packet> p,
+  uint32_t src_idx,
+  uint32_t dst_idx,
+  Time txTime)
+{
+  NS_LOG_FUNCTION (this << p << src_idx << dst_idx);
+  NS_ASSERT_MSG (src_idx < m_net_devices.size () && dst_idx < m_net_devices.size (), "Network device index out of range.");
+
+  bool sameSystem = (m_net_device_system_ids[src_idx] == m_net_device_system_ids[dst_idx]);
+  Time delay = GetDeviceDelay (src_idx, dst_idx);
+  return TransmitTo(p, m_net_devices[src_idx], m_net_devices[dst_idx], txTime, delay, sameSystem);
+}
+
+Time
+GSLChannel::GetDeviceDelay (uint32_t src_idx, uint32_t dst_idx)
+{
+  Ptr<MobilityModel> senderMobility;
+  Ptr<MobilityModel> receiverMobility;
+  if (!m_delayCacheTolerance.IsStrictlyPositive ()) {
+    senderMobility = m_net_devices[src_idx]->GetNode ()->GetObject<MobilityModel> ();
+    receiverMobility = m_net_devices[dst_idx]->GetNode ()->GetObject<MobilityModel> ();
+    return GetDelay (senderMobility, receiverMobility);
+  }
+
+  // Look-up in the cache
+  if (m_delay_cache.size () != m_delayCacheSize) {
+    m_delay_cache.assign (m_delayCacheSize, DelayCacheEntry {0, -1, Seconds (0)});
+  }
+  uint64_t pair = (((uint64_t) src_idx) << 32) | dst_idx;
+  int64_t quantum = Simulator::Now ().GetTimeStep () / m_delayCacheTolerance.GetTimeStep ();
+  DelayCacheEntry &entry = m_delay_cache[(src_idx * 2654435761u + dst_idx) % m_delayCacheSize];
+  if (entry.pair == pair && entry.quantum == quantum) {
+    return entry.delay;
   }
 
-  NS_ABORT_MSG("MAC address could not be mapped to a network device.");
-  return false;
+  // Calculate and store
+  senderMobility = m_net_devices[src_idx]->GetNode ()->GetObject<MobilityModel> ();
+  receiverMobility = m_net_devices[dst_idx]->GetNode ()->GetObject<MobilityModel> ();
+  entry.pair = pair;
+  entry.quantum = quantum;
+  entry.delay = GetDelay (senderMobility, receiverMobility);
+  return entry.delay;
+}
+
+int64_t
+GSLChannel::GetDeviceIndex (const Address &address) const
+{
+  Mac48Address address48 = Mac48Address::ConvertFrom (address);
+  if (m_contiguous_macs) {
+    uint64_t offset = Mac48AddressToInteger (address48) - m_first_mac; // Wraps around if it is below
+    return offset < m_net_devices.size () ? (int64_t) offset : -1;
+  }
+  MacToNetDeviceIndexCI it = m_link.find (address48);
+  return it != m_link.end () ? (int64_t) it->second : -1;
 }
 
 bool
-GSLChannel::TransmitTo(Ptr<const Packet> p, Ptr<GSLNetDevice> srcNetDevice, Ptr<GSLNetDevice> destNetDevice, Time txTime, bool isSameSystem) {
+GSLChannel::TransmitTo(Ptr<const Packet> p, Ptr<GSLNetDevice> srcNetDevice, Ptr<GSLNetDevice> destNetDevice, Time txTime, Time delay, bool isSameSystem) {
+  SATNET_PROFILE_SCOPE (GSL_CHANNEL_TRANSMIT);
 
-  // Mobility models for source and destination
-  Ptr<MobilityModel> senderMobility = srcNetDevice->GetNode()->GetObject<MobilityModel>();
   Ptr<Node> receiverNode = destNetDevice->GetNode();
-  Ptr<MobilityModel> receiverMobility = receiverNode->GetObject<MobilityModel>();
-
-  // Calculate delay
-  Time delay = this->GetDelay(senderMobility, receiverMobility);
   NS_LOG_DEBUG(
           "Sending packet " << p << " from node " << srcNetDevice->GetNode()->GetId()
           << " to " << destNetDevice->GetNode()->GetId() << " with delay " << delay
   );
 
-  // Distributed mode is not enabled
-  NS_ABORT_MSG_UNLESS(isSameSystem, "MPI distributed mode is currently not supported by the GSL channel.");
+  if (isSameSystem) {
 
-  // Schedule arrival of packet at destination network device
-  Simulator::ScheduleWithContext(
-          receiverNode->GetId(),
-          txTime + delay,
-          &GSLNetDevice::Receive,
-          destNetDevice,
-          p->Copy ()
-  );
+    // Schedule arrival of packet at destination network device
+    Simulator::ScheduleWithContext(
+            receiverNode->GetId(),
+            txTime + delay,
+            &GSLNetDevice::Receive,
+            destNetDevice,
+            m_zeroCopy ? ConstCast<Packet> (p) : p->Copy ()
+    );
+
+  } else {
 
-  // Re-enabled below code if distributed is again enabled:
-  //  if (isSameSystem) {
-  //
-  //  } else {
-  //#ifdef NS3_MPI
-  //    Time rxTime = Simulator::Now () + txTime + delay;
-  //    MpiInterface::SendPacket (p->Copy (), rxTime, destNetDevice->GetNode()->GetId (), destNetDevice->GetIfIndex());
-  //#else
-  //    NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
-  //#endif
-  //  }
+    // Destination network device is simulated by another system
+#ifdef NS3_MPI
+    Time rxTime = Simulator::Now () + txTime + delay;
+    MpiInterface::SendPacket (p->Copy (), rxTime, receiverNode->GetId (), destNetDevice->GetIfIndex());
+#else
+    NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+
+  }
 
   return true;
 }
@@ -132,13 +217,30 @@ GSLChannel::Attach (Ptr<GSLNetDevice> device)
     NS_ABORT_MSG_IF (device == 0, "Cannot add zero pointer network device.");
 
     Mac48Address address48 = Mac48Address::ConvertFrom (device->GetAddress());
-    m_link[address48] = device;
+    uint64_t mac = Mac48AddressToInteger (address48);
+    if (m_net_devices.empty ()) {
+        m_first_mac = mac;
+    }
+
+    // Once a MAC address breaks the contiguous range, fall back to the map for all
+    if (m_contiguous_macs && mac != m_first_mac + m_net_devices.size ()) {
+        m_contiguous_macs = false;
+        for (size_t i = 0; i < m_net_devices.size (); i++) {
+            m_link[Mac48Address::ConvertFrom (m_net_devices[i]->GetAddress ())] = i;
+        }
+    }
+    if (!m_contiguous_macs) {
+        m_link[address48] = m_net_devices.size ();
+    }
+
     m_net_devices.push_back(device);
+    m_net_device_system_ids.push_back(device->GetNode ()->GetSystemId ());
 }
 
 Time
 GSLChannel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
+  SATNET_PROFILE_SCOPE (GSL_CHANNEL_DELAY);
   double distance_m = a->GetDistanceFrom (b);
   double seconds = distance_m / m_propagationSpeedMetersPerSecond;
   return Seconds (seconds);
@@ -146,18 +248,8 @@ GSLChannel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 
 size_t Mac48AddressHash::operator() (Mac48Address const &x) const
 {
-    uint8_t address[6]; //!< address value
-    x.CopyTo(address);
-
-    uint32_t host = 0;
-    uint8_t byte = 0;
-    for (size_t i = 0; i < 6; i++) {
-        byte = address[i];
-        host <<= 8;
-        host |= byte;
-    }
-
-    return host;
+    // All six bytes (a 32-bit value would drop the two highest)
+    return std::hash<uint64_t> () (Mac48AddressToInteger (x));
 }
 
 std::size_t
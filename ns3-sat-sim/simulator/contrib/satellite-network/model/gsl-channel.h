@@ -53,11 +53,29 @@ public:
           Address dst_address,
           Time txTime
   );
+
+  /**
+   * \brief Start transmitting a packet to an attached network device given by index
+   *
+   * \param p Packet
+   * \param src_idx Index of the source network device (see GetDeviceIndex)
+   * \param dst_idx Index of the destination network device (see GetDeviceIndex)
+   * \param txTime Transmission time of the packet
+   *
+   * \return True iff the transmission was started
+   */
+  bool TransmitStart (
+          Ptr<const Packet> p,
+          uint32_t src_idx,
+          uint32_t dst_idx,
+          Time txTime
+  );
   bool TransmitTo(
           Ptr<const Packet> p,
           Ptr<GSLNetDevice> srcNetDevice,
           Ptr<GSLNetDevice> dstNetDevice,
           Time txTime,
+          Time delay,
           bool isSameSystem
   );
 
@@ -66,22 +84,66 @@ public:
   virtual std::size_t GetNDevices (void) const;
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  /**
+   * \brief Find the index of an attached network device by its MAC address
+   *
+   * \param address MAC address
+   *
+   * \return Index in m_net_devices, or -1 if no network device has this address
+   */
+  int64_t GetDeviceIndex (const Address &address) const;
+
 protected:
   Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
 
-  Time   m_lowerBoundDelay;                   //!< Propagation delay which is
-                                              //   used to give a minimum lookahead time to the
-                                              //   distributed simulator (if it were enabled).
-                                              //   See also: distributed-simulator-impl.cc (line 173 onwards)
+  /**
+   * \brief Get the propagation delay between two attached network devices
+   *
+   * If the delay cache tolerance is set, the delay of a (source, destination) pair
+   * is only calculated once within each quantum of that length, as long as it is
+   * not evicted from the cache by another pair which maps to the same slot.
+   *
+   * \param src_idx Index of the source network device in m_net_devices
+   * \param dst_idx Index of the destination network device in m_net_devices
+   *
+   * \return Propagation delay
+   */
+  Time GetDeviceDelay (uint32_t src_idx, uint32_t dst_idx);
+
+  Time   m_lowerBoundDelay;                   //!< Lower bound of the propagation delay of any GSL, which is
+                                              //   the minimum lookahead time for the distributed simulator.
+                                              //   The simulator itself only considers point-to-point channels,
+                                              //   see also: distributed-simulator-impl.cc (line 173 onwards)
 
   double m_propagationSpeedMetersPerSecond;   //!< Propagation speed on the channel (used to live calculate the delay
                                               //   for each packet which is sent over this channel.
 
-  // Mac address to net device
-  typedef sgi::hash_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash> MacToNetDevice;
-  typedef sgi::hash_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash>::iterator MacToNetDeviceI;
-  MacToNetDevice m_link;
+  bool m_zeroCopy;                            //!< True to move the packet to the receiving network device instead
+                                              //   of scheduling its arrival with a copy
+
+  // Attached network devices and the system id of their node (same index)
   std::vector<Ptr<GSLNetDevice>> m_net_devices;
+  std::vector<uint32_t> m_net_device_system_ids;
+
+  // As long as the i-th attached network device has MAC address (first MAC address + i),
+  // which is the case when installed by the GSLHelper, the MAC address directly maps to the
+  // index of the network device. Only otherwise, the MAC address to index map is used.
+  uint64_t m_first_mac;
+  bool m_contiguous_macs;
+  typedef sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash> MacToNetDeviceIndex;
+  typedef sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash>::const_iterator MacToNetDeviceIndexCI;
+  MacToNetDeviceIndex m_link;
+
+  // Delay cache: direct-mapped on the (source, destination) pair, an entry is valid
+  // within the same quantum of length m_delayCacheTolerance
+  struct DelayCacheEntry {
+    uint64_t pair;
+    int64_t quantum;
+    Time delay;
+  };
+  Time m_delayCacheTolerance;
+  uint32_t m_delayCacheSize;
+  std::vector<DelayCacheEntry> m_delay_cache;
 
 };
 
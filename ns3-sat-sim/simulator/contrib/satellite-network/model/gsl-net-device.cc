@@ -21,8 +21,9 @@
  */
 
 
+#include <algorithm>
 #include "ns3/log.h"
-#include "ns3/queue.h"
+#include "ns3/abort.h"
 #include "ns3/simulator.h"
 #include "ns3/mac48-address.h"
 #include "ns3/llc-snap-header.h"
@@ -30,6 +31,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
+#include "ns3/enum.h"
 #include "ns3/ppp-header.h"
 #include "ns3/node-container.h"
 #include "gsl-net-device.h"
@@ -73,6 +75,13 @@ GSLNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&GSLNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("Framing",
+                   "Framing of the packets on the link (Ppp: a PPP header with the protocol "
+                   "number, None: no header, the protocol is inferred from the IP version)",
+                   EnumValue (FRAMING_PPP),
+                   MakeEnumAccessor (&GSLNetDevice::m_framing),
+                   MakeEnumChecker (FRAMING_PPP, "Ppp",
+                                    FRAMING_NONE, "None"))
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -82,7 +91,21 @@ GSLNetDevice::GetTypeId (void)
                    "A queue to use as the transmit queue in the device.",
                    PointerValue (),
                    MakePointerAccessor (&GSLNetDevice::m_queue),
-                   MakePointerChecker<Queue<Packet> > ())
+                   MakePointerChecker<GSLQueue> ())
+    .AddAttribute ("VoqScheduler",
+                   "Scheduler between per-destination virtual output queues, "
+                   "each of which has the maximum size of the TxQueue "
+                   "(None: a single FIFO TxQueue for all destinations)",
+                   EnumValue (VOQ_NONE),
+                   MakeEnumAccessor (&GSLNetDevice::m_voqScheduler),
+                   MakeEnumChecker (VOQ_NONE, "None",
+                                    VOQ_RR, "RR",
+                                    VOQ_DRR, "DRR"))
+    .AddAttribute ("DrrQuantum",
+                   "Bytes a virtual output queue may send per round of the DRR scheduler",
+                   UintegerValue (1500),
+                   MakeUintegerAccessor (&GSLNetDevice::m_drrQuantum),
+                   MakeUintegerChecker<uint32_t> (1))
 
     //
     // Trace sources at the "top" of the net device, where packets transition
@@ -181,7 +204,12 @@ GSLNetDevice::GetTypeId (void)
 GSLNetDevice::GSLNetDevice () 
   :
     m_txMachineState (READY),
+    m_backgroundUtilization (0.0),
     m_channel (0),
+    m_channelIndex (0),
+    m_voqScheduler (VOQ_NONE),
+    m_drrQuantum (1500),
+    m_activeVoqCredited (false),
     m_linkUp (false),
     m_currentPkt (0)
 {
@@ -197,6 +225,11 @@ void
 GSLNetDevice::AddHeader (Ptr<Packet> p, uint16_t protocolNumber)
 {
   NS_LOG_FUNCTION (this << p << protocolNumber);
+  if (m_framing == FRAMING_NONE)
+    {
+      NS_ABORT_MSG_UNLESS (protocolNumber == 0x0800 || protocolNumber == 0x86DD, "Only IPv4 and IPv6 can be sent without framing");
+      return;
+    }
   PppHeader ppp;
   ppp.SetProtocol (EtherToPpp (protocolNumber));
   p->AddHeader (ppp);
@@ -206,6 +239,11 @@ bool
 GSLNetDevice::ProcessHeader (Ptr<Packet> p, uint16_t& param)
 {
   NS_LOG_FUNCTION (this << p << param);
+  if (m_framing == FRAMING_NONE)
+    {
+      param = IpVersionToEther (p);
+      return true;
+    }
   PppHeader ppp;
   p->RemoveHeader (ppp);
   param = PppToEther (ppp.GetProtocol ());
@@ -221,9 +259,9 @@ GSLNetDevice::DoDispose ()
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
   m_queue = 0;
-  while (!m_queueDests.empty()) {
-      m_queueDests.pop();
-  }
+  m_voqs.clear ();
+  m_voqOfDest.clear ();
+  m_activeVoqs.clear ();
   NetDevice::DoDispose ();
 }
 
@@ -241,10 +279,19 @@ GSLNetDevice::SetInterframeGap (Time t)
   m_tInterframeGap = t;
 }
 
+void
+GSLNetDevice::SetBackgroundLoad (double utilization, Time queueingDelay)
+{
+  NS_LOG_FUNCTION (this << utilization << queueingDelay);
+  NS_ABORT_MSG_IF (utilization < 0 || utilization >= 1, "Background utilization must be in [0, 1)");
+  m_backgroundUtilization = utilization;
+  m_backgroundQueueingDelay = queueingDelay;
+}
+
 bool
-GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
+GSLNetDevice::TransmitStart (Ptr<Packet> p, uint32_t destIndex)
 {
-  NS_LOG_FUNCTION (this << p);
+  NS_LOG_FUNCTION (this << p << destIndex);
   NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
 
   //
@@ -256,14 +303,28 @@ GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
   m_txMachineState = BUSY;
   m_currentPkt = p;
   m_phyTxBeginTrace (m_currentPkt);
+  if (m_utilizationTracker)
+    {
+      m_utilizationTracker->Track (Simulator::Now ().GetNanoSeconds (), true);
+    }
 
   Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
+  Time arrivalTxTime = txTime; // Until the packet has fully arrived, without the propagation delay
+  if (m_backgroundUtilization > 0 || m_backgroundLastArrival > Simulator::Now ())
+    {
+      // Leaves the background queue after its queueing delay, but not before the previous
+      // packet has fully arrived (a smaller packet or a shorter delay does not overtake it)
+      txTime = DataRate ((uint64_t) (m_bps.GetBitRate () * (1.0 - m_backgroundUtilization))).CalculateBytesTxTime (p->GetSize ());
+      Time queueExit = std::max (Simulator::Now () + m_backgroundQueueingDelay, m_backgroundLastArrival);
+      m_backgroundLastArrival = queueExit + txTime;
+      arrivalTxTime = m_backgroundLastArrival - Simulator::Now ();
+    }
   Time txCompleteTime = txTime + m_tInterframeGap;
 
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
-  Simulator::Schedule (txCompleteTime, &GSLNetDevice::TransmitComplete, this, dest);
+  Simulator::Schedule (txCompleteTime, &GSLNetDevice::TransmitComplete, this);
 
-  bool result = m_channel->TransmitStart (p, this, dest, txTime);
+  bool result = m_channel->TransmitStart (p, m_channelIndex, destIndex, arrivalTxTime);
   if (result == false)
     {
       m_phyTxDropTrace (p);
@@ -274,7 +335,7 @@ GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
 }
 
 void
-GSLNetDevice::TransmitComplete (const Address dest)
+GSLNetDevice::TransmitComplete (void)
 {
   NS_LOG_FUNCTION (this);
 
@@ -290,23 +351,99 @@ GSLNetDevice::TransmitComplete (const Address dest)
   NS_ASSERT_MSG (m_currentPkt != 0, "GSLNetDevice::TransmitComplete(): m_currentPkt zero");
 
   m_phyTxEndTrace (m_currentPkt);
+  if (m_utilizationTracker)
+    {
+      m_utilizationTracker->Track (Simulator::Now ().GetNanoSeconds (), false);
+    }
   m_currentPkt = 0;
 
-  Ptr<Packet> p = m_queue->Dequeue ();
+  uint32_t nextDestIndex;
+  Ptr<Packet> p = DequeueNext (nextDestIndex);
   if (p == 0)
     {
       NS_LOG_LOGIC ("No pending packets in device queue after tx complete");
       return;
     }
-    Address next_dest = m_queueDests.front ();
-    m_queueDests.pop ();
 
   //
   // Got another packet off of the queue, so start the transmit process again.
   //
   m_snifferTrace (p);
   m_promiscSnifferTrace (p);
-  TransmitStart (p, next_dest);
+  TransmitStart (p, nextDestIndex);
+}
+
+uint32_t
+GSLNetDevice::GetVoq (uint32_t destIndex)
+{
+  NS_LOG_FUNCTION (this << destIndex);
+  std::unordered_map<uint32_t, uint32_t>::iterator it = m_voqOfDest.find (destIndex);
+  if (it != m_voqOfDest.end ())
+    {
+      return it->second;
+    }
+  Voq voq;
+  voq.queue = CreateObject<GSLQueue> ();
+  voq.queue->SetMaxSize (m_queue->GetMaxSize ());
+  voq.deficit = 0;
+  m_voqs.push_back (voq);
+  m_voqOfDest[destIndex] = m_voqs.size () - 1;
+  return m_voqs.size () - 1;
+}
+
+Ptr<Packet>
+GSLNetDevice::DequeueNext (uint32_t &destIndex)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_voqScheduler == VOQ_NONE)
+    {
+      return m_queue->Dequeue (destIndex);
+    }
+
+  while (!m_activeVoqs.empty ())
+    {
+      uint32_t voqIndex = m_activeVoqs.front ();
+      Ptr<GSLQueue> voq = m_voqs[voqIndex].queue;
+
+      //
+      // Deficit round-robin: the VOQ at the head gets its quantum once per round,
+      // and sends as long as its head packet fits in the deficit.
+      //
+      if (m_voqScheduler == VOQ_DRR)
+        {
+          if (!m_activeVoqCredited)
+            {
+              m_voqs[voqIndex].deficit += m_drrQuantum;
+              m_activeVoqCredited = true;
+            }
+          uint32_t size = voq->Peek ()->GetSize ();
+          if (size > m_voqs[voqIndex].deficit)
+            {
+              m_activeVoqs.pop_front ();
+              m_activeVoqs.push_back (voqIndex);
+              m_activeVoqCredited = false;
+              continue;
+            }
+          m_voqs[voqIndex].deficit -= size;
+        }
+
+      Ptr<Packet> p = voq->Dequeue (destIndex);
+      if (voq->IsEmpty ())
+        {
+          // An emptied VOQ leaves the round (and loses its deficit)
+          m_activeVoqs.pop_front ();
+          m_voqs[voqIndex].deficit = 0;
+          m_activeVoqCredited = false;
+        }
+      else if (m_voqScheduler == VOQ_RR)
+        {
+          // Round-robin: one packet per turn
+          m_activeVoqs.pop_front ();
+          m_activeVoqs.push_back (voqIndex);
+        }
+      return p;
+    }
+  return 0;
 }
 
 bool
@@ -317,6 +454,7 @@ GSLNetDevice::Attach (Ptr<GSLChannel> ch)
   m_channel = ch;
 
   m_channel->Attach (this);
+  m_channelIndex = m_channel->GetNDevices () - 1;
 
   //
   // This device is up whenever it is attached to a channel.  A better plan
@@ -328,7 +466,7 @@ GSLNetDevice::Attach (Ptr<GSLChannel> ch)
 }
 
 void
-GSLNetDevice::SetQueue (Ptr<Queue<Packet> > q)
+GSLNetDevice::SetQueue (Ptr<GSLQueue> q)
 {
   NS_LOG_FUNCTION (this << q);
   m_queue = q;
@@ -368,9 +506,9 @@ GSLNetDevice::Receive (Ptr<Packet> packet)
 
       //
       // Trace sinks will expect complete packets, not packets without some of the
-      // headers.
+      // headers (without framing, no header is removed so no copy is needed).
       //
-      Ptr<Packet> originalPacket = packet->Copy ();
+      Ptr<Packet> originalPacket = m_framing == FRAMING_NONE ? packet : packet->Copy ();
 
       //
       // Strip off the point-to-point protocol header and forward this packet
@@ -395,13 +533,57 @@ GSLNetDevice::Receive (Ptr<Packet> packet)
     }
 }
 
-Ptr<Queue<Packet> >
+Ptr<GSLQueue>
 GSLNetDevice::GetQueue (void) const
 { 
   NS_LOG_FUNCTION (this);
   return m_queue;
 }
 
+uint32_t
+GSLNetDevice::GetQueueNPackets (void) const
+{
+  uint32_t nPackets = m_queue->GetNPackets ();
+  for (uint32_t voqIndex : m_activeVoqs)
+    {
+      nPackets += m_voqs[voqIndex].queue->GetNPackets ();
+    }
+  return nPackets;
+}
+
+uint32_t
+GSLNetDevice::GetQueueNBytes (void) const
+{
+  uint32_t nBytes = m_queue->GetNBytes ();
+  for (uint32_t voqIndex : m_activeVoqs)
+    {
+      nBytes += m_voqs[voqIndex].queue->GetNBytes ();
+    }
+  return nBytes;
+}
+
+void
+GSLNetDevice::EnableUtilizationTracking (int64_t interval_ns, uint32_t quantization_levels)
+{
+  NS_LOG_FUNCTION (this << interval_ns << quantization_levels);
+  m_utilizationTracker.reset (new UtilizationTracker (interval_ns, quantization_levels));
+}
+
+UtilizationTracker&
+GSLNetDevice::GetUtilizationTracker (void)
+{
+  NS_ABORT_MSG_UNLESS (m_utilizationTracker, "Utilization tracking is not enabled");
+  return *m_utilizationTracker;
+}
+
+const std::vector<UtilizationTracker::Segment>&
+GSLNetDevice::FinalizeUtilization (void)
+{
+  UtilizationTracker& tracker = GetUtilizationTracker ();
+  tracker.Finalize (Simulator::Now ().GetNanoSeconds ());
+  return tracker.GetCompletedSegments ();
+}
+
 void
 GSLNetDevice::NotifyLinkUp (void)
 {
@@ -526,6 +708,13 @@ GSLNetDevice::Send (
       return false;
     }
 
+  //
+  // Resolve the destination network device once, such that the queue and
+  // the channel only have to deal with its index.
+  //
+  int64_t destIndex = m_channel->GetDeviceIndex (dest);
+  NS_ABORT_MSG_IF (destIndex < 0, "MAC address could not be mapped to a network device.");
+
   //
   // Stick a point to point protocol header on the packet in preparation for
   // shoving it out the door.
@@ -537,20 +726,35 @@ GSLNetDevice::Send (
   //
   // We should enqueue and dequeue the packet to hit the tracing hooks.
   //
-  if (m_queue->Enqueue (packet))
+  bool enqueued;
+  if (m_voqScheduler == VOQ_NONE)
+    {
+      enqueued = m_queue->Enqueue (packet, (uint32_t) destIndex);
+    }
+  else
+    {
+      uint32_t voqIndex = GetVoq ((uint32_t) destIndex);
+      Ptr<GSLQueue> voq = m_voqs[voqIndex].queue;
+      bool wasEmpty = voq->IsEmpty ();
+      enqueued = voq->Enqueue (packet, (uint32_t) destIndex);
+      if (enqueued && wasEmpty)
+        {
+          m_voqs[voqIndex].deficit = 0;
+          m_activeVoqs.push_back (voqIndex);
+        }
+    }
+  if (enqueued)
     {
-        m_queueDests.push (dest);
       //
       // If the channel is ready for transition we send the packet right now
       // 
       if (m_txMachineState == READY)
         {
-          packet = m_queue->Dequeue ();
-          Address next_dest = m_queueDests.front ();
-          m_queueDests.pop ();
+          uint32_t nextDestIndex;
+          packet = DequeueNext (nextDestIndex);
           m_snifferTrace (packet);
           m_promiscSnifferTrace (packet);
-          bool ret = TransmitStart (packet, next_dest);
+          bool ret = TransmitStart (packet, nextDestIndex);
           return ret;
         }
       return true;
@@ -659,5 +863,20 @@ GSLNetDevice::EtherToPpp (uint16_t proto)
   return 0;
 }
 
+uint16_t
+GSLNetDevice::IpVersionToEther (Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  uint8_t firstByte = 0;
+  p->CopyData (&firstByte, 1);
+  switch(firstByte >> 4)
+    {
+    case 4: return 0x0800;   //IPv4
+    case 6: return 0x86DD;   //IPv6
+    default: NS_ABORT_MSG ("Unframed packet is neither IPv4 nor IPv6!");
+    }
+  return 0;
+}
+
 
 } // namespace ns3
@@ -24,7 +24,10 @@
 #define GSL_NET_DEVICE_H
 
 #include <cstring>
-#include <queue>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <memory>
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "ns3/net-device.h"
@@ -36,10 +39,11 @@
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
 #include "ns3/node-container.h"
+#include "ns3/gsl-queue.h"
+#include "ns3/utilization-tracker.h"
 
 namespace ns3 {
 
-template <typename Item> class Queue;
 class GSLChannel;
 class ErrorModel;
 
@@ -65,6 +69,25 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * Scheduler between the per-destination virtual output queues (VOQs).
+   */
+  enum VoqScheduler
+  {
+    VOQ_NONE,  /**< No VOQs: a single FIFO queue for all destinations */
+    VOQ_RR,    /**< A VOQ per destination, served packet-by-packet round-robin */
+    VOQ_DRR    /**< A VOQ per destination, served deficit round-robin (byte fair) */
+  };
+
+  /**
+   * Framing of the packets on the link.
+   */
+  enum Framing
+  {
+    FRAMING_PPP,   /**< A PPP header which carries the protocol number */
+    FRAMING_NONE   /**< No header: the receiver infers IPv4/IPv6 from the IP version field */
+  };
+
   /**
    * Construct a GSLNetDevice
    *
@@ -96,6 +119,16 @@ public:
    */
   void SetInterframeGap (Time t);
 
+  /**
+   * Set the load of background traffic which is not simulated as packets (e.g., fluid
+   * flows). Packets are sent at the data rate it leaves, and wait the queueing delay
+   * behind it before they arrive (in addition to the propagation delay).
+   *
+   * \param utilization Fraction of the data rate used by the background traffic, in [0, 1)
+   * \param queueingDelay Queueing delay behind the background traffic
+   */
+  void SetBackgroundLoad (double utilization, Time queueingDelay);
+
   /**
    * Attach the device to a channel.
    *
@@ -107,19 +140,51 @@ public:
   /**
    * Attach a queue to the GSLNetDevice.
    *
-   * The GSLtNetDevice "owns" a queue that implements a queueing 
-   * method such as DropTailQueue or RedQueue
+   * The GSLNetDevice "owns" a GSLQueue, which holds each packet
+   * together with the channel index of its destination network device.
+   * If virtual output queues are enabled, this queue is not used
+   * itself, but each VOQ gets the same maximum size.
    *
    * \param queue Ptr to the new queue.
    */
-  void SetQueue (Ptr<Queue<Packet> > queue);
+  void SetQueue (Ptr<GSLQueue> queue);
 
   /**
    * Get a copy of the attached Queue.
    *
    * \returns Ptr to the queue.
    */
-  Ptr<Queue<Packet> > GetQueue (void) const;
+  Ptr<GSLQueue> GetQueue (void) const;
+
+  /**
+   * \returns Number of packets waiting for transmission (in all virtual output queues)
+   */
+  uint32_t GetQueueNPackets (void) const;
+
+  /**
+   * \returns Number of bytes waiting for transmission (in all virtual output queues)
+   */
+  uint32_t GetQueueNBytes (void) const;
+
+  /**
+   * Track the fraction of time the transmitter is busy in intervals.
+   *
+   * \param interval_ns Length of an interval
+   * \param quantization_levels Number of levels the utilization is rounded to (0: not rounded)
+   */
+  void EnableUtilizationTracking (int64_t interval_ns, uint32_t quantization_levels);
+
+  /**
+   * \returns Utilization tracker (utilization tracking must be enabled)
+   */
+  UtilizationTracker& GetUtilizationTracker (void);
+
+  /**
+   * Account for the time until now and close all segments.
+   *
+   * \returns Utilization segments which have not been cleared yet
+   */
+  const std::vector<UtilizationTracker::Segment>& FinalizeUtilization (void);
 
   /**
    * Attach a receive ErrorModel to the GSLNetDevice.
@@ -251,10 +316,10 @@ private:
    * \see GSLChannel::TransmitStart ()
    * \see TransmitComplete()
    * \param p a reference to the packet to send
-   * \param address where the packet is to be sent
+   * \param destIndex channel index of the network device the packet is sent to
    * \returns true if success, false on failure
    */
-  bool TransmitStart (Ptr<Packet> p, const Address address);
+  bool TransmitStart (Ptr<Packet> p, uint32_t destIndex);
 
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
@@ -262,7 +327,23 @@ private:
    * The TransmitComplete method is used internally to finish the process
    * of sending a packet out on the channel.
    */
-  void TransmitComplete (const Address destination);
+  void TransmitComplete (void);
+
+  /**
+   * \brief Get the virtual output queue of a destination, creating it if needed
+   *
+   * \param destIndex channel index of the destination network device
+   * \return Position of the virtual output queue in m_voqs
+   */
+  uint32_t GetVoq (uint32_t destIndex);
+
+  /**
+   * \brief Dequeue the next packet to transmit according to the VOQ scheduler
+   *
+   * \param destIndex set to the channel index of the destination of the packet
+   * \return Packet, or zero if all queues are empty
+   */
+  Ptr<Packet> DequeueNext (uint32_t &destIndex);
 
   /**
    * \brief Make the link up and running
@@ -296,6 +377,14 @@ private:
    */
   Time           m_tInterframeGap;
 
+  /**
+   * Background traffic (see SetBackgroundLoad ()), and when the last packet sent behind
+   * it has fully arrived (packets are not reordered)
+   */
+  double         m_backgroundUtilization;
+  Time           m_backgroundQueueingDelay;
+  Time           m_backgroundLastArrival;
+
   /**
    * The GSLChannel to which this GSLNetDevice has been
    * attached.
@@ -303,17 +392,48 @@ private:
   Ptr<GSLChannel> m_channel;
 
   /**
-   * The Queue which this GSLNetDevice uses as a packet source.
+   * Index of this GSLNetDevice in the GSLChannel it is attached to.
+   */
+  uint32_t m_channelIndex;
+
+  /**
+   * The Queue which this GSLNetDevice uses as a packet source, each
+   * packet stored together with the channel index of its destination.
    * Management of this Queue has been delegated to the GSLNetDevice
    * and it has the responsibility for deletion.
-   * \see class DropTailQueue
+   * \see class GSLQueue
+   */
+  Ptr<GSLQueue> m_queue;
+
+  /**
+   * Scheduler between the virtual output queues (VOQ_NONE: only m_queue is used).
    */
-  Ptr<Queue<Packet> > m_queue;
+  VoqScheduler m_voqScheduler;
 
-    /**
-     * The FIFO queue for the destination MAC addresses
-     */
-  std::queue<Address> m_queueDests;
+  /**
+   * Number of bytes added to the deficit of a virtual output queue in each
+   * round of the deficit round-robin scheduler.
+   */
+  uint32_t m_drrQuantum;
+
+  /**
+   * Virtual output queue of a destination. Only destinations which were sent to have one
+   * (a device typically talks to a few of all the devices on the shared channel).
+   */
+  struct Voq
+  {
+    Ptr<GSLQueue> queue;
+    uint32_t deficit;                    //!< Deficit (bytes) in the current round
+  };
+  std::vector<Voq> m_voqs;
+  std::unordered_map<uint32_t, uint32_t> m_voqOfDest; //!< Channel index of the destination -> position in m_voqs
+  std::deque<uint32_t> m_activeVoqs;     //!< Non-empty virtual output queues (positions in m_voqs) in round-robin order
+  bool m_activeVoqCredited;              //!< Whether the head of m_activeVoqs got its quantum this round
+
+  /**
+   * Utilization tracker, only set if utilization tracking is enabled.
+   */
+  std::unique_ptr<UtilizationTracker> m_utilizationTracker;
 
   /**
    * Error model for receive packet events
@@ -449,6 +569,14 @@ private:
    */
   uint32_t m_mtu;
 
+  /**
+   * \brief Framing of the packets on the link
+   *
+   * With FRAMING_NONE no header is added nor removed on every hop, which
+   * also means the transmitted frame is two bytes shorter.
+   */
+  Framing m_framing;
+
   Ptr<Packet> m_currentPkt; //!< Current packet processed
 
   /**
@@ -464,6 +592,13 @@ private:
    * \return The corresponding PPP protocol number
    */
   static uint16_t EtherToPpp (uint16_t protocol);
+
+  /**
+   * \brief Ethernet protocol number of an unframed IP packet
+   * \param p A packet which starts with an IPv4 or IPv6 header
+   * \return The corresponding Ethernet protocol number
+   */
+  static uint16_t IpVersionToEther (Ptr<const Packet> p);
 };
 
 } // namespace ns3
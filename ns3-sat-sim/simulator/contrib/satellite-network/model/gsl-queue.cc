@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon        2020
+ */
+
+#include "gsl-queue.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/trace-source-accessor.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("GSLQueue");
+
+NS_OBJECT_ENSURE_REGISTERED (GSLQueue);
+
+TypeId
+GSLQueue::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::GSLQueue")
+    .SetParent<Object> ()
+    .SetGroupName ("GSL")
+    .AddConstructor<GSLQueue> ()
+    .AddAttribute ("MaxSize",
+                   "The max queue size (only in packets)",
+                   QueueSizeValue (QueueSize ("100p")),
+                   MakeQueueSizeAccessor (&GSLQueue::SetMaxSize,
+                                          &GSLQueue::GetMaxSize),
+                   MakeQueueSizeChecker ())
+    .AddTraceSource ("Enqueue", "Enqueue a packet in the queue.",
+                     MakeTraceSourceAccessor (&GSLQueue::m_traceEnqueue),
+                     "ns3::Packet::TracedCallback")
+    .AddTraceSource ("Dequeue", "Dequeue a packet from the queue.",
+                     MakeTraceSourceAccessor (&GSLQueue::m_traceDequeue),
+                     "ns3::Packet::TracedCallback")
+    .AddTraceSource ("Drop", "Drop a packet because the queue is full.",
+                     MakeTraceSourceAccessor (&GSLQueue::m_traceDrop),
+                     "ns3::Packet::TracedCallback")
+  ;
+  return tid;
+}
+
+GSLQueue::GSLQueue ()
+  :
+    m_head (0),
+    m_nPackets (0),
+    m_nBytes (0),
+    m_nTotalDroppedPackets (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+GSLQueue::~GSLQueue ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+GSLQueue::SetMaxSize (QueueSize size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ABORT_MSG_UNLESS (size.GetUnit () == QueueSizeUnit::PACKETS, "GSL queue maximum size must be in packets.");
+  NS_ABORT_MSG_IF (size.GetValue () == 0, "GSL queue maximum size must be at least one packet.");
+  NS_ABORT_MSG_IF (m_nPackets > 0, "GSL queue maximum size cannot be changed while it holds packets.");
+  m_maxSize = size;
+  m_ring.clear ();
+  m_ring.resize (size.GetValue ());
+  m_head = 0;
+}
+
+QueueSize
+GSLQueue::GetMaxSize (void) const
+{
+  return m_maxSize;
+}
+
+bool
+GSLQueue::Enqueue (Ptr<Packet> p, uint32_t destIndex)
+{
+  NS_LOG_FUNCTION (this << p << destIndex);
+  if (m_nPackets == m_ring.size ())
+    {
+      NS_LOG_LOGIC ("Queue full -- dropping pkt");
+      m_nTotalDroppedPackets++;
+      m_traceDrop (p);
+      return false;
+    }
+  uint32_t tail = m_head + m_nPackets;
+  if (tail >= m_ring.size ())
+    {
+      tail -= m_ring.size ();
+    }
+  m_ring[tail].packet = p;
+  m_ring[tail].destIndex = destIndex;
+  m_nPackets++;
+  m_nBytes += p->GetSize ();
+  m_traceEnqueue (p);
+  return true;
+}
+
+Ptr<Packet>
+GSLQueue::Dequeue (uint32_t &destIndex)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_nPackets == 0)
+    {
+      NS_LOG_LOGIC ("Queue empty");
+      return 0;
+    }
+  Entry &entry = m_ring[m_head];
+  Ptr<Packet> p = entry.packet;
+  destIndex = entry.destIndex;
+  entry.packet = 0;
+  m_head++;
+  if (m_head == m_ring.size ())
+    {
+      m_head = 0;
+    }
+  m_nPackets--;
+  m_nBytes -= p->GetSize ();
+  m_traceDequeue (p);
+  return p;
+}
+
+Ptr<const Packet>
+GSLQueue::Peek (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_nPackets == 0)
+    {
+      return 0;
+    }
+  return m_ring[m_head].packet;
+}
+
+bool
+GSLQueue::IsEmpty (void) const
+{
+  return m_nPackets == 0;
+}
+
+uint32_t
+GSLQueue::GetNPackets (void) const
+{
+  return m_nPackets;
+}
+
+uint32_t
+GSLQueue::GetNBytes (void) const
+{
+  return m_nBytes;
+}
+
+uint32_t
+GSLQueue::GetTotalDroppedPackets (void) const
+{
+  return m_nTotalDroppedPackets;
+}
+
+void
+GSLQueue::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ring.clear ();
+  m_head = 0;
+  m_nPackets = 0;
+  m_nBytes = 0;
+  Object::DoDispose ();
+}
+
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon        2020
+ */
+
+#ifndef GSL_QUEUE_H
+#define GSL_QUEUE_H
+
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/packet.h"
+#include "ns3/queue-size.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+
+/**
+ * \brief Drop-tail transmit queue of a GSL network device
+ *
+ * Each packet is stored together with the index of its destination network
+ * device on the GSL channel, such that the two can never go out of sync.
+ * The entries are kept in a ring buffer which is allocated once when the
+ * maximum size is set, so enqueueing and dequeueing do not allocate memory.
+ */
+class GSLQueue : public Object
+{
+public:
+  /**
+   * \brief Get the TypeId
+   *
+   * \return The TypeId for this class
+   */
+  static TypeId GetTypeId (void);
+
+  GSLQueue ();
+  virtual ~GSLQueue ();
+
+  /**
+   * \brief Set the maximum size, which allocates the ring buffer (it must be empty)
+   *
+   * \param size Maximum size, only a number of packets is supported
+   */
+  void SetMaxSize (QueueSize size);
+
+  /**
+   * \return Maximum size
+   */
+  QueueSize GetMaxSize (void) const;
+
+  /**
+   * \brief Add a packet at the tail, or drop it if the queue is full
+   *
+   * \param p Packet
+   * \param destIndex Index of the destination network device on the GSL channel
+   *
+   * \return True iff the packet was enqueued
+   */
+  bool Enqueue (Ptr<Packet> p, uint32_t destIndex);
+
+  /**
+   * \brief Remove the packet at the head
+   *
+   * \param destIndex Set to the index of the destination network device of the packet
+   *
+   * \return Packet, or zero if the queue is empty
+   */
+  Ptr<Packet> Dequeue (uint32_t &destIndex);
+
+  /**
+   * \return Packet at the head (without removing it), or zero if the queue is empty
+   */
+  Ptr<const Packet> Peek (void) const;
+
+  /**
+   * \return True iff there are no packets in the queue
+   */
+  bool IsEmpty (void) const;
+
+  /**
+   * \return Number of packets in the queue
+   */
+  uint32_t GetNPackets (void) const;
+
+  /**
+   * \return Number of bytes in the queue
+   */
+  uint32_t GetNBytes (void) const;
+
+  /**
+   * \return Number of packets dropped because the queue was full
+   */
+  uint32_t GetTotalDroppedPackets (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Packet with its destination
+   */
+  struct Entry
+  {
+    Ptr<Packet> packet;
+    uint32_t destIndex;
+  };
+
+  std::vector<Entry> m_ring;          //!< Ring buffer (capacity is the maximum size)
+  uint32_t m_head;                    //!< Index of the head in the ring buffer
+  uint32_t m_nPackets;                //!< Number of packets in the queue
+  uint32_t m_nBytes;                  //!< Number of bytes in the queue
+  uint32_t m_nTotalDroppedPackets;    //!< Number of packets dropped
+  QueueSize m_maxSize;                //!< Maximum size
+
+  TracedCallback<Ptr<const Packet> > m_traceEnqueue;  //!< Packet enqueued
+  TracedCallback<Ptr<const Packet> > m_traceDequeue;  //!< Packet dequeued
+  TracedCallback<Ptr<const Packet> > m_traceDrop;     //!< Packet dropped
+};
+
+} // namespace ns3
+
+#endif /* GSL_QUEUE_H */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "node-interface-table.h"
+
+namespace ns3 {
+
+NodeInterfaceTable::NodeInterfaceTable(NodeContainer nodes) {
+    m_if_start.push_back(0);
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        Ptr<Ipv4L3Protocol> ipv4 = nodes.Get(i)->GetObject<Ipv4L3Protocol>();
+        NS_ABORT_MSG_IF(ipv4 == 0, "Node " << i << " does not have an IPv4 stack");
+        m_ipv4.push_back(PeekPointer(ipv4));
+        for (uint32_t j = 0; j < ipv4->GetNInterfaces(); j++) {
+            Ptr<NetDevice> device = ipv4->GetNetDevice(j);
+            m_devices.push_back(PeekPointer(device));
+            m_gsl_devices.push_back(PeekPointer(device->GetObject<GSLNetDevice>()));
+            m_isl_devices.push_back(PeekPointer(device->GetObject<PointToPointLaserNetDevice>()));
+            m_local_addresses.push_back(ipv4->GetNAddresses(j) > 0 ? ipv4->GetAddress(j, 0).GetLocal().Get() : 0);
+        }
+        m_if_start.push_back(m_devices.size());
+    }
+}
+
+}
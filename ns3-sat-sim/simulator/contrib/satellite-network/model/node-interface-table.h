@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef NODE_INTERFACE_TABLE_H
+#define NODE_INTERFACE_TABLE_H
+
+#include <cstdint>
+#include <vector>
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/point-to-point-laser-net-device.h"
+
+namespace ns3 {
+
+/**
+ * Lookup tables of the IPv4 stack and interfaces of every node, so that the forwarding and
+ * bandwidth updates (and the arbiters) do not have to go through NodeContainer::Get() and a
+ * chain of GetObject() calls, each of which walks the aggregate of the object.
+ *
+ * The interfaces of all nodes are stored contiguously (including the loop-back interface 0),
+ * node i having the entries [m_if_start[i], m_if_start[i + 1]). The node id is the index of
+ * the node in the container it was built from.
+ *
+ * The table is a snapshot: it must be built after all network devices have been added and
+ * their IPv4 addresses assigned. The raw pointers remain valid as long as the nodes exist.
+ */
+class NodeInterfaceTable : public SimpleRefCount<NodeInterfaceTable>
+{
+public:
+
+    NodeInterfaceTable(NodeContainer nodes);
+
+    uint32_t GetNNodes() const {
+        return m_ipv4.size();
+    }
+
+    Ipv4L3Protocol* GetIpv4(uint32_t node_id) const {
+        NS_ASSERT(node_id < m_ipv4.size());
+        return m_ipv4[node_id];
+    }
+
+    uint32_t GetNInterfaces(uint32_t node_id) const {
+        NS_ASSERT(node_id < m_ipv4.size());
+        return m_if_start[node_id + 1] - m_if_start[node_id];
+    }
+
+    NetDevice* GetNetDevice(uint32_t node_id, uint32_t if_id) const {
+        return m_devices[GetEntry(node_id, if_id)];
+    }
+
+    // Null if the device of the interface is not a GSL network device
+    GSLNetDevice* GetGslNetDevice(uint32_t node_id, uint32_t if_id) const {
+        return m_gsl_devices[GetEntry(node_id, if_id)];
+    }
+
+    // Null if the device of the interface is not an ISL network device
+    PointToPointLaserNetDevice* GetIslNetDevice(uint32_t node_id, uint32_t if_id) const {
+        return m_isl_devices[GetEntry(node_id, if_id)];
+    }
+
+    // First IPv4 address of the interface (0.0.0.0 if it has none)
+    Ipv4Address GetLocalAddress(uint32_t node_id, uint32_t if_id) const {
+        return Ipv4Address(m_local_addresses[GetEntry(node_id, if_id)]);
+    }
+
+    // Position of the interface among the interfaces of all nodes, in [0, GetNEntries())
+    size_t GetEntry(uint32_t node_id, uint32_t if_id) const {
+        NS_ASSERT(if_id < GetNInterfaces(node_id));
+        return m_if_start[node_id] + if_id;
+    }
+
+    size_t GetNEntries() const {
+        return m_devices.size();
+    }
+
+private:
+
+    std::vector<Ipv4L3Protocol*> m_ipv4;                        // Per node
+    std::vector<uint32_t> m_if_start;                           // Per node (+1), first entry of its interfaces
+    std::vector<NetDevice*> m_devices;                          // Per interface
+    std::vector<GSLNetDevice*> m_gsl_devices;                   // Per interface
+    std::vector<PointToPointLaserNetDevice*> m_isl_devices;     // Per interface
+    std::vector<uint32_t> m_local_addresses;                    // Per interface
+
+};
+
+}
+
+#endif //NODE_INTERFACE_TABLE_H
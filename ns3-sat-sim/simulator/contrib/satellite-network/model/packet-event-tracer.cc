@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "packet-event-tracer.h"
+#include <chrono>
+#include <cstring>
+#include <cinttypes>
+#include <algorithm>
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+    static const char PACKET_EVENT_TRACER_MAGIC[8] = {'S', 'A', 'T', 'N', 'E', 'T', 'P', 'T'};
+
+    PacketEventTracer::PacketEventTracer(size_t capacity) {
+        NS_ABORT_MSG_IF(capacity == 0, "Packet event tracer capacity must be positive");
+        size_t power_of_two = 1;
+        while (power_of_two < capacity) {
+            power_of_two <<= 1;
+        }
+        m_ring.resize(power_of_two);
+        m_mask = power_of_two - 1;
+        m_head.store(0);
+        m_tail.store(0);
+        m_stop.store(false);
+        m_file = nullptr;
+        m_started = false;
+        m_num_full_waits = 0;
+    }
+
+    PacketEventTracer::~PacketEventTracer() {
+        Close();
+    }
+
+    void PacketEventTracer::Start(const std::string& filename) {
+        NS_ABORT_MSG_IF(m_started, "Packet event tracer writer is already started");
+        m_file = fopen(filename.c_str(), "wb");
+        NS_ABORT_MSG_IF(m_file == nullptr, "Could not open " << filename);
+        fwrite(PACKET_EVENT_TRACER_MAGIC, sizeof(char), 8, m_file);
+        m_started = true;
+        m_writer = std::thread(&PacketEventTracer::RunWriter, this);
+    }
+
+    void PacketEventTracer::Close() {
+        if (m_started) {
+            m_stop.store(true, std::memory_order_release);
+            m_writer.join();
+            fclose(m_file);
+            m_file = nullptr;
+            m_started = false;
+        }
+    }
+
+    void PacketEventTracer::RunWriter() {
+        while (true) {
+            uint64_t tail = m_tail.load(std::memory_order_relaxed);
+            uint64_t head = m_head.load(std::memory_order_acquire);
+            if (head == tail) {
+
+                // Only stop once everything up to the stop request has been written
+                if (m_stop.load(std::memory_order_acquire)) {
+                    if (m_head.load(std::memory_order_acquire) == tail) {
+                        break;
+                    }
+                    continue;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+
+            }
+
+            // Write the contiguous part up to the end of the ring buffer
+            size_t from = tail & m_mask;
+            size_t num = std::min((size_t) (head - tail), m_ring.size() - from);
+            fwrite(&m_ring[from], sizeof(struct Record), num, m_file);
+            m_tail.store(tail + num, std::memory_order_release);
+        }
+        fflush(m_file);
+    }
+
+    void PacketEventTracer::Add(uint32_t node_id, uint32_t if_id, EventType event_type, Ptr<const Packet> packet) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+            NS_ABORT_MSG_UNLESS(m_started, "Packet event tracer ring buffer is full before the writer is started");
+            m_num_full_waits++;
+            while (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+                std::this_thread::yield();
+            }
+        }
+        struct Record& record = m_ring[head & m_mask];
+        record.time_ns = Simulator::Now().GetNanoSeconds();
+        record.packet_uid = packet->GetUid();
+        record.node_id = node_id;
+        record.if_id = if_id;
+        record.size_byte = packet->GetSize();
+        record.event_type = event_type;
+        record.reserved = 0;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    void PacketEventTracer::TraceMacTx(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet) {
+        tracer->Add(node_id, if_id, MAC_TX, packet);
+    }
+
+    void PacketEventTracer::TraceMacTxDrop(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet) {
+        tracer->Add(node_id, if_id, MAC_TX_DROP, packet);
+    }
+
+    void PacketEventTracer::TracePhyTxBegin(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet) {
+        tracer->Add(node_id, if_id, PHY_TX_BEGIN, packet);
+    }
+
+    void PacketEventTracer::TracePhyRxEnd(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet) {
+        tracer->Add(node_id, if_id, PHY_RX_END, packet);
+    }
+
+    uint64_t PacketEventTracer::GetNumRecords() const {
+        return m_head.load(std::memory_order_relaxed);
+    }
+
+    uint64_t PacketEventTracer::GetNumFullWaits() const {
+        return m_num_full_waits;
+    }
+
+    std::string PacketEventTracer::EventTypeToString(uint16_t event_type) {
+        switch (event_type) {
+            case MAC_TX: return "MacTx";
+            case MAC_TX_DROP: return "MacTxDrop";
+            case PHY_TX_BEGIN: return "PhyTxBegin";
+            case PHY_RX_END: return "PhyRxEnd";
+            default: throw std::runtime_error(format_string("Unknown packet event type: %u", event_type));
+        }
+    }
+
+    uint64_t PacketEventTracer::DecodeToCsv(const std::string& filename_bin, const std::string& filename_csv) {
+
+        // Binary file with its magic
+        FILE* file_bin = fopen(filename_bin.c_str(), "rb");
+        if (file_bin == nullptr) {
+            throw std::runtime_error(format_string("File %s could not be read.", filename_bin.c_str()));
+        }
+        char magic[8];
+        if (fread(magic, sizeof(char), 8, file_bin) != 8 || memcmp(magic, PACKET_EVENT_TRACER_MAGIC, 8) != 0) {
+            fclose(file_bin);
+            throw std::runtime_error(format_string("File %s is not a packet event trace.", filename_bin.c_str()));
+        }
+
+        // Every record becomes a line
+        FILE* file_csv = fopen(filename_csv.c_str(), "w+");
+        if (file_csv == nullptr) {
+            fclose(file_bin);
+            throw std::runtime_error(format_string("File %s could not be written.", filename_csv.c_str()));
+        }
+        uint64_t num_records = 0;
+        std::vector<struct Record> chunk(65536);
+        size_t num;
+        while ((num = fread(chunk.data(), sizeof(struct Record), chunk.size(), file_bin)) > 0) {
+            for (size_t i = 0; i < num; i++) {
+                const struct Record& record = chunk[i];
+                fprintf(file_csv,
+                        "%" PRId64 ",%u,%u,%" PRIu64 ",%u,%s\n",
+                        record.time_ns,
+                        record.node_id,
+                        record.if_id,
+                        record.packet_uid,
+                        record.size_byte,
+                        EventTypeToString(record.event_type).c_str()
+                );
+            }
+            num_records += num;
+        }
+        fclose(file_bin);
+        fclose(file_csv);
+        return num_records;
+
+    }
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef PACKET_EVENT_TRACER_H
+#define PACKET_EVENT_TRACER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+
+namespace ns3 {
+
+/**
+ * Records per-hop packet events of network devices as fixed-size binary records.
+ *
+ * The simulation thread writes each record into a preallocated single-producer
+ * single-consumer ring buffer, without locking nor allocating. A background writer thread
+ * drains the ring buffer into a binary file, which DecodeToCsv() converts into CSV offline.
+ *
+ * Records can be added before the writer is started (e.g., before a forked process knows its
+ * output directory), as long as they fit in the ring buffer. If the ring buffer is full, the
+ * simulation thread waits for the writer, so no record is ever lost.
+ *
+ * File format: the 8-byte magic "SATNETPT", followed by the records.
+ */
+class PacketEventTracer
+{
+public:
+
+    enum EventType : uint16_t {
+        MAC_TX = 0,       // Arrived at the device for transmission
+        MAC_TX_DROP = 1,  // Dropped by the device before transmission (e.g., full queue)
+        PHY_TX_BEGIN = 2, // Started transmission on the channel
+        PHY_RX_END = 3    // Completely received from the channel
+    };
+
+    // 32 bytes on disk
+    struct Record {
+        int64_t time_ns;
+        uint64_t packet_uid;
+        uint32_t node_id;
+        uint32_t if_id;
+        uint32_t size_byte;
+        uint16_t event_type;
+        uint16_t reserved;
+    };
+
+    // Capacity is rounded up to a power of two
+    PacketEventTracer(size_t capacity);
+    ~PacketEventTracer();
+
+    // Writer thread
+    void Start(const std::string& filename);
+    void Close();
+
+    // Called from the simulation thread
+    void Add(uint32_t node_id, uint32_t if_id, EventType event_type, Ptr<const Packet> packet);
+
+    // Callbacks which can be bound to the trace sources of a network device
+    static void TraceMacTx(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet);
+    static void TraceMacTxDrop(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet);
+    static void TracePhyTxBegin(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet);
+    static void TracePhyRxEnd(PacketEventTracer* tracer, uint32_t node_id, uint32_t if_id, Ptr<const Packet> packet);
+
+    // Statistics
+    uint64_t GetNumRecords() const;
+    uint64_t GetNumFullWaits() const;
+
+    // Offline conversion of a binary file into CSV:
+    // <time (ns)>,<node id>,<interface id>,<packet uid>,<size (byte)>,<event type>
+    static uint64_t DecodeToCsv(const std::string& filename_bin, const std::string& filename_csv);
+    static std::string EventTypeToString(uint16_t event_type);
+
+private:
+    void RunWriter();
+
+    std::vector<struct Record> m_ring;
+    uint64_t m_mask;
+
+    // Head is only written by the simulation thread, tail only by the writer thread
+    // (each on its own cache line)
+    alignas(64) std::atomic<uint64_t> m_head;
+    alignas(64) std::atomic<uint64_t> m_tail;
+    alignas(64) std::atomic<bool> m_stop;
+
+    FILE* m_file;
+    std::thread m_writer;
+    bool m_started;
+    uint64_t m_num_full_waits;
+};
+
+}
+
+#endif //PACKET_EVENT_TRACER_H
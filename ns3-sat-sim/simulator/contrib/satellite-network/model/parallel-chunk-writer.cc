@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "parallel-chunk-writer.h"
+#include <cstdarg>
+#include <thread>
+#include <algorithm>
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+    // Chunks formatted by each thread before the buffers are written out
+    static const size_t CHUNKS_PER_THREAD_PER_WINDOW = 64;
+
+    ParallelChunkWriter::ParallelChunkWriter(uint32_t num_threads) {
+        m_num_threads = num_threads != 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+        m_buffers.resize(m_num_threads);
+    }
+
+    uint64_t ParallelChunkWriter::Write(FILE* file, size_t num_chunks, const FormatFunction& format) {
+        uint64_t num_bytes = 0;
+        size_t window_size = m_num_threads * CHUNKS_PER_THREAD_PER_WINDOW;
+        for (size_t window_start = 0; window_start < num_chunks; window_start += window_size) {
+            size_t window_end = std::min(num_chunks, window_start + window_size);
+
+            // Each thread formats a contiguous range of the window into its own buffer
+            size_t per_thread = (window_end - window_start + m_num_threads - 1) / m_num_threads;
+            auto format_range = [&](uint32_t t) {
+                std::string& buffer = m_buffers[t];
+                buffer.clear();
+                size_t from = std::min(window_end, window_start + t * per_thread);
+                size_t to = std::min(window_end, from + per_thread);
+                for (size_t i = from; i < to; i++) {
+                    format(i, buffer);
+                }
+            };
+            if (m_num_threads == 1) {
+                format_range(0);
+            } else {
+                std::vector<std::thread> threads;
+                for (uint32_t t = 0; t < m_num_threads; t++) {
+                    threads.emplace_back(format_range, t);
+                }
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            // Write the buffers in order
+            for (const std::string& buffer : m_buffers) {
+                NS_ABORT_MSG_IF(fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size(), "Could not write chunk buffer");
+                num_bytes += buffer.size();
+            }
+
+        }
+        return num_bytes;
+    }
+
+    uint32_t ParallelChunkWriter::GetNumThreads() const {
+        return m_num_threads;
+    }
+
+    void ParallelChunkWriter::AppendFormat(std::string& buffer, const char* format, ...) {
+        size_t offset = buffer.size();
+        size_t available = 128;
+        buffer.resize(offset + available);
+        va_list args;
+        va_start(args, format);
+        int num = vsnprintf(&buffer[offset], available, format, args);
+        va_end(args);
+        NS_ABORT_MSG_IF(num < 0, "Formatting failed");
+        if ((size_t) num >= available) {
+            buffer.resize(offset + num + 1);
+            va_start(args, format);
+            vsnprintf(&buffer[offset], num + 1, format, args);
+            va_end(args);
+        }
+        buffer.resize(offset + num);
+    }
+
+}
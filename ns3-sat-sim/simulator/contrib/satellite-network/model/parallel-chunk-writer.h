@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef PARALLEL_CHUNK_WRITER_H
+#define PARALLEL_CHUNK_WRITER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace ns3 {
+
+/**
+ * Writes a file which consists of a sequence of independent chunks (e.g., the lines of
+ * one network device), formatting the chunks in parallel into in-memory buffers and then
+ * writing those buffers in chunk order with large sequential writes.
+ *
+ * The chunks are processed in windows, such that memory is bounded by the size of a window
+ * instead of by the size of the file. The format function is called concurrently for
+ * different chunks, so it must only read shared state (no ns-3 reference counting).
+ */
+class ParallelChunkWriter
+{
+public:
+
+    // Appends the content of chunk i to the buffer
+    typedef std::function<void(size_t, std::string&)> FormatFunction;
+
+    // Number of formatting threads (0: as many as there are hardware threads)
+    ParallelChunkWriter(uint32_t num_threads);
+
+    // Formats chunks [0, num_chunks) and writes them in order, returns the number of bytes written
+    uint64_t Write(FILE* file, size_t num_chunks, const FormatFunction& format);
+
+    uint32_t GetNumThreads() const;
+
+    // printf-style append to a buffer
+    static void AppendFormat(std::string& buffer, const char* format, ...);
+
+    // Raw bytes append to a buffer (binary records)
+    template <typename T>
+    static void AppendBinary(std::string& buffer, const T& value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+private:
+    uint32_t m_num_threads;
+    std::vector<std::string> m_buffers; // One per thread, reused across windows
+};
+
+}
+
+#endif //PARALLEL_CHUNK_WRITER_H
@@ -23,6 +23,8 @@
 
 #include "point-to-point-laser-channel.h"
 #include "ns3/core-module.h"
+#include "ns3/hot-path-profiler.h"
+#include "ns3/boolean.h"
 
 namespace ns3 {
 
@@ -45,6 +47,19 @@ PointToPointLaserChannel::GetTypeId (void)
                    DoubleValue (299792458.0),
                    MakeDoubleAccessor (&PointToPointLaserChannel::m_propagationSpeed),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("DelayCacheTolerance",
+                   "The delay of each direction is calculated at most once within each quantum of this length, "
+                   "and re-used for all packets sent within the quantum (zero: calculated for every packet)",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&PointToPointLaserChannel::m_delayCacheTolerance),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("ZeroCopy",
+                   "Hand the transmitted packet itself over to the receiving network device instead of a copy "
+                   "(the sending device is done with it once its transmission completed, which is before the "
+                   "arrival; trace sinks must not hold on to packets, as the receiver modifies them)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PointToPointLaserChannel::m_zeroCopy),
+                   MakeBooleanChecker ())
     .AddTraceSource ("TxRxPointToPoint",
                      "Trace source indicating transmission of packet "
                      "from the PointToPointLaserChannel, used by the Animation "
@@ -58,6 +73,7 @@ PointToPointLaserChannel::GetTypeId (void)
 PointToPointLaserChannel::PointToPointLaserChannel()
   :
     Channel (),
+    m_zeroCopy (false),
     m_nDevices (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -93,19 +109,17 @@ PointToPointLaserChannel::TransmitStart (
 {
   NS_LOG_FUNCTION (this << p << src);
   NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
+  SATNET_PROFILE_SCOPE (ISL_CHANNEL_TRANSMIT);
 
   NS_ASSERT (m_link[0].m_state != INITIALIZING);
   NS_ASSERT (m_link[1].m_state != INITIALIZING);
 
-  Ptr<MobilityModel> senderMobility = src->GetNode()->GetObject<MobilityModel>();
-  Ptr<MobilityModel> receiverMobility = node_other_end->GetObject<MobilityModel>();
-  Time delay = this->GetDelay(senderMobility, receiverMobility); 
-
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+  Time delay = GetWireDelay (wire, node_other_end);
 
   Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode()->GetId (),
                                   txTime + delay, &PointToPointLaserNetDevice::Receive,
-                                  m_link[wire].m_dst, p->Copy ());
+                                  m_link[wire].m_dst, m_zeroCopy ? ConstCast<Packet> (p) : p->Copy ());
 
   // Call the tx anim callback on the net device
   m_txrxPointToPoint (p, src, m_link[wire].m_dst, txTime, txTime + delay);
@@ -137,11 +151,33 @@ PointToPointLaserChannel::GetDevice (std::size_t i) const
 Time
 PointToPointLaserChannel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
+  SATNET_PROFILE_SCOPE (ISL_CHANNEL_DELAY);
   double distance = a->GetDistanceFrom (b);
   double seconds = distance / m_propagationSpeed;
   return Seconds (seconds);
 }
 
+Time
+PointToPointLaserChannel::GetWireDelay (uint32_t wire, Ptr<Node> node_other_end)
+{
+  Link &link = m_link[wire];
+  int64_t quantum = 0;
+  if (m_delayCacheTolerance.IsStrictlyPositive ())
+    {
+      quantum = Simulator::Now ().GetTimeStep () / m_delayCacheTolerance.GetTimeStep ();
+      if (quantum == link.m_delayQuantum)
+        {
+          return link.m_delay;
+        }
+    }
+
+  Ptr<MobilityModel> senderMobility = link.m_src->GetNode ()->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> receiverMobility = node_other_end->GetObject<MobilityModel> ();
+  link.m_delay = GetDelay (senderMobility, receiverMobility);
+  link.m_delayQuantum = m_delayCacheTolerance.IsStrictlyPositive () ? quantum : -1;
+  return link.m_delay;
+}
+
 Ptr<PointToPointLaserNetDevice>
 PointToPointLaserChannel::GetSource (uint32_t i) const
 {
@@ -131,6 +131,19 @@ protected:
    */
   Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
 
+  /**
+   * \brief Get the delay of a wire of this channel
+   *
+   * If the delay cache tolerance is set, the delay is only calculated once
+   * within each quantum of that length and re-used afterwards.
+   *
+   * \param wire the direction in which is sent
+   * \param node_other_end node at the other end of the channel
+   *
+   * \returns Time delay
+   */
+  Time GetWireDelay (uint32_t wire, Ptr<Node> node_other_end);
+
   /**
    * \brief Check to make sure the link is initialized
    * 
@@ -189,6 +202,9 @@ private:
                                           //   used to give a delay estimate to the
                                           //   distributed simulator
   double             m_propagationSpeed;  //!< propagation speed on the channel
+  Time               m_delayCacheTolerance; //!< Length of the quantum within which the delay of
+                                            //   a wire is re-used (zero: calculate for every packet)
+  bool               m_zeroCopy;          //!< True to move the packet to the receiving device instead of a copy
   std::size_t        m_nDevices;          //!< Devices of this channel
 
   /**
@@ -233,11 +249,13 @@ public:
     /** \brief Create the link, it will be in INITIALIZING state
      *
      */
-    Link() : m_state (INITIALIZING), m_src (0), m_dst (0) {}
+    Link() : m_state (INITIALIZING), m_src (0), m_dst (0), m_delayQuantum (-1) {}
 
     WireState                       m_state; //!< State of the link
     Ptr<PointToPointLaserNetDevice> m_src;   //!< First NetDevice
     Ptr<PointToPointLaserNetDevice> m_dst;   //!< Second NetDevice
+    int64_t                         m_delayQuantum; //!< Quantum in which m_delay was calculated
+    Time                            m_delay;        //!< Cached delay
   };
 
   Link    m_link[N_DEVICES]; //!< Link model
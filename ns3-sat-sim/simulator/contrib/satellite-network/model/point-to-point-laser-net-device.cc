@@ -22,7 +22,9 @@
  */
 
 
+#include <algorithm>
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/mac48-address.h"
@@ -30,6 +32,7 @@
 #include "ns3/error-model.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
+#include "ns3/enum.h"
 #include "ns3/pointer.h"
 #include "ns3/ppp-header.h"
 #include "point-to-point-laser-net-device.h"
@@ -73,6 +76,13 @@ PointToPointLaserNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&PointToPointLaserNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("Framing",
+                   "Framing of the packets on the link (Ppp: a PPP header with the protocol "
+                   "number, None: no header, the protocol is inferred from the IP version)",
+                   EnumValue (FRAMING_PPP),
+                   MakeEnumAccessor (&PointToPointLaserNetDevice::m_framing),
+                   MakeEnumChecker (FRAMING_PPP, "Ppp",
+                                    FRAMING_NONE, "None"))
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -181,6 +191,7 @@ PointToPointLaserNetDevice::GetTypeId (void)
 PointToPointLaserNetDevice::PointToPointLaserNetDevice () 
   :
     m_txMachineState (READY),
+    m_backgroundUtilization (0.0),
     m_channel (0),
     m_linkUp (false),
     m_currentPkt (0)
@@ -197,6 +208,11 @@ void
 PointToPointLaserNetDevice::AddHeader (Ptr<Packet> p, uint16_t protocolNumber)
 {
   NS_LOG_FUNCTION (this << p << protocolNumber);
+  if (m_framing == FRAMING_NONE)
+    {
+      NS_ABORT_MSG_UNLESS (protocolNumber == 0x0800 || protocolNumber == 0x86DD, "Only IPv4 and IPv6 can be sent without framing");
+      return;
+    }
   PppHeader ppp;
   ppp.SetProtocol (EtherToPpp (protocolNumber));
   p->AddHeader (ppp);
@@ -206,6 +222,11 @@ bool
 PointToPointLaserNetDevice::ProcessHeader (Ptr<Packet> p, uint16_t& param)
 {
   NS_LOG_FUNCTION (this << p << param);
+  if (m_framing == FRAMING_NONE)
+    {
+      param = IpVersionToEther (p);
+      return true;
+    }
   PppHeader ppp;
   p->RemoveHeader (ppp);
   param = PppToEther (ppp.GetProtocol ());
@@ -238,6 +259,15 @@ PointToPointLaserNetDevice::SetInterframeGap (Time t)
   m_tInterframeGap = t;
 }
 
+void
+PointToPointLaserNetDevice::SetBackgroundLoad (double utilization, Time queueingDelay)
+{
+  NS_LOG_FUNCTION (this << utilization << queueingDelay);
+  NS_ABORT_MSG_IF (utilization < 0 || utilization >= 1, "Background utilization must be in [0, 1)");
+  m_backgroundUtilization = utilization;
+  m_backgroundQueueingDelay = queueingDelay;
+}
+
 bool
 PointToPointLaserNetDevice::TransmitStart (Ptr<Packet> p)
 {
@@ -256,12 +286,22 @@ PointToPointLaserNetDevice::TransmitStart (Ptr<Packet> p)
   TrackUtilization(true);
 
   Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
+  Time arrivalTxTime = txTime; // Until the packet has fully arrived, without the propagation delay
+  if (m_backgroundUtilization > 0 || m_backgroundLastArrival > Simulator::Now ())
+    {
+      // Leaves the background queue after its queueing delay, but not before the previous
+      // packet has fully arrived (a smaller packet or a shorter delay does not overtake it)
+      txTime = DataRate ((uint64_t) (m_bps.GetBitRate () * (1.0 - m_backgroundUtilization))).CalculateBytesTxTime (p->GetSize ());
+      Time queueExit = std::max (Simulator::Now () + m_backgroundQueueingDelay, m_backgroundLastArrival);
+      m_backgroundLastArrival = queueExit + txTime;
+      arrivalTxTime = m_backgroundLastArrival - Simulator::Now ();
+    }
   Time txCompleteTime = txTime + m_tInterframeGap;
 
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
   Simulator::Schedule (txCompleteTime, &PointToPointLaserNetDevice::TransmitComplete, this);
 
-  bool result = m_channel->TransmitStart (p, this, m_destination_node, txTime);
+  bool result = m_channel->TransmitStart (p, this, m_destination_node, arrivalTxTime);
   if (result == false)
     {
       m_phyTxDropTrace (p);
@@ -363,9 +403,9 @@ PointToPointLaserNetDevice::Receive (Ptr<Packet> packet)
 
       //
       // Trace sinks will expect complete packets, not packets without some of the
-      // headers.
+      // headers (without framing, no header is removed so no copy is needed).
       //
-      Ptr<Packet> originalPacket = packet->Copy ();
+      Ptr<Packet> originalPacket = m_framing == FRAMING_NONE ? packet : packet->Copy ();
 
       //
       // Strip off the point-to-point protocol header and forward this packet
@@ -692,67 +732,44 @@ PointToPointLaserNetDevice::EtherToPpp (uint16_t proto)
   return 0;
 }
 
+uint16_t
+PointToPointLaserNetDevice::IpVersionToEther (Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  uint8_t firstByte = 0;
+  p->CopyData (&firstByte, 1);
+  switch(firstByte >> 4)
+    {
+    case 4: return 0x0800;   //IPv4
+    case 6: return 0x86DD;   //IPv6
+    default: NS_ABORT_MSG ("Unframed packet is neither IPv4 nor IPv6!");
+    }
+  return 0;
+}
+
 void
-PointToPointLaserNetDevice::EnableUtilizationTracking(int64_t interval_ns) {
-    m_utilization_tracking_enabled = true;
-    m_interval_ns = interval_ns;
-    m_prev_time_ns = 0;
-    m_current_interval_start = 0;
-    m_current_interval_end = m_interval_ns;
-    m_idle_time_counter_ns = 0;
-    m_busy_time_counter_ns = 0;
-    m_current_state_is_on = false;
+PointToPointLaserNetDevice::EnableUtilizationTracking(int64_t interval_ns, uint32_t quantization_levels) {
+    m_utilization_tracker.reset(new UtilizationTracker(interval_ns, quantization_levels));
 }
 
 void
 PointToPointLaserNetDevice::TrackUtilization(bool next_state_is_on) {
-    if (m_utilization_tracking_enabled) {
-
-        // Current time in nanoseconds
-        int64_t now_ns = Simulator::Now().GetNanoSeconds();
-        while (now_ns >= m_current_interval_end) {
-
-            // Add everything until the end of the interval
-            if (next_state_is_on) {
-                m_idle_time_counter_ns += m_current_interval_end - m_prev_time_ns;
-            } else {
-                m_busy_time_counter_ns += m_current_interval_end - m_prev_time_ns;
-            }
-
-            // Save into the utilization array
-            m_utilization.push_back(((double) m_busy_time_counter_ns) / ((double) m_interval_ns));
-
-            // This must match up
-            NS_ABORT_MSG_IF(m_idle_time_counter_ns + m_busy_time_counter_ns != m_interval_ns, "Not all time is accounted for");
-
-            // Move to next interval
-            m_idle_time_counter_ns = 0;
-            m_busy_time_counter_ns = 0;
-            m_prev_time_ns = m_current_interval_end;
-            m_current_interval_start += m_interval_ns;
-            m_current_interval_end += m_interval_ns;
-        }
-
-        // If not at the end of a new interval, just keep track of it all
-        if (next_state_is_on) {
-            m_idle_time_counter_ns += now_ns - m_prev_time_ns;
-        } else {
-            m_busy_time_counter_ns += now_ns - m_prev_time_ns;
-        }
-
-        // This has become the previous call
-        m_current_state_is_on = next_state_is_on;
-        m_prev_time_ns = now_ns;
-
+    if (m_utilization_tracker) {
+        m_utilization_tracker->Track(Simulator::Now().GetNanoSeconds(), next_state_is_on);
     }
 }
 
+UtilizationTracker&
+PointToPointLaserNetDevice::GetUtilizationTracker() {
+    NS_ABORT_MSG_UNLESS(m_utilization_tracker, "Utilization tracking is not enabled");
+    return *m_utilization_tracker;
+}
 
-
-const std::vector<double>&
+const std::vector<UtilizationTracker::Segment>&
 PointToPointLaserNetDevice::FinalizeUtilization() {
-    TrackUtilization(!m_current_state_is_on);
-    return m_utilization;
+    UtilizationTracker& tracker = GetUtilizationTracker();
+    tracker.Finalize(Simulator::Now().GetNanoSeconds());
+    return tracker.GetCompletedSegments();
 }
 
 
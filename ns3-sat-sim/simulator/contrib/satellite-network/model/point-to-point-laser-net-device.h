@@ -25,6 +25,7 @@
 #define POINT_TO_POINT_LASER_NET_DEVICE_H
 
 #include <cstring>
+#include <memory>
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "ns3/net-device.h"
@@ -35,6 +36,7 @@
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
+#include "ns3/utilization-tracker.h"
 
 namespace ns3 {
 
@@ -65,6 +67,15 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * Framing of the packets on the link.
+   */
+  enum Framing
+  {
+    FRAMING_PPP,   /**< A PPP header which carries the protocol number */
+    FRAMING_NONE   /**< No header: the receiver infers IPv4/IPv6 from the IP version field */
+  };
+
   /**
    * Construct a PointToPointLaserNetDevice
    *
@@ -96,6 +107,16 @@ public:
    */
   void SetInterframeGap (Time t);
 
+  /**
+   * Set the load of background traffic which is not simulated as packets (e.g., fluid
+   * flows). Packets are sent at the data rate it leaves, and wait the queueing delay
+   * behind it before they arrive (in addition to the propagation delay).
+   *
+   * \param utilization Fraction of the data rate used by the background traffic, in [0, 1)
+   * \param queueingDelay Queueing delay behind the background traffic
+   */
+  void SetBackgroundLoad (double utilization, Time queueingDelay);
+
   /**
    * Attach the device to a channel.
    *
@@ -304,6 +325,14 @@ private:
    */
   Time           m_tInterframeGap;
 
+  /**
+   * Background traffic (see SetBackgroundLoad ()), and when the last packet sent behind
+   * it has fully arrived (packets are not reordered)
+   */
+  double         m_backgroundUtilization;
+  Time           m_backgroundQueueingDelay;
+  Time           m_backgroundLastArrival;
+
   /**
    * The PointToPointLaserChannel to which this PointToPointLaserNetDevice
    * has been attached.
@@ -453,6 +482,14 @@ private:
    */
   uint32_t m_mtu;
 
+  /**
+   * \brief Framing of the packets on the link
+   *
+   * With FRAMING_NONE no header is added nor removed on every hop, which
+   * also means the transmitted frame is two bytes shorter.
+   */
+  Framing m_framing;
+
   Ptr<Packet> m_currentPkt; //!< Current packet processed
 
   /**
@@ -469,21 +506,21 @@ private:
    */
   static uint16_t EtherToPpp (uint16_t protocol);
 
+  /**
+   * \brief Ethernet protocol number of an unframed IP packet
+   * \param p A packet which starts with an IPv4 or IPv6 header
+   * \return The corresponding Ethernet protocol number
+   */
+  static uint16_t IpVersionToEther (Ptr<const Packet> p);
+
 private:
-  bool m_utilization_tracking_enabled = false;
-  int64_t m_interval_ns;
-  int64_t m_prev_time_ns;
-  int64_t m_current_interval_start;
-  int64_t m_current_interval_end;
-  int64_t m_idle_time_counter_ns;
-  int64_t m_busy_time_counter_ns;
-  bool m_current_state_is_on;
-  std::vector<double> m_utilization;
+  std::unique_ptr<UtilizationTracker> m_utilization_tracker; // Only set if utilization tracking is enabled
   void TrackUtilization(bool next_state_is_on);
 
 public:
-    void EnableUtilizationTracking(int64_t interval_ns);
-    const std::vector<double>& FinalizeUtilization();
+    void EnableUtilizationTracking(int64_t interval_ns, uint32_t quantization_levels);
+    UtilizationTracker& GetUtilizationTracker();
+    const std::vector<UtilizationTracker::Segment>& FinalizeUtilization();
 
 };
 
@@ -69,11 +69,8 @@ PointToPointLaserRemoteChannel::TransmitStart (
 
   IsInitialized ();
 
-  Ptr<MobilityModel> senderMobility = src->GetNode()->GetObject<MobilityModel>();
-  Ptr<MobilityModel> receiverMobility = node_other_end->GetObject<MobilityModel>();
-  Time delay = this->GetDelay(senderMobility, receiverMobility);
-
   uint32_t wire = src == GetSource (0) ? 0 : 1;
+  Time delay = GetWireDelay (wire, node_other_end);
   Ptr<PointToPointLaserNetDevice> dst = GetDestination (wire);
 
 #ifdef NS3_MPI
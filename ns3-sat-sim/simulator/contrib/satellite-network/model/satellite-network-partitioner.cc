@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "satellite-network-partitioner.h"
+#include <map>
+#include <limits>
+#include <cmath>
+#include <iostream>
+#include "ns3/abort.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+    SatelliteNetworkPartitioner::SatelliteNetworkPartitioner(uint32_t num_systems) {
+        NS_ABORT_MSG_IF(num_systems == 0, "There must be at least one system");
+        m_num_systems = num_systems;
+    }
+
+    std::vector<uint32_t> SatelliteNetworkPartitioner::DetermineOrbitalPlanes(const std::vector<Ptr<Satellite>>& satellites) {
+
+        // TLE line 2: inclination in columns 9-16, RAAN in columns 18-25 (both in degrees, 4 decimals)
+        std::vector<std::pair<int64_t, int64_t>> keys;
+        std::map<std::pair<int64_t, int64_t>, uint32_t> plane_of_key;
+        for (const Ptr<Satellite>& satellite : satellites) {
+            std::string tle2 = satellite->GetTleInfo().second;
+            if (tle2.size() < 25) {
+                throw std::runtime_error(format_string("TLE line 2 of satellite %s is too short", satellite->GetName().c_str()));
+            }
+            int64_t inclination = std::llround(parse_double(tle2.substr(8, 8)) * 10000);
+            int64_t raan = std::llround(parse_double(tle2.substr(17, 8)) * 10000);
+            keys.push_back(std::make_pair(inclination, raan));
+            plane_of_key[keys.back()] = 0;
+        }
+
+        // The map is ordered, which gives the plane numbering
+        uint32_t plane = 0;
+        for (std::pair<const std::pair<int64_t, int64_t>, uint32_t>& entry : plane_of_key) {
+            entry.second = plane;
+            plane++;
+        }
+        std::vector<uint32_t> planes;
+        for (const std::pair<int64_t, int64_t>& key : keys) {
+            planes.push_back(plane_of_key[key]);
+        }
+        return planes;
+    }
+
+    std::vector<uint32_t> SatelliteNetworkPartitioner::AssignSatellites(const std::vector<Ptr<Satellite>>& satellites) {
+        m_satellites = satellites;
+        std::vector<uint32_t> planes = DetermineOrbitalPlanes(satellites);
+
+        // Number of satellites in each plane
+        uint32_t num_planes = 0;
+        for (uint32_t plane : planes) {
+            num_planes = std::max(num_planes, plane + 1);
+        }
+        std::vector<size_t> plane_size(num_planes, 0);
+        for (uint32_t plane : planes) {
+            plane_size[plane]++;
+        }
+
+        // Contiguous runs of whole planes, filling up each system to its fair share
+        std::vector<uint32_t> system_of_plane(num_planes, 0);
+        uint32_t system_id = 0;
+        size_t assigned = 0;
+        for (uint32_t plane = 0; plane < num_planes; plane++) {
+            double fair_share_end = (double) satellites.size() * (system_id + 1) / m_num_systems;
+            if (system_id + 1 < m_num_systems && assigned + plane_size[plane] / 2.0 > fair_share_end) {
+                system_id++;
+            }
+            system_of_plane[plane] = system_id;
+            assigned += plane_size[plane];
+        }
+
+        m_satellite_system_ids.clear();
+        for (uint32_t plane : planes) {
+            m_satellite_system_ids.push_back(system_of_plane[plane]);
+        }
+        return m_satellite_system_ids;
+    }
+
+    SatelliteNetworkPartitioner::Statistics SatelliteNetworkPartitioner::Evaluate(
+            uint32_t num_systems,
+            const std::vector<uint32_t>& satellite_system_ids,
+            const std::vector<uint32_t>& ground_station_system_ids,
+            const std::vector<std::pair<int32_t, int32_t>>& isls
+    ) {
+        Statistics statistics;
+        statistics.num_satellites.resize(num_systems, 0);
+        statistics.num_ground_stations.resize(num_systems, 0);
+        statistics.num_cut_isls.resize(num_systems, 0);
+        statistics.num_isls = isls.size();
+        statistics.total_cut_isls = 0;
+        for (uint32_t system_id : satellite_system_ids) {
+            statistics.num_satellites.at(system_id)++;
+        }
+        for (uint32_t system_id : ground_station_system_ids) {
+            statistics.num_ground_stations.at(system_id)++;
+        }
+        for (const std::pair<int32_t, int32_t>& isl : isls) {
+            uint32_t system0 = satellite_system_ids.at(isl.first);
+            uint32_t system1 = satellite_system_ids.at(isl.second);
+            if (system0 != system1) {
+                statistics.num_cut_isls[system0]++;
+                statistics.num_cut_isls[system1]++;
+                statistics.total_cut_isls++;
+            }
+        }
+        return statistics;
+    }
+
+    void SatelliteNetworkPartitioner::PrintStatistics(const Statistics& statistics, const std::string& indent) {
+        for (uint32_t i = 0; i < statistics.num_satellites.size(); i++) {
+            std::cout << indent << "System " << i << ": "
+                      << statistics.num_satellites[i] << " satellites, "
+                      << statistics.num_ground_stations[i] << " ground stations, "
+                      << statistics.num_cut_isls[i] << " ISLs to other systems" << std::endl;
+        }
+        std::cout << indent << "ISLs between systems: " << statistics.total_cut_isls << "/" << statistics.num_isls << std::endl;
+    }
+
+    std::vector<uint32_t> SatelliteNetworkPartitioner::AssignGroundStations(const std::vector<Vector>& ground_station_positions) {
+        NS_ABORT_MSG_IF(m_satellite_system_ids.size() != m_satellites.size(), "Satellites must be assigned first");
+
+        // Satellite positions at the start
+        std::vector<Vector> satellite_positions;
+        for (const Ptr<Satellite>& satellite : m_satellites) {
+            satellite_positions.push_back(satellite->GetPosition(satellite->GetTleEpoch()));
+        }
+
+        // Nearest satellite
+        std::vector<uint32_t> system_ids;
+        for (const Vector& gs_position : ground_station_positions) {
+            double min_distance_m = std::numeric_limits<double>::max();
+            uint32_t system_id = 0;
+            for (size_t i = 0; i < satellite_positions.size(); i++) {
+                double distance_m = CalculateDistance(gs_position, satellite_positions[i]);
+                if (distance_m < min_distance_m) {
+                    min_distance_m = distance_m;
+                    system_id = m_satellite_system_ids[i];
+                }
+            }
+            system_ids.push_back(system_id);
+        }
+        return system_ids;
+    }
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef SATELLITE_NETWORK_PARTITIONER_H
+#define SATELLITE_NETWORK_PARTITIONER_H
+
+#include <vector>
+#include <string>
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "ns3/satellite.h"
+
+namespace ns3 {
+
+/**
+ * Assignment of the nodes of a satellite network to the systems (MPI ranks) of a
+ * distributed simulation.
+ *
+ * Satellites are grouped into orbital planes (same inclination and right ascension of the
+ * ascending node in their TLE). The planes are ordered by inclination and RAAN, and each
+ * system gets a contiguous run of planes with about the same number of satellites. As such,
+ * all intra-plane ISLs stay within a system, and only the inter-plane ISLs at the boundary
+ * between two runs of planes cross systems.
+ *
+ * A ground station is assigned to the system of the satellite nearest to it at the start,
+ * as that is where (most of) its GSL traffic goes to.
+ */
+class SatelliteNetworkPartitioner
+{
+public:
+    SatelliteNetworkPartitioner(uint32_t num_systems);
+
+    // System id of each satellite
+    std::vector<uint32_t> AssignSatellites(const std::vector<Ptr<Satellite>>& satellites);
+
+    // System id of each ground station (given its position), requires the satellites to be assigned first
+    std::vector<uint32_t> AssignGroundStations(const std::vector<Vector>& ground_station_positions);
+
+    // Orbital plane of each satellite, planes are numbered in order of (inclination, RAAN)
+    static std::vector<uint32_t> DetermineOrbitalPlanes(const std::vector<Ptr<Satellite>>& satellites);
+
+    // Balance and cut of an assignment
+    struct Statistics {
+        std::vector<uint32_t> num_satellites;       // Per system
+        std::vector<uint32_t> num_ground_stations;  // Per system
+        std::vector<uint32_t> num_cut_isls;         // Per system, ISLs to another system
+        uint32_t num_isls;
+        uint32_t total_cut_isls;
+    };
+    static Statistics Evaluate(
+            uint32_t num_systems,
+            const std::vector<uint32_t>& satellite_system_ids,
+            const std::vector<uint32_t>& ground_station_system_ids,
+            const std::vector<std::pair<int32_t, int32_t>>& isls
+    );
+    static void PrintStatistics(const Statistics& statistics, const std::string& indent);
+
+private:
+    uint32_t m_num_systems;
+    std::vector<Ptr<Satellite>> m_satellites;
+    std::vector<uint32_t> m_satellite_system_ids;
+};
+
+}
+
+#endif //SATELLITE_NETWORK_PARTITIONER_H
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "satellite-visibility-index.h"
+#include <cmath>
+#include <algorithm>
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+    static const double DEG_TO_RAD = M_PI / 180.0;
+    static const double RAD_TO_DEG = 180.0 / M_PI;
+
+    static double Length(const Vector& v) {
+        return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    }
+
+    // Sine of the elevation times the distance: component of (satellite - ground) along the up direction
+    static bool IsAboveElevation(const Vector& ground_position, double ground_radius, const Vector& satellite_position, double sin_min_elevation) {
+        Vector d(satellite_position.x - ground_position.x, satellite_position.y - ground_position.y, satellite_position.z - ground_position.z);
+        double up = (d.x * ground_position.x + d.y * ground_position.y + d.z * ground_position.z) / ground_radius;
+        return up >= Length(d) * sin_min_elevation;
+    }
+
+    SatelliteVisibilityIndex::SatelliteVisibilityIndex(double cell_size_deg) {
+        NS_ABORT_MSG_IF(cell_size_deg <= 0 || cell_size_deg > 180, "Cell size must be in (0, 180] degrees");
+        m_cell_size_deg = cell_size_deg;
+        m_num_rows = (uint32_t) std::ceil(180.0 / cell_size_deg);
+        m_num_cols = (uint32_t) std::ceil(360.0 / cell_size_deg);
+        m_max_radius_m = 0;
+        m_cell_start.assign((size_t) m_num_rows * m_num_cols + 1, 0);
+    }
+
+    size_t SatelliteVisibilityIndex::GetCellIndex(uint32_t row, uint32_t col) const {
+        return (size_t) row * m_num_cols + col;
+    }
+
+    void SatelliteVisibilityIndex::Build(const std::vector<Vector>& satellite_positions) {
+        m_positions = satellite_positions;
+        m_max_radius_m = 0;
+
+        // Cell of each sub-satellite point
+        std::vector<size_t> cells;
+        cells.reserve(m_positions.size());
+        for (const Vector& p : m_positions) {
+            double r = Length(p);
+            m_max_radius_m = std::max(m_max_radius_m, r);
+            double lat_deg = r == 0 ? 0 : std::asin(std::max(-1.0, std::min(1.0, p.z / r))) * RAD_TO_DEG;
+            double lon_deg = std::atan2(p.y, p.x) * RAD_TO_DEG;
+            uint32_t row = std::min(m_num_rows - 1, (uint32_t) std::max(0.0, std::floor((lat_deg + 90.0) / m_cell_size_deg)));
+            uint32_t col = std::min(m_num_cols - 1, (uint32_t) std::max(0.0, std::floor((lon_deg + 180.0) / m_cell_size_deg)));
+            cells.push_back(GetCellIndex(row, col));
+        }
+
+        // Counting sort into the cells (satellite ids stay ascending within a cell)
+        std::fill(m_cell_start.begin(), m_cell_start.end(), 0);
+        for (size_t cell : cells) {
+            m_cell_start[cell + 1]++;
+        }
+        for (size_t c = 1; c < m_cell_start.size(); c++) {
+            m_cell_start[c] += m_cell_start[c - 1];
+        }
+        m_cell_satellites.resize(m_positions.size());
+        std::vector<uint32_t> next(m_cell_start.begin(), m_cell_start.end() - 1);
+        for (uint32_t i = 0; i < cells.size(); i++) {
+            m_cell_satellites[next[cells[i]]++] = i;
+        }
+    }
+
+    std::vector<uint32_t> SatelliteVisibilityIndex::GetVisibleSatellites(const Vector& ground_position, double min_elevation_deg) const {
+        std::vector<uint32_t> visible;
+        double ground_radius = Length(ground_position);
+        NS_ABORT_MSG_IF(ground_radius == 0, "Ground position cannot be the center of the Earth");
+
+        // Largest Earth central angle between the ground position and a visible sub-satellite point
+        double min_elevation = min_elevation_deg * DEG_TO_RAD;
+        double cos_ratio = ground_radius * std::cos(min_elevation) / m_max_radius_m;
+        if (m_positions.empty() || cos_ratio > 1.0) {
+            return visible;
+        }
+        double cap_deg = (std::acos(cos_ratio) - min_elevation) * RAD_TO_DEG + 1e-9;
+        if (cap_deg < 0) {
+            return visible;
+        }
+
+        // Rows of the latitudes of the cap
+        double lat_deg = std::asin(std::max(-1.0, std::min(1.0, ground_position.z / ground_radius))) * RAD_TO_DEG;
+        double lon_deg = std::atan2(ground_position.y, ground_position.x) * RAD_TO_DEG;
+        double lat_lo = lat_deg - cap_deg;
+        double lat_hi = lat_deg + cap_deg;
+        uint32_t row_lo = (uint32_t) std::max(0.0, std::floor((lat_lo + 90.0) / m_cell_size_deg));
+        uint32_t row_hi = std::min(m_num_rows - 1, (uint32_t) std::max(0.0, std::floor((lat_hi + 90.0) / m_cell_size_deg)));
+
+        // Longitudes of the cap, all of them if it contains a pole (else it wraps around at most once)
+        std::vector<std::pair<double, double>> lon_ranges;
+        lon_ranges.push_back(std::make_pair(-180.0, 180.0));
+        if (lat_lo > -90.0 && lat_hi < 90.0) {
+            double sin_half_width = std::sin(cap_deg * DEG_TO_RAD) / std::cos(lat_deg * DEG_TO_RAD);
+            if (sin_half_width < 1.0) {
+                double half_width_deg = std::asin(sin_half_width) * RAD_TO_DEG;
+                double lon_lo = lon_deg - half_width_deg;
+                double lon_hi = lon_deg + half_width_deg;
+                lon_ranges.clear();
+                lon_ranges.push_back(std::make_pair(std::max(-180.0, lon_lo), std::min(180.0, lon_hi)));
+                if (lon_lo < -180.0) {
+                    lon_ranges.push_back(std::make_pair(lon_lo + 360.0, 180.0));
+                }
+                if (lon_hi > 180.0) {
+                    lon_ranges.push_back(std::make_pair(-180.0, lon_hi - 360.0));
+                }
+            }
+        }
+
+        // Exact elevation of the satellites in those cells
+        double sin_min_elevation = std::sin(min_elevation);
+        for (const std::pair<double, double>& lon_range : lon_ranges) {
+            uint32_t col_lo = (uint32_t) std::max(0.0, std::floor((lon_range.first + 180.0) / m_cell_size_deg));
+            uint32_t col_hi = std::min(m_num_cols - 1, (uint32_t) std::max(0.0, std::floor((lon_range.second + 180.0) / m_cell_size_deg)));
+            for (uint32_t row = row_lo; row <= row_hi; row++) {
+                for (uint32_t col = col_lo; col <= col_hi; col++) {
+                    size_t cell = GetCellIndex(row, col);
+                    for (uint32_t j = m_cell_start[cell]; j < m_cell_start[cell + 1]; j++) {
+                        uint32_t sat_id = m_cell_satellites[j];
+                        if (IsAboveElevation(ground_position, ground_radius, m_positions[sat_id], sin_min_elevation)) {
+                            visible.push_back(sat_id);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Ascending, and a cell can be in two longitude ranges if cells are very large
+        std::sort(visible.begin(), visible.end());
+        visible.erase(std::unique(visible.begin(), visible.end()), visible.end());
+        return visible;
+    }
+
+    std::vector<uint32_t> SatelliteVisibilityIndex::GetVisibleSatellitesBruteForce(const Vector& ground_position, double min_elevation_deg) const {
+        std::vector<uint32_t> visible;
+        double ground_radius = Length(ground_position);
+        double sin_min_elevation = std::sin(min_elevation_deg * DEG_TO_RAD);
+        for (uint32_t sat_id = 0; sat_id < m_positions.size(); sat_id++) {
+            if (IsAboveElevation(ground_position, ground_radius, m_positions[sat_id], sin_min_elevation)) {
+                visible.push_back(sat_id);
+            }
+        }
+        return visible;
+    }
+
+    double SatelliteVisibilityIndex::CalculateElevationDeg(const Vector& ground_position, const Vector& satellite_position) {
+        Vector d(satellite_position.x - ground_position.x, satellite_position.y - ground_position.y, satellite_position.z - ground_position.z);
+        double up = (d.x * ground_position.x + d.y * ground_position.y + d.z * ground_position.z) / Length(ground_position);
+        return std::asin(std::max(-1.0, std::min(1.0, up / Length(d)))) * RAD_TO_DEG;
+    }
+
+    uint32_t SatelliteVisibilityIndex::GetNumSatellites() const {
+        return m_positions.size();
+    }
+
+}
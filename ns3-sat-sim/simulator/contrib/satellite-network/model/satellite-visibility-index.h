@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef SATELLITE_VISIBILITY_INDEX_H
+#define SATELLITE_VISIBILITY_INDEX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+/**
+ * Spatial index of satellite positions (ECEF) to find the satellites a ground station can
+ * see above a minimum elevation, without computing the elevation of every satellite.
+ *
+ * The sub-satellite points (geocentric latitude and longitude) are bucketed in a grid of
+ * cells of equal angular size. A satellite at radius r is visible from a ground position at
+ * radius R above elevation e only if its sub-satellite point is within the Earth central
+ * angle arccos(R cos(e) / r) - e, so a query only visits the cells of that spherical cap
+ * (using the largest satellite radius) and then checks the exact elevation of their
+ * satellites. Elevation is relative to the geocentric horizon (perpendicular to the
+ * position vector of the ground station).
+ *
+ * The index is a snapshot: it is rebuilt from the positions at every time step of interest.
+ */
+class SatelliteVisibilityIndex
+{
+public:
+
+    // Cells of cell_size_deg x cell_size_deg (latitude x longitude)
+    SatelliteVisibilityIndex(double cell_size_deg);
+
+    // Rebuilds the index, satellite id = index in the positions
+    void Build(const std::vector<Vector>& satellite_positions);
+
+    // Visible satellite ids (ascending) from a ground position (ECEF) above a minimum elevation
+    std::vector<uint32_t> GetVisibleSatellites(const Vector& ground_position, double min_elevation_deg) const;
+
+    // Same result, but checking every satellite
+    std::vector<uint32_t> GetVisibleSatellitesBruteForce(const Vector& ground_position, double min_elevation_deg) const;
+
+    // Elevation (degrees) of a satellite seen from a ground position, relative to the geocentric horizon
+    static double CalculateElevationDeg(const Vector& ground_position, const Vector& satellite_position);
+
+    uint32_t GetNumSatellites() const;
+
+private:
+    size_t GetCellIndex(uint32_t row, uint32_t col) const;
+
+    double m_cell_size_deg;
+    uint32_t m_num_rows;
+    uint32_t m_num_cols;
+    double m_max_radius_m;
+    std::vector<Vector> m_positions;
+    std::vector<uint32_t> m_cell_start;       // Satellites of cell c: m_cell_satellites[m_cell_start[c], m_cell_start[c + 1])
+    std::vector<uint32_t> m_cell_satellites;
+};
+
+}
+
+#endif //SATELLITE_VISIBILITY_INDEX_H
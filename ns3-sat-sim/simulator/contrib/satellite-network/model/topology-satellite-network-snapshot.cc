@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "topology-satellite-network-snapshot.h"
+#include <cinttypes>
+#include <cstring>
+#include <sstream>
+#include "ns3/hash.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+    const char* TopologySatelliteNetworkSnapshot::MAGIC = "SATNETSS";
+    const uint32_t TopologySatelliteNetworkSnapshot::VERSION = 1;
+
+    // Plain binary field writers / readers (host byte order, the snapshot is a local cache)
+
+    template <typename T>
+    static void WritePod(std::ofstream& ofs, const T& value) {
+        ofs.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static bool ReadPod(std::ifstream& ifs, T& value) {
+        ifs.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return ifs.good();
+    }
+
+    static void WriteString(std::ofstream& ofs, const std::string& value) {
+        WritePod<uint32_t>(ofs, value.size());
+        ofs.write(value.data(), value.size());
+    }
+
+    static uint64_t RemainingBytes(std::ifstream& ifs) {
+        std::streampos position = ifs.tellg();
+        ifs.seekg(0, std::ios::end);
+        std::streampos end = ifs.tellg();
+        ifs.seekg(position);
+        return end > position ? (uint64_t) (end - position) : 0;
+    }
+
+    // Lengths and counts come from the file, a corrupt one must not make us allocate beyond its size
+    static void CheckFitsInRemaining(std::ifstream& ifs, uint64_t num, uint64_t min_bytes_each, const char* what) {
+        uint64_t remaining = RemainingBytes(ifs);
+        if (num * min_bytes_each > remaining) {
+            throw std::runtime_error(format_string(
+                    "Snapshot is truncated or corrupt: %" PRIu64 " %s do not fit in the remaining %" PRIu64 " bytes",
+                    num, what, remaining
+            ));
+        }
+    }
+
+    static bool ReadString(std::ifstream& ifs, std::string& value) {
+        uint32_t size;
+        if (!ReadPod<uint32_t>(ifs, size)) {
+            return false;
+        }
+        CheckFitsInRemaining(ifs, size, 1, "string bytes");
+        value.resize(size);
+        ifs.read(&value[0], size);
+        return ifs.good();
+    }
+
+    static void WriteInterface(std::ofstream& ofs, const TopologySatelliteNetworkSnapshot::Interface& itf) {
+        WritePod<uint32_t>(ofs, itf.node_id);
+        WritePod<uint32_t>(ofs, itf.if_id);
+        WritePod<uint32_t>(ofs, itf.ip.Get());
+        WritePod<uint32_t>(ofs, itf.mask.Get());
+    }
+
+    static bool ReadInterface(std::ifstream& ifs, TopologySatelliteNetworkSnapshot::Interface& itf) {
+        uint32_t ip, mask;
+        ReadPod<uint32_t>(ifs, itf.node_id);
+        ReadPod<uint32_t>(ifs, itf.if_id);
+        ReadPod<uint32_t>(ifs, ip);
+        if (!ReadPod<uint32_t>(ifs, mask)) {
+            return false;
+        }
+        itf.ip.Set(ip);
+        itf.mask.Set(mask);
+        return true;
+    }
+
+    uint64_t TopologySatelliteNetworkSnapshot::ComputeFingerprint(const std::string& satellite_network_dir, bool force_static) {
+
+        // Everything that determines the layout goes into a single buffer
+        std::ostringstream buffer;
+        buffer << "version=" << VERSION << ";force_static=" << (force_static ? 1 : 0) << ";";
+        const std::vector<std::string> input_files = {"tles.txt", "isls.txt", "ground_stations.txt", "gsl_interfaces_info.txt"};
+        for (const std::string& input_file : input_files) {
+            std::string filename = satellite_network_dir + "/" + input_file;
+            std::ifstream ifs(filename, std::ios::binary);
+            if (!ifs) {
+                throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
+            }
+            buffer << input_file << "=" << ifs.rdbuf() << ";";
+        }
+
+        std::string contents = buffer.str();
+        return Hash64(contents.data(), contents.size());
+    }
+
+    void TopologySatelliteNetworkSnapshot::Write(const std::string& filename) const {
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        if (!ofs) {
+            throw std::runtime_error(format_string("Snapshot file %s could not be opened for writing.", filename.c_str()));
+        }
+
+        // Header
+        ofs.write(MAGIC, std::strlen(MAGIC));
+        WritePod<uint32_t>(ofs, VERSION);
+        WritePod<uint64_t>(ofs, fingerprint);
+
+        // Satellites
+        WritePod<uint32_t>(ofs, satellites.size());
+        for (const SatelliteEntry& sat : satellites) {
+            WriteString(ofs, sat.name);
+            WriteString(ofs, sat.tle1);
+            WriteString(ofs, sat.tle2);
+        }
+
+        // Ground stations
+        WritePod<uint32_t>(ofs, ground_stations.size());
+        for (const GroundStationEntry& gs : ground_stations) {
+            WritePod<uint32_t>(ofs, gs.gid);
+            WriteString(ofs, gs.name);
+            WritePod<double>(ofs, gs.latitude);
+            WritePod<double>(ofs, gs.longitude);
+            WritePod<double>(ofs, gs.elevation);
+            WritePod<double>(ofs, gs.cartesian_x);
+            WritePod<double>(ofs, gs.cartesian_y);
+            WritePod<double>(ofs, gs.cartesian_z);
+        }
+
+        // ISLs
+        WritePod<uint32_t>(ofs, isls.size());
+        for (const IslEntry& isl : isls) {
+            WritePod<int32_t>(ofs, isl.sat0_id);
+            WritePod<int32_t>(ofs, isl.sat1_id);
+            WriteInterface(ofs, isl.if0);
+            WriteInterface(ofs, isl.if1);
+        }
+
+        // GSL interfaces information per node
+        WritePod<uint32_t>(ofs, gsl_if_info.size());
+        for (const std::tuple<int32_t, double>& info : gsl_if_info) {
+            WritePod<int32_t>(ofs, std::get<0>(info));
+            WritePod<double>(ofs, std::get<1>(info));
+        }
+
+        // GSL interfaces
+        WritePod<uint32_t>(ofs, gsl_interfaces.size());
+        for (const Interface& itf : gsl_interfaces) {
+            WriteInterface(ofs, itf);
+        }
+
+        ofs.close();
+        if (!ofs) {
+            throw std::runtime_error(format_string("Snapshot file %s could not be written.", filename.c_str()));
+        }
+    }
+
+    bool TopologySatelliteNetworkSnapshot::Read(const std::string& filename) {
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs) {
+            return false;
+        }
+
+        // Header: a different magic or version means it cannot be used
+        std::string magic(std::strlen(MAGIC), '\0');
+        ifs.read(&magic[0], magic.size());
+        uint32_t version;
+        if (!ReadPod<uint32_t>(ifs, version) || magic != MAGIC || version != VERSION) {
+            return false;
+        }
+        ReadPod<uint64_t>(ifs, fingerprint);
+
+        // Satellites
+        uint32_t num;
+        if (!ReadPod<uint32_t>(ifs, num)) {
+            return false;
+        }
+        CheckFitsInRemaining(ifs, num, 3 * sizeof(uint32_t), "satellites");
+        satellites.resize(num);
+        for (SatelliteEntry& sat : satellites) {
+            if (!ReadString(ifs, sat.name) || !ReadString(ifs, sat.tle1) || !ReadString(ifs, sat.tle2)) {
+                return false;
+            }
+        }
+
+        // Ground stations
+        if (!ReadPod<uint32_t>(ifs, num)) {
+            return false;
+        }
+        CheckFitsInRemaining(ifs, num, sizeof(uint32_t) * 2 + sizeof(double) * 6, "ground stations");
+        ground_stations.resize(num);
+        for (GroundStationEntry& gs : ground_stations) {
+            ReadPod<uint32_t>(ifs, gs.gid);
+            ReadString(ifs, gs.name);
+            ReadPod<double>(ifs, gs.latitude);
+            ReadPod<double>(ifs, gs.longitude);
+            ReadPod<double>(ifs, gs.elevation);
+            ReadPod<double>(ifs, gs.cartesian_x);
+            ReadPod<double>(ifs, gs.cartesian_y);
+            if (!ReadPod<double>(ifs, gs.cartesian_z)) {
+                return false;
+            }
+        }
+
+        // ISLs
+        if (!ReadPod<uint32_t>(ifs, num)) {
+            return false;
+        }
+        CheckFitsInRemaining(ifs, num, sizeof(int32_t) * 2 + sizeof(uint32_t) * 8, "ISLs");
+        isls.resize(num);
+        for (IslEntry& isl : isls) {
+            ReadPod<int32_t>(ifs, isl.sat0_id);
+            ReadPod<int32_t>(ifs, isl.sat1_id);
+            if (!ReadInterface(ifs, isl.if0) || !ReadInterface(ifs, isl.if1)) {
+                return false;
+            }
+        }
+
+        // GSL interfaces information per node
+        if (!ReadPod<uint32_t>(ifs, num)) {
+            return false;
+        }
+        CheckFitsInRemaining(ifs, num, sizeof(int32_t) + sizeof(double), "GSL interface infos");
+        gsl_if_info.resize(num);
+        for (std::tuple<int32_t, double>& info : gsl_if_info) {
+            ReadPod<int32_t>(ifs, std::get<0>(info));
+            if (!ReadPod<double>(ifs, std::get<1>(info))) {
+                return false;
+            }
+        }
+
+        // GSL interfaces
+        if (!ReadPod<uint32_t>(ifs, num)) {
+            return false;
+        }
+        CheckFitsInRemaining(ifs, num, sizeof(uint32_t) * 4, "GSL interfaces");
+        gsl_interfaces.resize(num);
+        for (Interface& itf : gsl_interfaces) {
+            if (!ReadInterface(ifs, itf)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}
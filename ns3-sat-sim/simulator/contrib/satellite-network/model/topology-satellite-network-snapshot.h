@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef TOPOLOGY_SATELLITE_NETWORK_SNAPSHOT_H
+#define TOPOLOGY_SATELLITE_NETWORK_SNAPSHOT_H
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <fstream>
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+/**
+ * Binary description of a built satellite network topology.
+ *
+ * It holds everything TopologySatelliteNetwork needs to re-create the ns-3 objects
+ * without going through the text inputs and the helper machinery: the satellites (TLEs),
+ * the ground stations, the ISL channel pairs and the GSL interface layout, together with
+ * the IPv4 address of every interface (which also make up the ARP table).
+ *
+ * MAC addresses are not stored: they are allocated in device creation order, which is the
+ * same when the devices are re-created, and the ARP table is filled using those.
+ *
+ * A snapshot is only valid for the exact same network inputs: the fingerprint is a hash
+ * over the input files and settings that determine the layout.
+ */
+class TopologySatelliteNetworkSnapshot
+{
+public:
+
+    // Single interface (network device + its IPv4 address)
+    struct Interface {
+        uint32_t node_id;
+        uint32_t if_id;
+        Ipv4Address ip;
+        Ipv4Mask mask;
+    };
+
+    // Satellite as defined by its TLE
+    struct SatelliteEntry {
+        std::string name;
+        std::string tle1;
+        std::string tle2;
+    };
+
+    // Ground station as defined in ground_stations.txt
+    struct GroundStationEntry {
+        uint32_t gid;
+        std::string name;
+        double latitude;
+        double longitude;
+        double elevation;
+        double cartesian_x;
+        double cartesian_y;
+        double cartesian_z;
+    };
+
+    // ISL (point-to-point laser channel) with its two interfaces
+    struct IslEntry {
+        int32_t sat0_id;
+        int32_t sat1_id;
+        Interface if0;
+        Interface if1;
+    };
+
+    // Fingerprint of the network inputs
+    static uint64_t ComputeFingerprint(const std::string& satellite_network_dir, bool force_static);
+
+    // Serialization (Read() returns false if the file is missing or of another version,
+    // and throws if it is truncated or corrupt)
+    void Write(const std::string& filename) const;
+    bool Read(const std::string& filename);
+
+    // Contents
+    uint64_t fingerprint = 0;
+    std::vector<SatelliteEntry> satellites;
+    std::vector<GroundStationEntry> ground_stations;
+    std::vector<IslEntry> isls;
+    std::vector<std::tuple<int32_t, double>> gsl_if_info;  // (number of GSL interfaces, aggregate bandwidth) per node
+    std::vector<Interface> gsl_interfaces;                 // In the order of creation by GSLHelper::Install()
+
+private:
+    static const char* MAGIC;
+    static const uint32_t VERSION;
+
+};
+
+}
+
+#endif //TOPOLOGY_SATELLITE_NETWORK_SNAPSHOT_H
@@ -20,6 +20,8 @@
  */
 
 #include "topology-satellite-network.h"
+#include <fstream>
+#include <unistd.h>
 
 namespace ns3 {
 
@@ -43,28 +45,162 @@ namespace ns3 {
         m_satellite_network_dir = m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("satellite_network_dir");
         m_satellite_network_routes_dir =  m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("satellite_network_routes_dir");
         m_satellite_network_force_static = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_force_static", "false"));
+        std::string snapshot_filename = m_basicSimulation->GetConfigParamOrDefault("satellite_network_snapshot_filename", "");
+        m_satellite_network_snapshot_filename = snapshot_filename.empty() ? "" : m_basicSimulation->GetRunDir() + "/" + snapshot_filename;
+
+        // Precomputed satellite trajectories (0 = positions propagated on every call)
+        m_satellite_ephemeris_step_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("satellite_ephemeris_step_ns", "0"));
+        std::string ephemeris_storage = m_basicSimulation->GetConfigParamOrDefault("satellite_ephemeris_storage", "float64");
+        if (ephemeris_storage == "float64") {
+            m_satellite_ephemeris_storage = SatelliteEphemeris::STORAGE_FLOAT64;
+        } else if (ephemeris_storage == "float32") {
+            m_satellite_ephemeris_storage = SatelliteEphemeris::STORAGE_FLOAT32;
+        } else if (ephemeris_storage == "int32_mm") {
+            m_satellite_ephemeris_storage = SatelliteEphemeris::STORAGE_INT32_MM;
+        } else {
+            throw std::runtime_error(format_string("Invalid satellite ephemeris storage: %s (must be float64, float32 or int32_mm)", ephemeris_storage.c_str()));
+        }
+        m_satellite_ephemeris_num_threads = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("satellite_ephemeris_num_threads", "0"));
+
+        // GSL utilization tracking
+        m_enable_gsl_utilization_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_gsl_utilization_tracking", "false"));
+        if (m_enable_gsl_utilization_tracking) {
+            m_gsl_utilization_tracking_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("gsl_utilization_tracking_interval_ns"));
+
+            // Same quantization as the ISLs unless set separately
+            m_gsl_utilization_tracking_quantization_levels = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault(
+                    "gsl_utilization_tracking_quantization_levels",
+                    m_basicSimulation->GetConfigParamOrDefault("isl_utilization_tracking_quantization_levels", "0")
+            ));
+        }
+
+        // Queue occupancy tracking (ISL and GSL devices)
+        m_enable_queue_occupancy_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_queue_occupancy_tracking", "false"));
+        if (m_enable_queue_occupancy_tracking) {
+            m_queue_occupancy_tracking_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("queue_occupancy_tracking_interval_ns"));
+            if (m_queue_occupancy_tracking_interval_ns == 0) {
+                throw std::runtime_error("Queue occupancy tracking interval must be positive");
+            }
+        }
+
+        // Packet event tracing (binary records of all ISL and GSL devices)
+        m_enable_packet_event_tracing = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_packet_event_tracing", "false"));
+        if (m_enable_packet_event_tracing) {
+            m_packet_event_tracing_buffer_size = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("packet_event_tracing_buffer_size", "1048576"));
+        }
+
+        // Utilization statistics output (0 threads: as many as there are hardware threads)
+        m_utilization_statistics_num_threads = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("utilization_statistics_num_threads", "0"));
+        m_utilization_binary_output = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("utilization_binary_output", "false"));
     }
 
     void
     TopologySatelliteNetwork::Build(const Ipv4RoutingHelper& ipv4RoutingHelper) {
         std::cout << "SATELLITE NETWORK" << std::endl;
 
+        // Link settings
+        m_isl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("isl_data_rate_megabit_per_s"));
+        m_gsl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("gsl_data_rate_megabit_per_s"));
+        m_isl_max_queue_size_pkts = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("isl_max_queue_size_pkts"));
+        m_gsl_max_queue_size_pkts = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("gsl_max_queue_size_pkts"));
+        m_gsl_voq_scheduler = m_basicSimulation->GetConfigParamOrDefault("gsl_voq_scheduler", "none");
+        if (m_gsl_voq_scheduler != "none" && m_gsl_voq_scheduler != "rr" && m_gsl_voq_scheduler != "drr") {
+            throw std::runtime_error(format_string("Invalid GSL VOQ scheduler: %s (must be none, rr or drr)", m_gsl_voq_scheduler.c_str()));
+        }
+        m_link_framing = m_basicSimulation->GetConfigParamOrDefault("link_framing", "ppp");
+        if (m_link_framing != "ppp" && m_link_framing != "none") {
+            throw std::runtime_error(format_string("Invalid link framing: %s (must be ppp or none)", m_link_framing.c_str()));
+        }
+
+        // Utilization tracking settings
+        m_enable_isl_utilization_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrFail("enable_isl_utilization_tracking"));
+        if (m_enable_isl_utilization_tracking) {
+            m_isl_utilization_tracking_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("isl_utilization_tracking_interval_ns"));
+
+            // Consecutive intervals with the same (quantized) utilization are merged as it goes,
+            // and the merged segments are optionally written out periodically to bound memory
+            m_isl_utilization_tracking_quantization_levels = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("isl_utilization_tracking_quantization_levels", "0"));
+            m_isl_utilization_tracking_flush_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("isl_utilization_tracking_flush_interval_ns", "0"));
+            if (m_isl_utilization_tracking_flush_interval_ns > 0) {
+                Simulator::Schedule(NanoSeconds(m_isl_utilization_tracking_flush_interval_ns), &TopologySatelliteNetwork::FlushUtilization, this);
+            }
+        }
+
+        // Propagation delay cache (0 = delay calculated for every packet)
+        m_delay_cache_tolerance_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("satellite_network_delay_cache_tolerance_ns", "0"));
+
+        // Packets are moved to the receiving device instead of copied on every hop
+        m_zero_copy = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_zero_copy", "false"));
+
+        // Satellites only forward, so they can be given only the IPv4 forwarding part of the stack
+        m_lightweight_satellite_stacks = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_lightweight_satellite_stacks", "false"));
+
+        if (m_satellite_network_snapshot_filename.empty()) {
+
+            // Without a snapshot file, it is always built from the network inputs
+            BuildFromInputs(ipv4RoutingHelper);
+
+        } else {
+
+            // The snapshot can only be used if it was made from the exact same network inputs
+            uint64_t fingerprint = TopologySatelliteNetworkSnapshot::ComputeFingerprint(m_satellite_network_dir, m_satellite_network_force_static);
+            TopologySatelliteNetworkSnapshot snapshot;
+            if (snapshot.Read(m_satellite_network_snapshot_filename) && snapshot.fingerprint == fingerprint) {
+                std::cout << "  > Building from snapshot: " << m_satellite_network_snapshot_filename << std::endl;
+                BuildFromSnapshot(ipv4RoutingHelper, snapshot);
+            } else {
+                std::cout << "  > Snapshot is missing or stale, building from the network inputs" << std::endl;
+                BuildFromInputs(ipv4RoutingHelper);
+                WriteSnapshot(fingerprint);
+                std::cout << "  > Written snapshot: " << m_satellite_network_snapshot_filename << std::endl;
+            }
+
+        }
+        // GSL utilization tracking
+        if (m_enable_gsl_utilization_tracking) {
+            for (uint32_t i = 0; i < m_gslNetDevices.GetN(); i++) {
+                m_gslNetDevices.Get(i)->GetObject<GSLNetDevice>()->EnableUtilizationTracking(m_gsl_utilization_tracking_interval_ns, m_gsl_utilization_tracking_quantization_levels);
+            }
+        }
+
+        // Queue occupancy tracking
+        if (m_enable_queue_occupancy_tracking) {
+            m_queue_occupancy_prev.assign(m_islPairNetDevices.GetN() + m_gslNetDevices.GetN(), std::make_pair(0, 0));
+            Simulator::Schedule(NanoSeconds(m_queue_occupancy_tracking_interval_ns), &TopologySatelliteNetwork::SampleQueueOccupancy, this);
+        }
+
+        // Packet event tracing
+        if (m_enable_packet_event_tracing) {
+            EnablePacketEventTracing();
+        }
+
+        // Lookahead of the distributed simulation
+        if (MpiInterface::IsEnabled() && MpiInterface::GetSize() > 1) {
+            ConfigureDistributedLookahead();
+        }
+
+        m_basicSimulation->RegisterTimestamp("Build satellite network topology");
+
+        std::cout << std::endl;
+
+    }
+
+    void
+    TopologySatelliteNetwork::BuildFromInputs(const Ipv4RoutingHelper& ipv4RoutingHelper) {
+
         // Initialize satellites
         ReadSatellites();
-        std::cout << "  > Number of satellites........ " << m_satelliteNodes.GetN() << std::endl;
 
         // Initialize ground stations
         ReadGroundStations();
-        std::cout << "  > Number of ground stations... " << m_groundStationNodes.GetN() << std::endl;
 
-        // Only ground stations are valid endpoints
-        for (uint32_t i = 0; i < m_groundStations.size(); i++) {
-            m_endpoints.insert(m_satelliteNodes.GetN() + i);
-        }
+        // Create their nodes
+        CreateNodes();
+        std::cout << "  > Number of satellites........ " << m_satelliteNodes.GetN() << std::endl;
+        std::cout << "  > Number of ground stations... " << m_groundStationNodes.GetN() << std::endl;
 
-        // All nodes
-        m_allNodes.Add(m_satelliteNodes);
-        m_allNodes.Add(m_groundStationNodes);
+        // All nodes and endpoints
+        CollectNodesAndEndpoints();
         std::cout << "  > Number of nodes............. " << m_allNodes.GetN() << std::endl;
 
         // Install internet stacks on all nodes
@@ -74,18 +210,6 @@ namespace ns3 {
         // IP helper
         m_ipv4_helper.SetBase ("10.0.0.0", "255.255.255.0");
 
-        // Link settings
-        m_isl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("isl_data_rate_megabit_per_s"));
-        m_gsl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("gsl_data_rate_megabit_per_s"));
-        m_isl_max_queue_size_pkts = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("isl_max_queue_size_pkts"));
-        m_gsl_max_queue_size_pkts = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("gsl_max_queue_size_pkts"));
-
-        // Utilization tracking settings
-        m_enable_isl_utilization_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrFail("enable_isl_utilization_tracking"));
-        if (m_enable_isl_utilization_tracking) {
-            m_isl_utilization_tracking_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("isl_utilization_tracking_interval_ns"));
-        }
-
         // Create ISLs
         std::cout << "  > Reading and creating ISLs" << std::endl;
         ReadISLs();
@@ -94,11 +218,92 @@ namespace ns3 {
         std::cout << "  > Creating GSLs" << std::endl;
         CreateGSLs();
 
+        // Lookup tables of the interfaces
+        m_nodeInterfaceTable = Create<NodeInterfaceTable>(m_allNodes);
+
         // ARP caches
         std::cout << "  > Populating ARP caches" << std::endl;
         PopulateArpCaches();
 
-        std::cout << std::endl;
+    }
+
+    void
+    TopologySatelliteNetwork::BuildFromSnapshot(const Ipv4RoutingHelper& ipv4RoutingHelper, const TopologySatelliteNetworkSnapshot& snapshot) {
+
+        // Satellites
+        for (const TopologySatelliteNetworkSnapshot::SatelliteEntry& entry : snapshot.satellites) {
+            AddSatellite(entry.name, entry.tle1, entry.tle2);
+        }
+
+        // Ground stations
+        for (const TopologySatelliteNetworkSnapshot::GroundStationEntry& entry : snapshot.ground_stations) {
+            AddGroundStation(
+                    entry.gid, entry.name, entry.latitude, entry.longitude, entry.elevation,
+                    Vector(entry.cartesian_x, entry.cartesian_y, entry.cartesian_z)
+            );
+        }
+
+        // Create their nodes
+        CreateNodes();
+        std::cout << "  > Number of satellites........ " << m_satelliteNodes.GetN() << std::endl;
+        std::cout << "  > Number of ground stations... " << m_groundStationNodes.GetN() << std::endl;
+
+        // All nodes and endpoints
+        CollectNodesAndEndpoints();
+        std::cout << "  > Number of nodes............. " << m_allNodes.GetN() << std::endl;
+
+        // Install internet stacks on all nodes
+        InstallInternetStacks(ipv4RoutingHelper);
+        std::cout << "  > Installed Internet stacks" << std::endl;
+
+        // ISLs: the addresses are added directly, there is no need for the
+        // address helper nor for the traffic control layer install/uninstall
+        std::cout << "  > Creating ISLs" << std::endl;
+        PointToPointLaserHelper p2p_laser_helper;
+        ConfigureIslHelper(p2p_laser_helper);
+        for (const TopologySatelliteNetworkSnapshot::IslEntry& entry : snapshot.isls) {
+            NodeContainer c;
+            c.Add(m_satelliteNodes.Get(entry.sat0_id));
+            c.Add(m_satelliteNodes.Get(entry.sat1_id));
+            NetDeviceContainer netDevices = p2p_laser_helper.Install(c);
+            AssignInterfaceAddress(netDevices.Get(0), entry.if0);
+            AssignInterfaceAddress(netDevices.Get(1), entry.if1);
+            RegisterIsl(entry.sat0_id, entry.sat1_id, netDevices);
+        }
+        std::cout << "    >> Created " << std::to_string(snapshot.isls.size()) << " ISL(s)" << std::endl;
+
+        // GSLs
+        std::cout << "  > Creating GSLs" << std::endl;
+        GSLHelper gsl_helper;
+        ConfigureGslHelper(gsl_helper);
+        m_gslIfInfo = snapshot.gsl_if_info;
+        m_gslNetDevices = gsl_helper.Install(m_satelliteNodes, m_groundStationNodes, m_gslIfInfo);
+        NS_ABORT_MSG_IF(m_gslNetDevices.GetN() != snapshot.gsl_interfaces.size(), "Not the expected amount of interfaces has been created.");
+        for (uint32_t i = 0; i < m_gslNetDevices.GetN(); i++) {
+            AssignInterfaceAddress(m_gslNetDevices.Get(i), snapshot.gsl_interfaces.at(i));
+        }
+        std::cout << "    >> GSL interfaces are setup" << std::endl;
+
+        // Lookup tables of the interfaces
+        m_nodeInterfaceTable = Create<NodeInterfaceTable>(m_allNodes);
+
+        // ARP caches
+        std::cout << "  > Populating ARP caches" << std::endl;
+        PopulateArpCachesFromSnapshot(snapshot);
+
+    }
+
+    void
+    TopologySatelliteNetwork::CollectNodesAndEndpoints() {
+
+        // Only ground stations are valid endpoints
+        for (uint32_t i = 0; i < m_groundStations.size(); i++) {
+            m_endpoints.insert(m_satelliteNodes.GetN() + i);
+        }
+
+        // All nodes
+        m_allNodes.Add(m_satelliteNodes);
+        m_allNodes.Add(m_groundStationNodes);
 
     }
 
@@ -119,10 +324,7 @@ namespace ns3 {
         int64_t num_orbits = parse_positive_int64(res[0]);
         int64_t satellites_per_orbit = parse_positive_int64(res[1]);
 
-        // Create the nodes
-        m_satelliteNodes.Create(num_orbits * satellites_per_orbit);
-
-        // Associate satellite mobility model with each node
+        // Read each satellite
         int64_t counter = 0;
         std::string name, tle1, tle2;
         while (std::getline(fs, name)) {
@@ -135,44 +337,99 @@ namespace ns3 {
             // <TLE line 2>
 
             // Create satellite
-            Ptr<Satellite> satellite = CreateObject<Satellite>();
-            satellite->SetName(name);
-            satellite->SetTleInfo(tle1, tle2);
+            AddSatellite(name, tle1, tle2);
 
-            // Decide the mobility model of the satellite
-            MobilityHelper mobility;
-            if (m_satellite_network_force_static) {
+            counter++;
+        }
 
-                // Static at the start of the epoch
-                mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-                mobility.Install(m_satelliteNodes.Get(counter));
-                Ptr<MobilityModel> mobModel = m_satelliteNodes.Get(counter)->GetObject<MobilityModel>();
-                mobModel->SetPosition(satellite->GetPosition(satellite->GetTleEpoch()));
+        // Check that exactly that number of satellites has been read in
+        if (counter != num_orbits * satellites_per_orbit) {
+            throw std::runtime_error("Number of satellites defined in the TLEs does not match");
+        }
 
-            } else {
+        fs.close();
+    }
 
-                // Dynamic
-                mobility.SetMobilityModel(
-                        "ns3::SatellitePositionMobilityModel",
-                        "SatellitePositionHelper",
-                        SatellitePositionHelperValue(SatellitePositionHelper(satellite))
-                );
-                mobility.Install(m_satelliteNodes.Get(counter));
+    void
+    TopologySatelliteNetwork::AddSatellite(const std::string& name, const std::string& tle1, const std::string& tle2)
+    {
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName(name);
+        satellite->SetTleInfo(tle1, tle2);
+        m_satellites.push_back(satellite);
+    }
 
+    void
+    TopologySatelliteNetwork::PrecomputeSatelliteEphemerides()
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        // Worker threads take the next satellite until all are sampled. Each satellite is
+        // only touched by the thread which samples it (including its reference count),
+        // and its ephemeris propagates a copy of its SGP4 record.
+        size_t num_satellites = m_satellites.size();
+        uint32_t num_threads = m_satellite_ephemeris_num_threads != 0 ? m_satellite_ephemeris_num_threads : std::max(1u, std::thread::hardware_concurrency());
+        num_threads = (uint32_t) std::max((size_t) 1, std::min((size_t) num_threads, num_satellites));
+        m_satellite_ephemerides.assign(num_satellites, Ptr<SatelliteEphemeris>());
+        Time step = NanoSeconds(m_satellite_ephemeris_step_ns);
+        Time duration = NanoSeconds(m_basicSimulation->GetSimulationEndTimeNs());
+        std::atomic<size_t> next_satellite(0);
+        auto sample_satellites = [&]() {
+            size_t i;
+            while ((i = next_satellite.fetch_add(1)) < num_satellites) {
+                m_satellite_ephemerides[i] = Create<SatelliteEphemeris>(
+                        m_satellites[i], m_satellites[i]->GetTleEpoch(), step, duration, m_satellite_ephemeris_storage
+                );
             }
+        };
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < num_threads; t++) {
+            threads.emplace_back(sample_satellites);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
 
-            // Add to all satellites present
-            m_satellites.push_back(satellite);
-
-            counter++;
+        uint64_t num_bytes = 0;
+        for (const Ptr<SatelliteEphemeris>& ephemeris : m_satellite_ephemerides) {
+            num_bytes += ephemeris->GetMemoryBytes();
         }
+        double duration_s = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+        std::cout << "  > Precomputed satellite ephemerides (" << num_bytes / 1000000.0 << " MB) in "
+                  << duration_s << " s with " << num_threads << " threads" << std::endl;
+    }
+
+    void
+    TopologySatelliteNetwork::InstallSatelliteMobility(uint32_t sat_id)
+    {
+        Ptr<Satellite> satellite = m_satellites.at(sat_id);
+
+        // Decide the mobility model of the satellite
+        MobilityHelper mobility;
+        if (m_satellite_network_force_static) {
+
+            // Static at the start of the epoch
+            mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+            mobility.Install(m_satelliteNodes.Get(sat_id));
+            Ptr<MobilityModel> mobModel = m_satelliteNodes.Get(sat_id)->GetObject<MobilityModel>();
+            mobModel->SetPosition(satellite->GetPosition(satellite->GetTleEpoch()));
+
+        } else {
+
+            // Dynamic, optionally from its precomputed trajectory
+            SatellitePositionHelper position_helper(satellite);
+            if (!m_satellite_ephemerides.empty()) {
+                position_helper.SetEphemeris(m_satellite_ephemerides.at(sat_id));
+            }
+            mobility.SetMobilityModel(
+                    "ns3::SatellitePositionMobilityModel",
+                    "SatellitePositionHelper",
+                    SatellitePositionHelperValue(position_helper)
+            );
+            mobility.Install(m_satelliteNodes.Get(sat_id));
 
-        // Check that exactly that number of satellites has been read in
-        if (counter != num_orbits * satellites_per_orbit) {
-            throw std::runtime_error("Number of satellites defined in the TLEs does not match");
         }
 
-        fs.close();
     }
 
     void
@@ -201,35 +458,142 @@ namespace ns3 {
             double cartesian_z = parse_double(res[7]);
             Vector cartesian_position(cartesian_x, cartesian_y, cartesian_z);
 
-            // Create ground station data holder
-            Ptr<GroundStation> gs = CreateObject<GroundStation>(
-                    gid, name, latitude, longitude, elevation, cartesian_position
-            );
-            m_groundStations.push_back(gs);
+            // Create ground station
+            AddGroundStation(gid, name, latitude, longitude, elevation, cartesian_position);
+
+        }
+
+        fs.close();
+    }
+
+    void
+    TopologySatelliteNetwork::AddGroundStation(
+            uint32_t gid, const std::string& name,
+            double latitude, double longitude, double elevation,
+            Vector cartesian_position
+    ) {
+
+        // Create ground station data holder
+        if (gid != m_groundStations.size()) {
+            throw std::runtime_error("GID is not incremented each line");
+        }
+        Ptr<GroundStation> gs = CreateObject<GroundStation>(
+                gid, name, latitude, longitude, elevation, cartesian_position
+        );
+        m_groundStations.push_back(gs);
+
+    }
 
-            // Create the node
-            m_groundStationNodes.Create(1);
-            if (m_groundStationNodes.GetN() != gid + 1) {
-                throw std::runtime_error("GID is not incremented each line");
+    void
+    TopologySatelliteNetwork::CreateNodes() {
+
+        // In a distributed simulation, each node belongs to the system (rank) which simulates it,
+        // which must be known when the node is created
+        std::vector<uint32_t> satellite_system_ids(m_satellites.size(), 0);
+        std::vector<uint32_t> ground_station_system_ids(m_groundStations.size(), 0);
+        if (MpiInterface::IsEnabled() && MpiInterface::GetSize() > 1) {
+            SatelliteNetworkPartitioner partitioner(MpiInterface::GetSize());
+            satellite_system_ids = partitioner.AssignSatellites(m_satellites);
+            std::vector<Vector> ground_station_positions;
+            for (Ptr<GroundStation> gs : m_groundStations) {
+                ground_station_positions.push_back(gs->GetCartesianPosition());
             }
+            ground_station_system_ids = partitioner.AssignGroundStations(ground_station_positions);
+            std::cout << "  > Partitioned over " << MpiInterface::GetSize() << " systems (this is system " << MpiInterface::GetSystemId() << ")" << std::endl;
+        }
 
-            // Install the constant mobility model on the node
+        // Satellite nodes with their mobility model
+        if (m_satellite_ephemeris_step_ns > 0 && !m_satellite_network_force_static) {
+            PrecomputeSatelliteEphemerides();
+        }
+        for (uint32_t i = 0; i < m_satellites.size(); i++) {
+            m_satelliteNodes.Create(1, satellite_system_ids.at(i));
+            InstallSatelliteMobility(i);
+        }
+
+        // Ground station nodes with their constant mobility model
+        for (uint32_t i = 0; i < m_groundStations.size(); i++) {
+            m_groundStationNodes.Create(1, ground_station_system_ids.at(i));
             MobilityHelper mobility;
             mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-            mobility.Install(m_groundStationNodes.Get(gid));
-            Ptr<MobilityModel> mobilityModel = m_groundStationNodes.Get(gid)->GetObject<MobilityModel>();
-            mobilityModel->SetPosition(cartesian_position);
-
+            mobility.Install(m_groundStationNodes.Get(i));
+            Ptr<MobilityModel> mobilityModel = m_groundStationNodes.Get(i)->GetObject<MobilityModel>();
+            mobilityModel->SetPosition(m_groundStations.at(i)->GetCartesianPosition());
         }
 
-        fs.close();
+    }
+
+    /**
+     * Current resident set size of this process in bytes (0 if it cannot be read).
+     */
+    static int64_t GetResidentSetSizeBytes() {
+        std::ifstream fs("/proc/self/statm");
+        int64_t size_pages = 0;
+        int64_t resident_pages = 0;
+        if (!(fs >> size_pages >> resident_pages)) {
+            return 0;
+        }
+        return resident_pages * sysconf(_SC_PAGESIZE);
     }
 
     void
     TopologySatelliteNetwork::InstallInternetStacks(const Ipv4RoutingHelper& ipv4RoutingHelper) {
+
+        // Satellites
+        int64_t rss_before_bytes = GetResidentSetSizeBytes();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (m_lightweight_satellite_stacks) {
+            for (uint32_t i = 0; i < m_satelliteNodes.GetN(); i++) {
+                InstallForwardingOnlyStack(m_satelliteNodes.Get(i), ipv4RoutingHelper);
+            }
+        } else {
+            InternetStackHelper internet;
+            internet.SetRoutingHelper(ipv4RoutingHelper);
+            internet.Install(m_satelliteNodes);
+        }
+        double satellite_s = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+        int64_t satellite_rss_bytes = GetResidentSetSizeBytes() - rss_before_bytes;
+
+        // Ground stations (always the full stack, they are the endpoints)
+        rss_before_bytes = GetResidentSetSizeBytes();
+        start = std::chrono::steady_clock::now();
         InternetStackHelper internet;
         internet.SetRoutingHelper(ipv4RoutingHelper);
-        internet.Install(m_allNodes);
+        internet.Install(m_groundStationNodes);
+        double ground_station_s = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+        int64_t ground_station_rss_bytes = GetResidentSetSizeBytes() - rss_before_bytes;
+
+        // Report, with the savings estimated from the cost per ground station of the full stack
+        uint32_t num_satellites = m_satelliteNodes.GetN();
+        uint32_t num_ground_stations = m_groundStationNodes.GetN();
+        std::cout << "  > Internet stacks (satellites: " << (m_lightweight_satellite_stacks ? "forwarding only" : "full") << ")" << std::endl;
+        std::cout << "    >> Satellites.............. " << satellite_s << " s, " << satellite_rss_bytes / 1e6 << " MB RSS" << std::endl;
+        std::cout << "    >> Ground stations......... " << ground_station_s << " s, " << ground_station_rss_bytes / 1e6 << " MB RSS" << std::endl;
+        if (m_lightweight_satellite_stacks && num_satellites > 0 && num_ground_stations > 0) {
+            double full_satellite_s = ground_station_s / num_ground_stations * num_satellites;
+            double full_satellite_rss_bytes = (double) ground_station_rss_bytes / num_ground_stations * num_satellites;
+            std::cout << "    >> Saved (estimate)........ " << full_satellite_s - satellite_s << " s, "
+                      << (full_satellite_rss_bytes - satellite_rss_bytes) / 1e6 << " MB RSS" << std::endl;
+        }
+
+    }
+
+    void
+    TopologySatelliteNetwork::InstallForwardingOnlyStack(Ptr<Node> node, const Ipv4RoutingHelper& ipv4RoutingHelper) {
+        NS_ABORT_MSG_IF(node->GetObject<Ipv4>() != 0, "Node " << node->GetId() << " already has an IPv4 stack");
+
+        // IPv4 with ARP, and ICMP which IPv4 uses to report an expired TTL while forwarding
+        node->AggregateObject(CreateObject<ArpL3Protocol>());
+        node->AggregateObject(CreateObject<Ipv4L3Protocol>());
+        node->AggregateObject(CreateObject<Icmpv4L4Protocol>());
+        node->GetObject<Ipv4>()->SetRoutingProtocol(ipv4RoutingHelper.Create(node));
+
+        // The traffic control layer sits between IPv4 (and ARP) and the network devices
+        node->AggregateObject(CreateObject<TrafficControlLayer>());
+        node->GetObject<ArpL3Protocol>()->SetTrafficControl(node->GetObject<TrafficControlLayer>());
+
+        // No IPv6, UDP, TCP or packet sockets: nothing is sent from or received by a satellite
+
     }
 
     void
@@ -238,11 +602,7 @@ namespace ns3 {
 
         // Link helper
         PointToPointLaserHelper p2p_laser_helper;
-        std::string max_queue_size_str = format_string("%" PRId64 "p", m_isl_max_queue_size_pkts);
-        p2p_laser_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize(max_queue_size_str)));
-        p2p_laser_helper.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (std::to_string(m_isl_data_rate_megabit_per_s) + "Mbps")));
-        std::cout << "    >> ISL data rate........ " << m_isl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
-        std::cout << "    >> ISL max queue size... " << m_isl_max_queue_size_pkts << " packets" << std::endl;
+        ConfigureIslHelper(p2p_laser_helper);
 
         // Traffic control helper
         TrafficControlHelper tch_isl;
@@ -284,16 +644,8 @@ namespace ns3 {
             tch_uninstaller.Uninstall(netDevices.Get(0));
             tch_uninstaller.Uninstall(netDevices.Get(1));
 
-            // Utilization tracking
-            if (m_enable_isl_utilization_tracking) {
-                netDevices.Get(0)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns);
-                netDevices.Get(1)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns);
-
-                m_islNetDevices.Add(netDevices.Get(0));
-                m_islFromTo.push_back(std::make_pair(sat0_id, sat1_id));
-                m_islNetDevices.Add(netDevices.Get(1));
-                m_islFromTo.push_back(std::make_pair(sat1_id, sat0_id));
-            }
+            // Keep track of the ISL (and its utilization)
+            RegisterIsl(sat0_id, sat1_id, netDevices);
 
             counter += 1;
         }
@@ -304,16 +656,151 @@ namespace ns3 {
 
     }
 
+    void
+    TopologySatelliteNetwork::ConfigureIslHelper(PointToPointLaserHelper& p2p_laser_helper) {
+        std::string max_queue_size_str = format_string("%" PRId64 "p", m_isl_max_queue_size_pkts);
+        p2p_laser_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize(max_queue_size_str)));
+        p2p_laser_helper.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (std::to_string(m_isl_data_rate_megabit_per_s) + "Mbps")));
+        std::cout << "    >> ISL data rate........ " << m_isl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
+        std::cout << "    >> ISL max queue size... " << m_isl_max_queue_size_pkts << " packets" << std::endl;
+        if (m_link_framing == "none") {
+            p2p_laser_helper.SetDeviceAttribute("Framing", EnumValue(PointToPointLaserNetDevice::FRAMING_NONE));
+            std::cout << "    >> ISL framing.......... none (IP only)" << std::endl;
+        }
+        if (m_delay_cache_tolerance_ns > 0) {
+            p2p_laser_helper.SetChannelAttribute("DelayCacheTolerance", TimeValue(NanoSeconds(m_delay_cache_tolerance_ns)));
+
+            // Within a quantum, both ends can move towards or away from each other at most at the maximum speed
+            double max_error_ns = m_delay_cache_tolerance_ns * 2.0 * GetMaxSatelliteSpeedMetersPerSecond() / 299792458.0;
+            std::cout << "    >> ISL delay cache...... " << m_delay_cache_tolerance_ns << " ns (max. delay error: " << max_error_ns << " ns)" << std::endl;
+        }
+        if (m_zero_copy) {
+            p2p_laser_helper.SetChannelAttribute("ZeroCopy", BooleanValue(true));
+            std::cout << "    >> ISL zero-copy........ enabled" << std::endl;
+        }
+    }
+
+    double
+    TopologySatelliteNetwork::GetMaxSatelliteSpeedMetersPerSecond() {
+        double max_speed_m_per_s = 0.0;
+        for (Ptr<Satellite> satellite : m_satellites) {
+            Vector velocity = satellite->GetVelocity(satellite->GetTleEpoch());
+            max_speed_m_per_s = std::max(max_speed_m_per_s, CalculateDistance(Vector(0, 0, 0), velocity));
+        }
+        return max_speed_m_per_s;
+    }
+
+    void
+    TopologySatelliteNetwork::ConfigureDistributedLookahead() {
+        std::cout << "  > Distributed lookahead" << std::endl;
+        const double speed_of_light_m_per_s = 299792458.0;
+
+        // GSL: closest a satellite can come is its perigee, and the furthest a ground station is from the
+        // center of the Earth is its own position. SGP4 oscillates around the mean orbit, which the
+        // perigee is of, so a margin is taken.
+        double min_perigee_radius_m = std::numeric_limits<double>::max();
+        for (Ptr<Satellite> satellite : m_satellites) {
+            min_perigee_radius_m = std::min(min_perigee_radius_m, satellite->GetPerigeeRadius());
+        }
+        double max_ground_station_radius_m = 0.0;
+        for (Ptr<GroundStation> gs : m_groundStations) {
+            max_ground_station_radius_m = std::max(max_ground_station_radius_m, CalculateDistance(Vector(0, 0, 0), gs->GetCartesianPosition()));
+        }
+        double min_gsl_distance_m = min_perigee_radius_m - 25000.0 - max_ground_station_radius_m;
+        std::cout << "    >> Minimum GSL distance........ " << min_gsl_distance_m << " m" << std::endl;
+
+        // ISL: the distance of each ISL is sampled every second over the simulation. In between samples,
+        // the two satellites can at most come closer by the maximum speed for half a second each.
+        int64_t sample_interval_ns = 1000000000;
+        int64_t sample_until_ns = m_satellite_network_force_static ? 0 : m_basicSimulation->GetSimulationEndTimeNs();
+        double min_isl_distance_m = std::numeric_limits<double>::max();
+        for (int64_t t = 0; t <= sample_until_ns + sample_interval_ns / 2; t += sample_interval_ns) {
+            for (const std::pair<int32_t, int32_t>& isl : m_islPairs) {
+                Ptr<Satellite> sat0 = m_satellites.at(isl.first);
+                Ptr<Satellite> sat1 = m_satellites.at(isl.second);
+                double distance_m = CalculateDistance(
+                        sat0->GetPosition(sat0->GetTleEpoch() + NanoSeconds(t)),
+                        sat1->GetPosition(sat1->GetTleEpoch() + NanoSeconds(t))
+                );
+                min_isl_distance_m = std::min(min_isl_distance_m, distance_m);
+            }
+        }
+        if (!m_islPairs.empty()) {
+            if (!m_satellite_network_force_static) {
+                min_isl_distance_m -= GetMaxSatelliteSpeedMetersPerSecond() * sample_interval_ns / 1e9;
+            }
+            std::cout << "    >> Minimum ISL distance........ " << min_isl_distance_m << " m" << std::endl;
+        }
+
+        // How the nodes are spread over the systems
+        std::vector<uint32_t> satellite_system_ids;
+        for (uint32_t i = 0; i < m_satelliteNodes.GetN(); i++) {
+            satellite_system_ids.push_back(m_satelliteNodes.Get(i)->GetSystemId());
+        }
+        std::vector<uint32_t> ground_station_system_ids;
+        for (uint32_t i = 0; i < m_groundStationNodes.GetN(); i++) {
+            ground_station_system_ids.push_back(m_groundStationNodes.Get(i)->GetSystemId());
+        }
+        SatelliteNetworkPartitioner::PrintStatistics(
+                SatelliteNetworkPartitioner::Evaluate(MpiInterface::GetSize(), satellite_system_ids, ground_station_system_ids, m_islPairs),
+                "    >> "
+        );
+
+        // Lookahead is the smallest delay with which a packet can arrive at another system
+        double min_distance_m = std::min(min_gsl_distance_m, min_isl_distance_m);
+        NS_ABORT_MSG_IF(min_distance_m <= 0, "No positive lower bound on the link distance: a lookahead cannot be derived");
+        Time lookahead = Seconds(min_distance_m / speed_of_light_m_per_s);
+        std::cout << "    >> Lookahead................... " << lookahead.GetNanoSeconds() << " ns" << std::endl;
+
+        // The distributed simulator only derives its lookahead from the Delay attribute of the point-to-point
+        // channels crossing systems, as such the GSL bound is also applied to the ISL channels
+        bool has_remote_isl = false;
+        for (uint32_t i = 0; i < m_islPairNetDevices.GetN(); i += 2) {
+            Ptr<NetDevice> dev0 = m_islPairNetDevices.Get(i);
+            Ptr<NetDevice> dev1 = m_islPairNetDevices.Get(i + 1);
+            dev0->GetChannel()->SetAttribute("Delay", TimeValue(lookahead));
+            uint32_t system0 = dev0->GetNode()->GetSystemId();
+            uint32_t system1 = dev1->GetNode()->GetSystemId();
+            if (system0 != system1 && (system0 == MpiInterface::GetSystemId() || system1 == MpiInterface::GetSystemId())) {
+                has_remote_isl = true;
+            }
+        }
+        if (m_gslNetDevices.GetN() > 0) {
+            m_gslNetDevices.Get(0)->GetChannel()->SetAttribute("Delay", TimeValue(lookahead));
+        }
+        NS_ABORT_MSG_UNLESS(
+                has_remote_isl,
+                "System " << MpiInterface::GetSystemId() << " has no ISL to another system to give the lookahead to the distributed simulator"
+        );
+
+    }
+
+    void
+    TopologySatelliteNetwork::RegisterIsl(int32_t sat0_id, int32_t sat1_id, NetDeviceContainer netDevices) {
+
+        // All ISLs with their two network devices
+        m_islPairs.push_back(std::make_pair(sat0_id, sat1_id));
+        m_islPairNetDevices.Add(netDevices);
+
+        // Utilization tracking
+        if (m_enable_isl_utilization_tracking) {
+            netDevices.Get(0)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns, m_isl_utilization_tracking_quantization_levels);
+            netDevices.Get(1)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns, m_isl_utilization_tracking_quantization_levels);
+
+            m_islNetDevices.Add(netDevices.Get(0));
+            m_islFromTo.push_back(std::make_pair(sat0_id, sat1_id));
+            m_islNetDevices.Add(netDevices.Get(1));
+            m_islFromTo.push_back(std::make_pair(sat1_id, sat0_id));
+        }
+
+    }
+
     void
     TopologySatelliteNetwork::CreateGSLs() {
 
         // Link helper
         GSLHelper gsl_helper;
-        std::string max_queue_size_str = format_string("%" PRId64 "p", m_gsl_max_queue_size_pkts);
-        gsl_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize(max_queue_size_str)));
-        gsl_helper.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (std::to_string(m_gsl_data_rate_megabit_per_s) + "Mbps")));
-        std::cout << "    >> GSL data rate........ " << m_gsl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
-        std::cout << "    >> GSL max queue size... " << m_gsl_max_queue_size_pkts << " packets" << std::endl;
+        ConfigureGslHelper(gsl_helper);
 
         // Traffic control helper
         TrafficControlHelper tch_gsl;
@@ -353,6 +840,8 @@ namespace ns3 {
 
         // Create and install GSL network devices
         NetDeviceContainer devices = gsl_helper.Install(m_satelliteNodes, m_groundStationNodes, node_gsl_if_info);
+        m_gslIfInfo = node_gsl_if_info;
+        m_gslNetDevices = devices;
         std::cout << "    >> Finished install GSL interfaces (interfaces, network devices, one shared channel)" << std::endl;
 
         // Install queueing disciplines
@@ -410,77 +899,430 @@ namespace ns3 {
 
     }
 
+    void
+    TopologySatelliteNetwork::ConfigureGslHelper(GSLHelper& gsl_helper) {
+        std::string max_queue_size_str = format_string("%" PRId64 "p", m_gsl_max_queue_size_pkts);
+        gsl_helper.SetQueue("ns3::GSLQueue", "MaxSize", QueueSizeValue(QueueSize(max_queue_size_str)));
+        gsl_helper.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (std::to_string(m_gsl_data_rate_megabit_per_s) + "Mbps")));
+        std::cout << "    >> GSL data rate........ " << m_gsl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
+        std::cout << "    >> GSL max queue size... " << m_gsl_max_queue_size_pkts << " packets" << std::endl;
+        if (m_link_framing == "none") {
+            gsl_helper.SetDeviceAttribute("Framing", EnumValue(GSLNetDevice::FRAMING_NONE));
+            std::cout << "    >> GSL framing.......... none (IP only)" << std::endl;
+        }
+        if (m_gsl_voq_scheduler != "none") {
+
+            // A queue of the max. queue size per destination, served by the single transmitter
+            gsl_helper.SetDeviceAttribute("VoqScheduler", EnumValue(m_gsl_voq_scheduler == "rr" ? GSLNetDevice::VOQ_RR : GSLNetDevice::VOQ_DRR));
+            std::cout << "    >> GSL VOQ scheduler.... " << m_gsl_voq_scheduler << " (per-destination queues)" << std::endl;
+        }
+        if (m_delay_cache_tolerance_ns > 0) {
+            gsl_helper.SetChannelAttribute("DelayCacheTolerance", TimeValue(NanoSeconds(m_delay_cache_tolerance_ns)));
+
+            // Ground stations do not move, so only the satellite end contributes
+            double max_error_ns = m_delay_cache_tolerance_ns * GetMaxSatelliteSpeedMetersPerSecond() / 299792458.0;
+            std::cout << "    >> GSL delay cache...... " << m_delay_cache_tolerance_ns << " ns (max. delay error: " << max_error_ns << " ns)" << std::endl;
+        }
+        if (m_zero_copy) {
+            gsl_helper.SetChannelAttribute("ZeroCopy", BooleanValue(true));
+            std::cout << "    >> GSL zero-copy........ enabled" << std::endl;
+        }
+    }
+
+    void
+    TopologySatelliteNetwork::AssignInterfaceAddress(Ptr<NetDevice> device, const TopologySatelliteNetworkSnapshot::Interface& itf) {
+
+        // Must end up at the same node and interface as when the snapshot was made
+        NS_ABORT_MSG_IF(device->GetNode() != m_allNodes.Get(itf.node_id), "Snapshot interface is on a different node");
+        Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+        int32_t interface = ipv4->AddInterface(device);
+        NS_ABORT_MSG_IF(interface != (int32_t) itf.if_id, "Snapshot interface has a different interface index");
+
+        // Same as what Ipv4AddressHelper::Assign() does, without the conflict checks and queueing discipline
+        ipv4->AddAddress(interface, Ipv4InterfaceAddress(itf.ip, itf.mask));
+        ipv4->SetMetric(interface, 1);
+        ipv4->SetUp(interface);
+
+    }
+
+    TopologySatelliteNetworkSnapshot::Interface
+    TopologySatelliteNetwork::GetInterfaceRecord(uint32_t node_id, Ptr<NetDevice> device) {
+        Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+        int32_t if_id = ipv4->GetInterfaceForDevice(device);
+        Ipv4InterfaceAddress address = ipv4->GetAddress(if_id, 0);
+        return {node_id, (uint32_t) if_id, address.GetLocal(), address.GetMask()};
+    }
+
+    void
+    TopologySatelliteNetwork::WriteSnapshot(uint64_t fingerprint) {
+        TopologySatelliteNetworkSnapshot snapshot;
+        snapshot.fingerprint = fingerprint;
+
+        // Satellites
+        for (Ptr<Satellite> satellite : m_satellites) {
+            std::pair<std::string, std::string> tle = satellite->GetTleInfo();
+            snapshot.satellites.push_back({satellite->GetName(), tle.first, tle.second});
+        }
+
+        // Ground stations
+        for (Ptr<GroundStation> gs : m_groundStations) {
+            Vector cartesian_position = gs->GetCartesianPosition();
+            snapshot.ground_stations.push_back({
+                    gs->GetGid(), gs->GetName(), gs->GetLatitude(), gs->GetLongitude(), gs->GetElevation(),
+                    cartesian_position.x, cartesian_position.y, cartesian_position.z
+            });
+        }
+
+        // ISLs
+        for (size_t i = 0; i < m_islPairs.size(); i++) {
+            int32_t sat0_id = m_islPairs[i].first;
+            int32_t sat1_id = m_islPairs[i].second;
+            snapshot.isls.push_back({
+                    sat0_id, sat1_id,
+                    GetInterfaceRecord(sat0_id, m_islPairNetDevices.Get(2 * i)),
+                    GetInterfaceRecord(sat1_id, m_islPairNetDevices.Get(2 * i + 1))
+            });
+        }
+
+        // GSLs (devices are created in node order)
+        snapshot.gsl_if_info = m_gslIfInfo;
+        uint32_t device_idx = 0;
+        for (uint32_t node_id = 0; node_id < m_gslIfInfo.size(); node_id++) {
+            for (int32_t j = 0; j < std::get<0>(m_gslIfInfo[node_id]); j++) {
+                snapshot.gsl_interfaces.push_back(GetInterfaceRecord(node_id, m_gslNetDevices.Get(device_idx)));
+                device_idx++;
+            }
+        }
+
+        snapshot.Write(m_satellite_network_snapshot_filename);
+    }
+
     void
     TopologySatelliteNetwork::PopulateArpCaches() {
 
         // ARP lookups hinder performance, and actually won't succeed, so to prevent that from happening,
-        // all GSL interfaces' IPs are added into an ARP cache
+        // all GSL interfaces' IPs are added into an ARP cache. Only GSL network devices need ARP (ISL
+        // network devices are point-to-point), so ISL interfaces are neither added nor attached to it,
+        // which keeps the cache looked up for every packet sent over a GSL small.
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
         // ARP cache with all ground station and satellite GSL channel interface info
-        Ptr<ArpCache> arpAll = CreateObject<ArpCache>();
-        arpAll->SetAliveTimeout (Seconds(3600 * 24 * 365)); // Valid one year
+        Ptr<ArpCache> arpGsl = CreateObject<ArpCache>();
+        arpGsl->SetAliveTimeout (Seconds(3600 * 24 * 365)); // Valid one year
 
-        // Satellite ARP entries
+        // GSL interfaces of all nodes
+        uint32_t num_entries = 0;
         for (uint32_t i = 0; i < m_allNodes.GetN(); i++) {
+            for (size_t j = 1; j < m_nodeInterfaceTable->GetNInterfaces(i); j++) {
+                GSLNetDevice* gsl_device = m_nodeInterfaceTable->GetGslNetDevice(i, j);
+                if (gsl_device != nullptr) {
+
+                    // Add the info of the GSL interface to the cache
+                    ArpCache::Entry * entry = arpGsl->Add(m_nodeInterfaceTable->GetLocalAddress(i, j));
+                    entry->SetMacAddress(Mac48Address::ConvertFrom(gsl_device->GetAddress()));
+                    num_entries++;
+
+                    // Set a pointer to the ARP cache it should use (will be filled at the end of this function, it's only a pointer)
+                    m_nodeInterfaceTable->GetIpv4(i)->GetInterface(j)->SetAttribute("ArpCache", PointerValue(arpGsl));
+
+                }
+            }
+        }
+
+        double duration_s = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+        std::cout << "    >> ARP entries (GSL interfaces only)... " << num_entries << " in " << duration_s << " s" << std::endl;
+
+    }
 
-            // Information about all interfaces (TODO: Only needs to be GSL interfaces)
-            for (size_t j = 1; j < m_allNodes.Get(i)->GetObject<Ipv4>()->GetNInterfaces(); j++) {
-                Mac48Address mac48Address = Mac48Address::ConvertFrom(m_allNodes.Get(i)->GetObject<Ipv4>()->GetNetDevice(j)->GetAddress());
-                Ipv4Address ipv4Address = m_allNodes.Get(i)->GetObject<Ipv4>()->GetAddress(j, 0).GetLocal();
+    void
+    TopologySatelliteNetwork::PopulateArpCachesFromSnapshot(const TopologySatelliteNetworkSnapshot& snapshot) {
+
+        // Same as PopulateArpCaches(), but the IP addresses come directly from the snapshot
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Ptr<ArpCache> arpGsl = CreateObject<ArpCache>();
+        arpGsl->SetAliveTimeout (Seconds(3600 * 24 * 365)); // Valid one year
+
+        // Add each GSL interface to the cache
+        for (const TopologySatelliteNetworkSnapshot::Interface& itf : snapshot.gsl_interfaces) {
+            ArpCache::Entry * entry = arpGsl->Add(itf.ip);
+            entry->SetMacAddress(Mac48Address::ConvertFrom(m_nodeInterfaceTable->GetNetDevice(itf.node_id, itf.if_id)->GetAddress()));
+            m_nodeInterfaceTable->GetIpv4(itf.node_id)->GetInterface(itf.if_id)->SetAttribute("ArpCache", PointerValue(arpGsl));
+        }
+
+        double duration_s = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e9;
+        std::cout << "    >> ARP entries (GSL interfaces only)... " << snapshot.gsl_interfaces.size() << " in " << duration_s << " s" << std::endl;
+
+    }
+
+    void TopologySatelliteNetwork::WriteUtilizationSegments(FILE* file_utilization_bin, std::pair<int32_t, int32_t> src_dst, UtilizationTracker& tracker) {
+
+        // Binary record: <src (int32)><dst (int32)><interval start ns (int64)><interval end ns (int64)><utilization (double)>
+        for (const UtilizationTracker::Segment& segment : tracker.GetCompletedSegments()) {
+            fwrite(&src_dst.first, sizeof(int32_t), 1, file_utilization_bin);
+            fwrite(&src_dst.second, sizeof(int32_t), 1, file_utilization_bin);
+            fwrite(&segment.start_ns, sizeof(int64_t), 1, file_utilization_bin);
+            fwrite(&segment.end_ns, sizeof(int64_t), 1, file_utilization_bin);
+            fwrite(&segment.utilization, sizeof(double), 1, file_utilization_bin);
+        }
+        tracker.ClearCompletedSegments();
+
+    }
+
+    void TopologySatelliteNetwork::FlushUtilization() {
 
-                // Add the info of the GSL interface to the cache
-                ArpCache::Entry * entry = arpAll->Add(ipv4Address);
-                entry->SetMacAddress(mac48Address);
+        // Opened at the first flush, such that it goes into the logs directory of the
+        // basic simulation which is actually run (see also SetBasicSimulation)
+        if (m_isl_utilization_flush_file == nullptr) {
+            std::string filename = m_basicSimulation->GetLogsDir() + "/isl_utilization.bin";
+            m_isl_utilization_flush_file = fopen(filename.c_str(), "wb");
+            NS_ABORT_MSG_IF(m_isl_utilization_flush_file == nullptr, "Could not open " << filename);
+        }
+
+        // Segments which are completed can be written out
+        for (size_t i = 0; i < m_islNetDevices.GetN(); i++) {
+            Ptr<PointToPointLaserNetDevice> dev = m_islNetDevices.Get(i)->GetObject<PointToPointLaserNetDevice>();
+            WriteUtilizationSegments(m_isl_utilization_flush_file, m_islFromTo[i], dev->GetUtilizationTracker());
+        }
+        Simulator::Schedule(NanoSeconds(m_isl_utilization_tracking_flush_interval_ns), &TopologySatelliteNetwork::FlushUtilization, this);
+
+    }
+
+    void TopologySatelliteNetwork::SampleQueueOccupancy() {
 
-                // Set a pointer to the ARP cache it should use (will be filled at the end of this function, it's only a pointer)
-                m_allNodes.Get(i)->GetObject<Ipv4L3Protocol>()->GetInterface(j)->SetAttribute("ArpCache", PointerValue(arpAll));
+        // Opened at the first sample (see also FlushUtilization)
+        if (m_queue_occupancy_file == nullptr) {
+            std::string filename = m_basicSimulation->GetLogsDir() + "/queue_occupancy.csv";
+            m_queue_occupancy_file = fopen(filename.c_str(), "w+");
+            NS_ABORT_MSG_IF(m_queue_occupancy_file == nullptr, "Could not open " << filename);
+        }
+
+        // Only the devices whose queue changed since the previous sample are written
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        uint32_t num_isl_devices = m_islPairNetDevices.GetN();
+        for (uint32_t i = 0; i < m_queue_occupancy_prev.size(); i++) {
+            Ptr<NetDevice> dev;
+            std::pair<uint32_t, uint32_t> occupancy;
+            if (i < num_isl_devices) {
+                dev = m_islPairNetDevices.Get(i);
+                Ptr<Queue<Packet>> queue = dev->GetObject<PointToPointLaserNetDevice>()->GetQueue();
+                occupancy = std::make_pair(queue->GetNPackets(), queue->GetNBytes());
+            } else {
+                dev = m_gslNetDevices.Get(i - num_isl_devices);
+                Ptr<GSLNetDevice> gsl_dev = dev->GetObject<GSLNetDevice>();
+                occupancy = std::make_pair(gsl_dev->GetQueueNPackets(), gsl_dev->GetQueueNBytes());
+            }
+            if (occupancy != m_queue_occupancy_prev[i]) {
+
+                // <node id>,<interface id>,<time (ns)>,<packets>,<bytes>
+                fprintf(m_queue_occupancy_file,
+                        "%u,%u,%" PRId64 ",%u,%u\n",
+                        dev->GetNode()->GetId(),
+                        dev->GetIfIndex(),
+                        now_ns,
+                        occupancy.first,
+                        occupancy.second
+                );
+                m_queue_occupancy_prev[i] = occupancy;
 
             }
+        }
+        Simulator::Schedule(NanoSeconds(m_queue_occupancy_tracking_interval_ns), &TopologySatelliteNetwork::SampleQueueOccupancy, this);
+
+    }
 
+    void TopologySatelliteNetwork::EnablePacketEventTracing() {
+        m_packet_event_tracer.reset(new PacketEventTracer(m_packet_event_tracing_buffer_size));
+        PacketEventTracer* tracer = m_packet_event_tracer.get();
+        NetDeviceContainer devices(m_islPairNetDevices, m_gslNetDevices);
+        for (uint32_t i = 0; i < devices.GetN(); i++) {
+            Ptr<NetDevice> dev = devices.Get(i);
+            uint32_t node_id = dev->GetNode()->GetId();
+            uint32_t if_id = dev->GetIfIndex();
+            dev->TraceConnectWithoutContext("MacTx", MakeBoundCallback(&PacketEventTracer::TraceMacTx, tracer, node_id, if_id));
+            dev->TraceConnectWithoutContext("MacTxDrop", MakeBoundCallback(&PacketEventTracer::TraceMacTxDrop, tracer, node_id, if_id));
+            dev->TraceConnectWithoutContext("PhyTxBegin", MakeBoundCallback(&PacketEventTracer::TracePhyTxBegin, tracer, node_id, if_id));
+            dev->TraceConnectWithoutContext("PhyRxEnd", MakeBoundCallback(&PacketEventTracer::TracePhyRxEnd, tracer, node_id, if_id));
         }
+        std::cout << "  > Packet event tracing on " << devices.GetN() << " devices (buffer: " << m_packet_event_tracing_buffer_size << " records)" << std::endl;
+
+        // The writer is started by the first event, such that it writes into the logs directory of
+        // the basic simulation which is actually run (see also SetBasicSimulation)
+        Simulator::Schedule(Seconds(0), &TopologySatelliteNetwork::StartPacketEventTracing, this);
+    }
 
+    void TopologySatelliteNetwork::StartPacketEventTracing() {
+        m_packet_event_tracer->Start(m_basicSimulation->GetLogsDir() + "/packet_events.bin");
     }
 
     void TopologySatelliteNetwork::CollectUtilizationStatistics() {
-        if (m_enable_isl_utilization_tracking) {
 
-            // Open CSV file
-            FILE* file_utilization_csv = fopen((m_basicSimulation->GetLogsDir() + "/isl_utilization.csv").c_str(), "w+");
-
-            // Go over every ISL network device
-            for (size_t i = 0; i < m_islNetDevices.GetN(); i++) {
-                Ptr<PointToPointLaserNetDevice> dev = m_islNetDevices.Get(i)->GetObject<PointToPointLaserNetDevice>();
-                const std::vector<double> utilization = dev->FinalizeUtilization();
-                std::pair<int32_t, int32_t> src_dst = m_islFromTo[i];
-                int64_t interval_left_side_ns = 0;
-                for (size_t j = 0; j < utilization.size(); j++) {
-
-                    // Only write if it is the last one, or if the utilization is different from the next
-                    if (j == utilization.size() - 1 || utilization[j] != utilization[j + 1]) {
-
-                        // Write plain to the CSV file:
-                        // <src>,<dst>,<interval start (ns)>,<interval end (ns)>,<utilization 0.0-1.0>
-                        fprintf(file_utilization_csv,
-                                "%d,%d,%" PRId64 ",%" PRId64 ",%f\n",
-                                src_dst.first,
-                                src_dst.second,
-                                interval_left_side_ns,
-                                (j + 1) * m_isl_utilization_tracking_interval_ns,
-                                utilization[j]
-                        );
+        // Packet event trace: write out everything which is still in the buffer
+        if (m_packet_event_tracer) {
+            m_packet_event_tracer->Close();
+        }
+
+        // Utilization chunks (one per device) are formatted in parallel
+        ParallelChunkWriter writer(m_utilization_statistics_num_threads);
+        const char* extension = m_utilization_binary_output ? ".bin" : ".csv";
+
+        // GSL utilization
+        if (m_enable_gsl_utilization_tracking) {
 
-                        interval_left_side_ns = (j + 1) * m_isl_utilization_tracking_interval_ns;
+            // Everything which involves the devices is done up front, in this thread
+            std::vector<std::pair<uint32_t, uint32_t>> node_if_ids;
+            std::vector<const std::vector<UtilizationTracker::Segment>*> device_segments;
+            for (uint32_t i = 0; i < m_gslNetDevices.GetN(); i++) {
+                Ptr<GSLNetDevice> dev = m_gslNetDevices.Get(i)->GetObject<GSLNetDevice>();
+                node_if_ids.push_back(std::make_pair(dev->GetNode()->GetId(), dev->GetIfIndex()));
+                device_segments.push_back(&dev->FinalizeUtilization());
+            }
+
+            std::string filename = m_basicSimulation->GetLogsDir() + "/gsl_utilization" + extension;
+            FILE* file_utilization = fopen(filename.c_str(), "wb");
+            NS_ABORT_MSG_IF(file_utilization == nullptr, "Could not open " << filename);
+            writer.Write(file_utilization, device_segments.size(), [&](size_t i, std::string& buffer) {
+                for (const UtilizationTracker::Segment& segment : *device_segments[i]) {
+                    if (m_utilization_binary_output) {
+
+                        // <node id (uint32)><interface id (uint32)><interval start ns (int64)><interval end ns (int64)><utilization (double)>
+                        ParallelChunkWriter::AppendBinary(buffer, node_if_ids[i].first);
+                        ParallelChunkWriter::AppendBinary(buffer, node_if_ids[i].second);
+                        ParallelChunkWriter::AppendBinary(buffer, segment.start_ns);
+                        ParallelChunkWriter::AppendBinary(buffer, segment.end_ns);
+                        ParallelChunkWriter::AppendBinary(buffer, segment.utilization);
+
+                    } else {
+
+                        // <node id>,<interface id>,<interval start (ns)>,<interval end (ns)>,<utilization 0.0-1.0>
+                        ParallelChunkWriter::AppendFormat(
+                                buffer,
+                                "%u,%u,%" PRId64 ",%" PRId64 ",%f\n",
+                                node_if_ids[i].first,
+                                node_if_ids[i].second,
+                                segment.start_ns,
+                                segment.end_ns,
+                                segment.utilization
+                        );
 
                     }
                 }
+            });
+            fclose(file_utilization);
+
+        }
+
+        // Queue occupancy (the file is created even if there was no sample)
+        if (m_enable_queue_occupancy_tracking) {
+            if (m_queue_occupancy_file == nullptr) {
+                m_queue_occupancy_file = fopen((m_basicSimulation->GetLogsDir() + "/queue_occupancy.csv").c_str(), "w+");
             }
+            fclose(m_queue_occupancy_file);
+            m_queue_occupancy_file = nullptr;
+        }
+
+        // ISL utilization
+        if (m_enable_isl_utilization_tracking) {
+
+            if (m_isl_utilization_flush_file == nullptr) {
+
+                // Everything which involves the devices is done up front, in this thread
+                std::vector<const std::vector<UtilizationTracker::Segment>*> device_segments;
+                for (size_t i = 0; i < m_islNetDevices.GetN(); i++) {
+                    Ptr<PointToPointLaserNetDevice> dev = m_islNetDevices.Get(i)->GetObject<PointToPointLaserNetDevice>();
+                    device_segments.push_back(&dev->FinalizeUtilization());
+                }
+
+                std::string filename = m_basicSimulation->GetLogsDir() + "/isl_utilization" + extension;
+                FILE* file_utilization = fopen(filename.c_str(), "wb");
+                NS_ABORT_MSG_IF(file_utilization == nullptr, "Could not open " << filename);
+                writer.Write(file_utilization, device_segments.size(), [&](size_t i, std::string& buffer) {
+                    std::pair<int32_t, int32_t> src_dst = m_islFromTo[i];
+                    for (const UtilizationTracker::Segment& segment : *device_segments[i]) {
+                        if (m_utilization_binary_output) {
+
+                            // Same record as WriteUtilizationSegments()
+                            ParallelChunkWriter::AppendBinary(buffer, src_dst.first);
+                            ParallelChunkWriter::AppendBinary(buffer, src_dst.second);
+                            ParallelChunkWriter::AppendBinary(buffer, segment.start_ns);
+                            ParallelChunkWriter::AppendBinary(buffer, segment.end_ns);
+                            ParallelChunkWriter::AppendBinary(buffer, segment.utilization);
+
+                        } else {
+
+                            // <src>,<dst>,<interval start (ns)>,<interval end (ns)>,<utilization 0.0-1.0>
+                            ParallelChunkWriter::AppendFormat(
+                                    buffer,
+                                    "%d,%d,%" PRId64 ",%" PRId64 ",%f\n",
+                                    src_dst.first,
+                                    src_dst.second,
+                                    segment.start_ns,
+                                    segment.end_ns,
+                                    segment.utilization
+                            );
+
+                        }
+                    }
+                });
+                fclose(file_utilization);
 
-            // Close CSV file
-            fclose(file_utilization_csv);
+            } else {
+
+                // Remaining segments go into the binary file as well
+                for (size_t i = 0; i < m_islNetDevices.GetN(); i++) {
+                    Ptr<PointToPointLaserNetDevice> dev = m_islNetDevices.Get(i)->GetObject<PointToPointLaserNetDevice>();
+                    dev->FinalizeUtilization();
+                    WriteUtilizationSegments(m_isl_utilization_flush_file, m_islFromTo[i], dev->GetUtilizationTracker());
+                }
+                fclose(m_isl_utilization_flush_file);
+                m_isl_utilization_flush_file = nullptr;
+
+                // The binary file is already the binary output, otherwise it is converted to the
+                // same CSV format (ordered by time of flushing instead of by ISL)
+                if (!m_utilization_binary_output) {
+                    std::string filename_bin = m_basicSimulation->GetLogsDir() + "/isl_utilization.bin";
+                    std::string filename_csv = m_basicSimulation->GetLogsDir() + "/isl_utilization.csv";
+                    FILE* file_utilization_bin = fopen(filename_bin.c_str(), "rb");
+                    NS_ABORT_MSG_IF(file_utilization_bin == nullptr, "Could not open " << filename_bin);
+                    FILE* file_utilization_csv = fopen(filename_csv.c_str(), "wb");
+                    NS_ABORT_MSG_IF(file_utilization_csv == nullptr, "Could not open " << filename_csv);
+
+                    // Read large blocks of records, of which the chunks are formatted in parallel
+                    const size_t record_size = 2 * sizeof(int32_t) + 2 * sizeof(int64_t) + sizeof(double);
+                    const size_t records_per_chunk = 4096;
+                    std::vector<char> block(record_size * records_per_chunk * writer.GetNumThreads() * 16);
+                    size_t num_bytes;
+                    while ((num_bytes = fread(block.data(), 1, block.size(), file_utilization_bin)) >= record_size) {
+                        size_t num_records = num_bytes / record_size;
+                        writer.Write(file_utilization_csv, (num_records + records_per_chunk - 1) / records_per_chunk, [&](size_t c, std::string& buffer) {
+                            size_t to = std::min(num_records, (c + 1) * records_per_chunk);
+                            for (size_t r = c * records_per_chunk; r < to; r++) {
+                                const char* record = block.data() + r * record_size;
+                                int32_t src, dst;
+                                int64_t start_ns, end_ns;
+                                double utilization;
+                                memcpy(&src, record, sizeof(int32_t));
+                                memcpy(&dst, record + 4, sizeof(int32_t));
+                                memcpy(&start_ns, record + 8, sizeof(int64_t));
+                                memcpy(&end_ns, record + 16, sizeof(int64_t));
+                                memcpy(&utilization, record + 24, sizeof(double));
+                                ParallelChunkWriter::AppendFormat(buffer, "%d,%d,%" PRId64 ",%" PRId64 ",%f\n", src, dst, start_ns, end_ns, utilization);
+                            }
+                        });
+                    }
+                    fclose(file_utilization_bin);
+                    fclose(file_utilization_csv);
+                    remove_file_if_exists(filename_bin);
+                }
+
+            }
 
         }
     }
 
+    void TopologySatelliteNetwork::SetBasicSimulation(Ptr<BasicSimulation> basicSimulation) {
+        m_basicSimulation = basicSimulation;
+    }
+
     uint32_t TopologySatelliteNetwork::GetNumSatellites() {
         return m_satelliteNodes.GetN();
     }
@@ -509,6 +1351,10 @@ namespace ns3 {
         return m_groundStations;
     }
 
+    Ptr<NodeInterfaceTable> TopologySatelliteNetwork::GetNodeInterfaceTable() {
+        return m_nodeInterfaceTable;
+    }
+
     const std::vector<Ptr<Satellite>>& TopologySatelliteNetwork::GetSatellites() {
         return m_satellites;
     }
@@ -529,6 +1375,27 @@ namespace ns3 {
         return node_id >= m_satellites.size() && node_id ;
     }
 
+    const SatelliteVisibilityIndex& TopologySatelliteNetwork::GetSatelliteVisibilityIndex() {
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        if (now_ns != m_satellite_visibility_index_time_ns) {
+            std::vector<Vector> satellite_positions;
+            satellite_positions.reserve(m_satelliteNodes.GetN());
+            for (uint32_t i = 0; i < m_satelliteNodes.GetN(); i++) {
+                satellite_positions.push_back(m_satelliteNodes.Get(i)->GetObject<MobilityModel>()->GetPosition());
+            }
+            m_satellite_visibility_index.Build(satellite_positions);
+            m_satellite_visibility_index_time_ns = now_ns;
+        }
+        return m_satellite_visibility_index;
+    }
+
+    std::vector<uint32_t> TopologySatelliteNetwork::GetVisibleSatellites(uint32_t gs_id, double min_elevation_deg) {
+        if (gs_id >= m_groundStations.size()) {
+            throw std::runtime_error("Cannot retrieve visible satellites of an invalid ground station ID");
+        }
+        return GetSatelliteVisibilityIndex().GetVisibleSatellites(m_groundStations.at(gs_id)->GetCartesianPosition(), min_elevation_deg);
+    }
+
     const Ptr<Satellite> TopologySatelliteNetwork::GetSatellite(uint32_t satellite_id) {
         if (satellite_id >= m_satellites.size()) {
             throw std::runtime_error("Cannot retrieve satellite with an invalid satellite ID");
@@ -23,6 +23,12 @@
 #define TOPOLOGY_SATELLITE_NETWORK_H
 
 #include <utility>
+#include <memory>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <chrono>
 #include "ns3/core-module.h"
 #include "ns3/node.h"
 #include "ns3/node-container.h"
@@ -40,6 +46,7 @@
 #include "ns3/ground-station.h"
 #include "ns3/satellite-position-helper.h"
 #include "ns3/satellite-position-mobility-model.h"
+#include "ns3/satellite-ephemeris.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/string.h"
 #include "ns3/type-id.h"
@@ -55,6 +62,14 @@
 #include "ns3/wifi-net-device.h"
 #include "ns3/point-to-point-laser-net-device.h"
 #include "ns3/ipv4.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/topology-satellite-network-snapshot.h"
+#include "ns3/satellite-network-partitioner.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/packet-event-tracer.h"
+#include "ns3/parallel-chunk-writer.h"
+#include "ns3/satellite-visibility-index.h"
+#include "ns3/node-interface-table.h"
 
 namespace ns3 {
 
@@ -78,25 +93,63 @@ namespace ns3 {
         const NodeContainer& GetSatelliteNodes();
         const NodeContainer& GetGroundStationNodes();
         const std::vector<Ptr<GroundStation>>& GetGroundStations();
+        Ptr<NodeInterfaceTable> GetNodeInterfaceTable();
         const std::vector<Ptr<Satellite>>& GetSatellites();
         const Ptr<Satellite> GetSatellite(uint32_t sat_id);
         uint32_t NodeToGroundStationId(uint32_t node_id);
         bool IsSatelliteId(uint32_t node_id);
         bool IsGroundStationId(uint32_t node_id);
 
+        // Satellites visible from a ground station at the current time (the index of the satellite
+        // positions is rebuilt at most once per simulation time)
+        const SatelliteVisibilityIndex& GetSatelliteVisibilityIndex();
+        std::vector<uint32_t> GetVisibleSatellites(uint32_t gs_id, double min_elevation_deg);
+
         // Post-processing
         void CollectUtilizationStatistics();
 
+        // Switch to another basic simulation (with the same network configuration) for the output,
+        // e.g., when a forked process re-uses the topology built by its parent
+        void SetBasicSimulation(Ptr<BasicSimulation> basicSimulation);
+
     private:
 
         // Build functions
         void ReadConfig();
         void Build(const Ipv4RoutingHelper& ipv4RoutingHelper);
+        void BuildFromInputs(const Ipv4RoutingHelper& ipv4RoutingHelper);
+        void BuildFromSnapshot(const Ipv4RoutingHelper& ipv4RoutingHelper, const TopologySatelliteNetworkSnapshot& snapshot);
         void ReadGroundStations();
         void ReadSatellites();
+        void AddGroundStation(uint32_t gid, const std::string& name, double latitude, double longitude, double elevation, Vector cartesian_position);
+        void AddSatellite(const std::string& name, const std::string& tle1, const std::string& tle2);
+        void CreateNodes();
+        void PrecomputeSatelliteEphemerides();
+        void InstallSatelliteMobility(uint32_t sat_id);
+        void CollectNodesAndEndpoints();
         void InstallInternetStacks(const Ipv4RoutingHelper& ipv4RoutingHelper);
+        void InstallForwardingOnlyStack(Ptr<Node> node, const Ipv4RoutingHelper& ipv4RoutingHelper);
         void ReadISLs();
+        void ConfigureIslHelper(PointToPointLaserHelper& p2p_laser_helper);
+        void RegisterIsl(int32_t sat0_id, int32_t sat1_id, NetDeviceContainer netDevices);
         void CreateGSLs();
+        void ConfigureGslHelper(GSLHelper& gsl_helper);
+        double GetMaxSatelliteSpeedMetersPerSecond();
+        void ConfigureDistributedLookahead();
+
+        // Snapshot
+        void AssignInterfaceAddress(Ptr<NetDevice> device, const TopologySatelliteNetworkSnapshot::Interface& itf);
+        TopologySatelliteNetworkSnapshot::Interface GetInterfaceRecord(uint32_t node_id, Ptr<NetDevice> device);
+        void WriteSnapshot(uint64_t fingerprint);
+
+        // Utilization
+        void FlushUtilization();
+        void SampleQueueOccupancy();
+        void WriteUtilizationSegments(FILE* file_utilization_bin, std::pair<int32_t, int32_t> src_dst, UtilizationTracker& tracker);
+
+        // Packet event tracing
+        void EnablePacketEventTracing();
+        void StartPacketEventTracing();
 
         // Helper
         void EnsureValidNodeId(uint32_t node_id);
@@ -104,6 +157,7 @@ namespace ns3 {
         // Routing
         Ipv4AddressHelper m_ipv4_helper;
         void PopulateArpCaches();
+        void PopulateArpCachesFromSnapshot(const TopologySatelliteNetworkSnapshot& snapshot);
 
         // Input
         Ptr<BasicSimulation> m_basicSimulation;       //<! Basic simulation instance
@@ -111,6 +165,13 @@ namespace ns3 {
         std::string m_satellite_network_routes_dir;   //<! Directory containing the routes over time of the network
         bool m_satellite_network_force_static;        //<! True to disable satellite movement and basically run
                                                       //   it static at t=0 (like a static network)
+        std::string m_satellite_network_snapshot_filename;  //<! Binary snapshot of the built topology (empty if disabled)
+        int64_t m_satellite_ephemeris_step_ns;        //<! Step of the precomputed trajectories (0 if disabled)
+        SatelliteEphemeris::Storage m_satellite_ephemeris_storage;  //<! Storage of the precomputed trajectories
+        uint32_t m_satellite_ephemeris_num_threads;   //<! Threads precomputing the trajectories (0 = hardware threads)
+        std::vector<Ptr<SatelliteEphemeris>> m_satellite_ephemerides;  //<! Precomputed trajectory of each satellite
+        SatelliteVisibilityIndex m_satellite_visibility_index = SatelliteVisibilityIndex(5.0);  //<! Sub-satellite points in 5 x 5 degree cells
+        int64_t m_satellite_visibility_index_time_ns = -1;  //<! Simulation time of the index (-1 if never built)
 
         // Generated state
         NodeContainer m_allNodes;                           //!< All nodes
@@ -119,6 +180,13 @@ namespace ns3 {
         std::vector<Ptr<GroundStation> > m_groundStations;  //!< Ground stations
         std::vector<Ptr<Satellite>> m_satellites;           //<! Satellites
         std::set<int64_t> m_endpoints;                      //<! Endpoint ids = ground station ids
+        Ptr<NodeInterfaceTable> m_nodeInterfaceTable;       //<! IPv4 stack and interfaces of all nodes
+
+        // All ISLs (two network devices each) and GSL network devices
+        std::vector<std::pair<int32_t, int32_t>> m_islPairs;
+        NetDeviceContainer m_islPairNetDevices;
+        std::vector<std::tuple<int32_t, double>> m_gslIfInfo;
+        NetDeviceContainer m_gslNetDevices;
 
         // ISL devices
         NetDeviceContainer m_islNetDevices;
@@ -129,8 +197,28 @@ namespace ns3 {
         double m_gsl_data_rate_megabit_per_s;
         int64_t m_isl_max_queue_size_pkts;
         int64_t m_gsl_max_queue_size_pkts;
+        std::string m_gsl_voq_scheduler;
+        std::string m_link_framing;
         bool m_enable_isl_utilization_tracking;
         int64_t m_isl_utilization_tracking_interval_ns;
+        uint32_t m_isl_utilization_tracking_quantization_levels;
+        int64_t m_isl_utilization_tracking_flush_interval_ns;
+        FILE* m_isl_utilization_flush_file = nullptr;
+        bool m_enable_gsl_utilization_tracking;
+        int64_t m_gsl_utilization_tracking_interval_ns;
+        uint32_t m_gsl_utilization_tracking_quantization_levels;
+        bool m_enable_queue_occupancy_tracking;
+        int64_t m_queue_occupancy_tracking_interval_ns;
+        std::vector<std::pair<uint32_t, uint32_t>> m_queue_occupancy_prev; // (packets, bytes) of each ISL and then GSL device
+        FILE* m_queue_occupancy_file = nullptr;
+        bool m_enable_packet_event_tracing;
+        int64_t m_packet_event_tracing_buffer_size;
+        std::unique_ptr<PacketEventTracer> m_packet_event_tracer;
+        uint32_t m_utilization_statistics_num_threads;
+        bool m_utilization_binary_output;
+        int64_t m_delay_cache_tolerance_ns;
+        bool m_zero_copy;
+        bool m_lightweight_satellite_stacks;
 
     };
 
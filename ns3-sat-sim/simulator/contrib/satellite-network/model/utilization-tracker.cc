@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "utilization-tracker.h"
+#include <algorithm>
+#include <cmath>
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+    UtilizationTracker::UtilizationTracker(int64_t interval_ns, uint32_t quantization_levels) {
+        NS_ABORT_MSG_IF(interval_ns <= 0, "Utilization tracking interval must be positive");
+        m_interval_ns = interval_ns;
+        m_quantization_levels = quantization_levels;
+        m_prev_time_ns = 0;
+        m_current_interval_end_ns = interval_ns;
+        m_busy_time_counter_ns = 0;
+        m_current_utilization = 0.0;
+        m_has_open_segment = false;
+        m_open_segment = {0, 0, 0.0};
+    }
+
+    void UtilizationTracker::Track(int64_t now_ns, bool next_state_is_busy) {
+        TrackUtilization(now_ns, next_state_is_busy ? 1.0 : 0.0);
+    }
+
+    void UtilizationTracker::TrackUtilization(int64_t now_ns, double next_utilization) {
+        NS_ABORT_MSG_IF(next_utilization < 0.0 || next_utilization > 1.0, "Utilization must be in [0, 1]");
+
+        // Complete every interval which ended since the previous call
+        while (now_ns >= m_current_interval_end_ns) {
+            if (m_current_utilization > 0.0) {
+                m_busy_time_counter_ns += m_current_utilization * (m_current_interval_end_ns - m_prev_time_ns);
+            }
+            CompleteInterval(m_busy_time_counter_ns);
+
+            // Move to next interval
+            m_busy_time_counter_ns = 0;
+            m_prev_time_ns = m_current_interval_end_ns;
+            m_current_interval_end_ns += m_interval_ns;
+        }
+
+        // Within the current interval
+        if (m_current_utilization > 0.0) {
+            m_busy_time_counter_ns += m_current_utilization * (now_ns - m_prev_time_ns);
+        }
+        m_current_utilization = next_utilization;
+        m_prev_time_ns = now_ns;
+
+    }
+
+    void UtilizationTracker::CompleteInterval(double busy_ns) {
+        NS_ABORT_MSG_IF(busy_ns < 0 || busy_ns > m_interval_ns * (1.0 + 1e-9), "Not all time is accounted for");
+        double utilization = std::min(1.0, busy_ns / ((double) m_interval_ns));
+        if (m_quantization_levels > 0) {
+            utilization = std::round(utilization * m_quantization_levels) / m_quantization_levels;
+        }
+        int64_t start_ns = m_current_interval_end_ns - m_interval_ns;
+
+        // Extend the open segment if the utilization is the same
+        if (m_has_open_segment && m_open_segment.utilization == utilization) {
+            m_open_segment.end_ns = m_current_interval_end_ns;
+            return;
+        }
+        if (m_has_open_segment) {
+            m_completed_segments.push_back(m_open_segment);
+        }
+        m_open_segment = {start_ns, m_current_interval_end_ns, utilization};
+        m_has_open_segment = true;
+    }
+
+    void UtilizationTracker::Finalize(int64_t now_ns) {
+        TrackUtilization(now_ns, m_current_utilization);
+        if (m_has_open_segment) {
+            m_completed_segments.push_back(m_open_segment);
+            m_has_open_segment = false;
+        }
+    }
+
+    const std::vector<UtilizationTracker::Segment>& UtilizationTracker::GetCompletedSegments() const {
+        return m_completed_segments;
+    }
+
+    void UtilizationTracker::ClearCompletedSegments() {
+        m_completed_segments.clear();
+    }
+
+}
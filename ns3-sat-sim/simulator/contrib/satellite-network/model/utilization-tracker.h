@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef UTILIZATION_TRACKER_H
+#define UTILIZATION_TRACKER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Tracks the fraction of time a transmitter is busy in fixed-length intervals.
+ *
+ * Consecutive intervals with the same utilization are merged into a single segment as the
+ * simulation goes, so memory only grows with the number of times the utilization changes
+ * rather than with the number of intervals. The utilization can additionally be quantized
+ * to a number of levels, which merges intervals whose utilization is almost the same.
+ *
+ * Completed segments can be taken out at any time (e.g., to write them to a file), the
+ * segment which is still open keeps on growing as long as the utilization does not change.
+ */
+class UtilizationTracker
+{
+public:
+
+    // Utilization over [start_ns, end_ns)
+    struct Segment {
+        int64_t start_ns;
+        int64_t end_ns;
+        double utilization;
+    };
+
+    // Interval length, and number of quantization levels (0: not quantized)
+    UtilizationTracker(int64_t interval_ns, uint32_t quantization_levels);
+
+    // Transmitter becomes busy (or idle) at now_ns
+    void Track(int64_t now_ns, bool next_state_is_busy);
+
+    // Transmitter is busy a fraction (in [0, 1]) of the time from now_ns on (e.g., for a fluid
+    // model, where a link is shared by flows instead of sending packets one at a time)
+    void TrackUtilization(int64_t now_ns, double next_utilization);
+
+    // Accounts for the time until now_ns and closes the open segment (only full intervals are included)
+    void Finalize(int64_t now_ns);
+
+    // Segments which can no longer be extended
+    const std::vector<Segment>& GetCompletedSegments() const;
+    void ClearCompletedSegments();
+
+private:
+    void CompleteInterval(double busy_ns);
+
+    int64_t m_interval_ns;
+    uint32_t m_quantization_levels;
+
+    // Interval currently being tracked
+    int64_t m_prev_time_ns;
+    int64_t m_current_interval_end_ns;
+    double m_busy_time_counter_ns;
+    double m_current_utilization;
+
+    // Segment which is still being extended
+    bool m_has_open_segment;
+    Segment m_open_segment;
+
+    std::vector<Segment> m_completed_segments;
+};
+
+}
+
+#endif //UTILIZATION_TRACKER_H
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/gsl-channel.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/point-to-point-laser-net-device.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class BackgroundLoadTestCase : public TestCase {
+public:
+    BackgroundLoadTestCase () : TestCase ("background-load") {};
+
+    std::vector<int64_t> m_received_ns;
+
+    bool Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from) {
+        m_received_ns.push_back(Simulator::Now().GetNanoSeconds());
+        return true;
+    }
+
+    // Two IPv4 packets, of 1000 byte (8 ms at 1 Mbit/s) and of second_size_byte, without
+    // propagation delay, at t = 1 ms the background load is set to another queueing delay
+    template <typename Device>
+    std::vector<int64_t> Run(Ptr<Device> from, Ptr<NetDevice> to, double utilization, Time queueing_delay, Time later_queueing_delay, uint32_t second_size_byte) {
+        to->SetReceiveCallback(MakeCallback(&BackgroundLoadTestCase::Receive, this));
+        m_received_ns.clear();
+        from->SetBackgroundLoad(utilization, queueing_delay);
+        Simulator::Schedule(MilliSeconds(1), &Device::SetBackgroundLoad, from, utilization, later_queueing_delay);
+        for (uint32_t size_byte : {1000u, second_size_byte}) {
+            Ptr<Packet> packet = Create<Packet>(size_byte - 20);
+            Ipv4Header header;
+            header.SetPayloadSize(packet->GetSize());
+            packet->AddHeader(header);
+            from->Send(packet, to->GetAddress(), 0x0800);
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+        return m_received_ns;
+    }
+
+    std::vector<int64_t> RunGsl(double utilization, Time queueing_delay, Time later_queueing_delay, uint32_t second_size_byte) {
+        NodeContainer nodes;
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        GSLHelper gsl_helper;
+        gsl_helper.SetQueue("ns3::GSLQueue", "MaxSize", QueueSizeValue(QueueSize("100p")));
+        gsl_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+        gsl_helper.SetDeviceAttribute("Framing", EnumValue(GSLNetDevice::FRAMING_NONE));
+        Ptr<GSLChannel> channel = CreateObject<GSLChannel>();
+        Ptr<GSLNetDevice> dev_a = gsl_helper.Install(nodes.Get(0), channel);
+        Ptr<GSLNetDevice> dev_b = gsl_helper.Install(nodes.Get(1), channel);
+        return Run(dev_a, dev_b, utilization, queueing_delay, later_queueing_delay, second_size_byte);
+    }
+
+    std::vector<int64_t> RunIsl(double utilization, Time queueing_delay, Time later_queueing_delay, uint32_t second_size_byte) {
+        NodeContainer nodes;
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        PointToPointLaserHelper p2p_laser_helper;
+        p2p_laser_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("100p")));
+        p2p_laser_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+        p2p_laser_helper.SetDeviceAttribute("Framing", EnumValue(PointToPointLaserNetDevice::FRAMING_NONE));
+        NetDeviceContainer devices = p2p_laser_helper.Install(nodes.Get(0), nodes.Get(1));
+        return Run(devices.Get(0)->GetObject<PointToPointLaserNetDevice>(), devices.Get(1), utilization, queueing_delay, later_queueing_delay, second_size_byte);
+    }
+
+    void CheckBackgroundLoad(
+            const std::vector<int64_t>& none, const std::vector<int64_t>& half, const std::vector<int64_t>& decreasing,
+            const std::vector<int64_t>& smaller
+    ) {
+
+        // Without background load back-to-back
+        ASSERT_EQUAL(2, none.size());
+        ASSERT_EQUAL(8000000, none[0]);
+        ASSERT_EQUAL(16000000, none[1]);
+
+        // Half of the rate is left (16 ms each), and the first waits 1 ms behind the background
+        // traffic, the second (starting at 16 ms) 1 ms as well
+        ASSERT_EQUAL(2, half.size());
+        ASSERT_EQUAL(17000000, half[0]);
+        ASSERT_EQUAL(33000000, half[1]);
+
+        // The first waits 30 ms, the second (starting at 16 ms) would no longer have to wait,
+        // but only leaves the queue once the first has fully arrived
+        ASSERT_EQUAL(2, decreasing.size());
+        ASSERT_EQUAL(46000000, decreasing[0]);
+        ASSERT_EQUAL(62000000, decreasing[1]);
+
+        // Same, with a second packet of 500 byte (8 ms) which would otherwise arrive first
+        ASSERT_EQUAL(2, smaller.size());
+        ASSERT_EQUAL(46000000, smaller[0]);
+        ASSERT_EQUAL(54000000, smaller[1]);
+
+    }
+
+    void DoRun () {
+        CheckBackgroundLoad(
+                RunGsl(0.0, Seconds(0), Seconds(0), 1000),
+                RunGsl(0.5, MilliSeconds(1), MilliSeconds(1), 1000),
+                RunGsl(0.5, MilliSeconds(30), Seconds(0), 1000),
+                RunGsl(0.5, MilliSeconds(30), Seconds(0), 500)
+        );
+        CheckBackgroundLoad(
+                RunIsl(0.0, Seconds(0), Seconds(0), 1000),
+                RunIsl(0.5, MilliSeconds(1), MilliSeconds(1), 1000),
+                RunIsl(0.5, MilliSeconds(30), Seconds(0), 1000),
+                RunIsl(0.5, MilliSeconds(30), Seconds(0), 500)
+        );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -55,6 +55,10 @@ public:
         config_file << "gsl_max_queue_size_pkts=75" << std::endl;
         config_file << "enable_isl_utilization_tracking=true" << std::endl;
         config_file << "isl_utilization_tracking_interval_ns=100000000" << std::endl;
+        config_file << "enable_gsl_utilization_tracking=true" << std::endl;
+        config_file << "gsl_utilization_tracking_interval_ns=100000000" << std::endl;
+        config_file << "enable_queue_occupancy_tracking=true" << std::endl;
+        config_file << "queue_occupancy_tracking_interval_ns=10000000" << std::endl;
         config_file << "dynamic_state_update_interval_ns=100000000" << std::endl;
         config_file << "enable_udp_burst_scheduler=true" << std::endl;
         config_file << "udp_burst_schedule_filename=udp_burst_schedule.csv" << std::endl;
@@ -159,8 +163,8 @@ public:
 
         // Read topology, and install routing arbiters
         Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
-        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
-        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes());
+        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
 
         // Schedule UDP bursts
         UdpBurstScheduler udpBurstScheduler(basicSimulation, topology); // Requires enable_udp_burst_scheduler=true
@@ -221,6 +225,53 @@ public:
         // Collect utilization statistics
         topology->CollectUtilizationStatistics();
 
+        // GSL utilization: the ground station sending at 10 Mbit/s saturates its 10 Mbit/s GSL
+        bool has_saturated_gsl = false;
+        for (const std::string& line : read_file_direct(temp_dir + "/logs_ns3/gsl_utilization.csv")) {
+            std::vector<std::string> spl = split_string(line, ",", 5);
+            double utilization = parse_double(spl[4]);
+            ASSERT_TRUE(utilization >= 0.0 && utilization <= 1.0);
+            has_saturated_gsl = has_saturated_gsl || utilization > 0.99;
+        }
+        ASSERT_TRUE(has_saturated_gsl);
+
+        // Queue occupancy: rows of ISL and GSL devices, sampled every 10 ms, and the queue of
+        // the 4 Mbit/s ISL of satellite 0 (into which burst 0 sends 10 Mbit/s) is never empty
+        // after it has filled up
+        std::vector<std::string> lines_queue_occupancy_csv = read_file_direct(temp_dir + "/logs_ns3/queue_occupancy.csv");
+        ASSERT_TRUE(lines_queue_occupancy_csv.size() > 0);
+        std::map<std::pair<int64_t, int64_t>, int64_t> occupancy_at_5s;
+        for (const std::string& line : lines_queue_occupancy_csv) {
+            std::vector<std::string> spl = split_string(line, ",", 5);
+            int64_t node_id = parse_int64(spl[0]);
+            int64_t if_id = parse_int64(spl[1]);
+            int64_t time_ns = parse_int64(spl[2]);
+            int64_t num_packets = parse_int64(spl[3]);
+            int64_t num_bytes = parse_int64(spl[4]);
+            ASSERT_TRUE(node_id >= 0 && node_id < 7);
+            Ptr<Node> node = topology->GetNodes().Get(node_id);
+            ASSERT_TRUE(if_id >= 0 && if_id < node->GetNDevices());
+            ASSERT_TRUE(
+                    node->GetDevice(if_id)->GetObject<PointToPointLaserNetDevice>() != 0
+                    || node->GetDevice(if_id)->GetObject<GSLNetDevice>() != 0
+            );
+            ASSERT_TRUE(time_ns > 0 && time_ns <= simulation_end_time_ns);
+            ASSERT_EQUAL(time_ns % 10000000, 0);
+            ASSERT_TRUE(num_packets >= 0 && num_packets <= 80);
+            ASSERT_TRUE(num_bytes >= num_packets);
+            ASSERT_TRUE(num_packets > 0 || num_bytes == 0);
+            if (time_ns <= 5000000000) {
+                occupancy_at_5s[std::make_pair(node_id, if_id)] = num_packets;
+            }
+        }
+        bool isl_of_satellite_0_queued = false;
+        for (const std::pair<const std::pair<int64_t, int64_t>, int64_t>& entry : occupancy_at_5s) {
+            if (entry.first.first == 0 && topology->GetNodes().Get(0)->GetDevice(entry.first.second)->GetObject<PointToPointLaserNetDevice>() != 0) {
+                isl_of_satellite_0_queued = entry.second > 0;
+            }
+        }
+        ASSERT_TRUE(isl_of_satellite_0_queued);
+
         // Finalize the simulation
         basicSimulation->Finalize();
 
@@ -44,8 +44,8 @@ public:
 
         // Read topology, and install routing arbiters
         Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
-        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
-        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes());
+        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
 
         // Schedule UDP bursts
         UdpBurstScheduler udpBurstScheduler(basicSimulation, topology); // Requires enable_udp_burst_scheduler=true
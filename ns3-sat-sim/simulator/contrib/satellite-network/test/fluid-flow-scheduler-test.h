@@ -0,0 +1,427 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/arbiter-single-forward-helper.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/gsl-if-bandwidth-helper.h"
+#include "ns3/fluid-flow-scheduler.h"
+#include "ns3/tcp-flow-scheduler.h"
+#include "ns3/udp-burst-scheduler.h"
+#include "ns3/tcp-optimizer.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class FluidFlowSchedulerTestCase : public TestCase {
+public:
+    FluidFlowSchedulerTestCase () : TestCase ("fluid-flow-scheduler") {};
+
+    void DoRun () {
+
+        // Three flows over a single link share it equally
+        std::vector<double> rates = FluidFlowScheduler::CalculateMaxMinFairRates({{0}, {0}, {0}}, {10.0});
+        ASSERT_EQUAL(3, rates.size());
+        for (double rate : rates) {
+            ASSERT_EQUAL_APPROX(10.0 / 3.0, rate, 1e-9);
+        }
+
+        // Link 1 is the bottleneck of flows 1 and 2, flow 0 gets what is left of link 0
+        rates = FluidFlowScheduler::CalculateMaxMinFairRates({{0}, {0, 1}, {1}}, {10.0, 4.0});
+        ASSERT_EQUAL_APPROX(8.0, rates[0], 1e-9);
+        ASSERT_EQUAL_APPROX(2.0, rates[1], 1e-9);
+        ASSERT_EQUAL_APPROX(2.0, rates[2], 1e-9);
+
+        // Flows 0 and 2 are limited by link 1, flow 1 gets the rest of link 3, link 0 is not used
+        rates = FluidFlowScheduler::CalculateMaxMinFairRates({{1, 3}, {3}, {1}}, {0.0, 6.0, 0.0, 9.0});
+        ASSERT_EQUAL_APPROX(3.0, rates[0], 1e-9);
+        ASSERT_EQUAL_APPROX(6.0, rates[1], 1e-9);
+        ASSERT_EQUAL_APPROX(3.0, rates[2], 1e-9);
+
+        // A link without capacity stops its flows
+        rates = FluidFlowScheduler::CalculateMaxMinFairRates({{2, 0}, {0}}, {10.0, 4.0, 0.0});
+        ASSERT_EQUAL_APPROX(0.0, rates[0], 1e-9);
+        ASSERT_EQUAL_APPROX(10.0, rates[1], 1e-9);
+
+        // No flows
+        ASSERT_EQUAL(0, FluidFlowScheduler::CalculateMaxMinFairRates({}, {10.0}).size());
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class FluidFlowSchedulerEndToEndTestCase : public TestCase {
+public:
+    FluidFlowSchedulerEndToEndTestCase () : TestCase ("fluid-flow-scheduler-end-to-end") {};
+
+    void DoRun () {
+
+        const std::string temp_dir = ".tmp-fluid-flow-scheduler-end-to-end-test";
+        const std::string dyn_state_dir = temp_dir + "/dynamic_state";
+        mkdir_if_not_exists(temp_dir);
+        mkdir_if_not_exists(dyn_state_dir);
+
+        // A configuration file
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        int64_t simulation_end_time_ns = 3000000000; // 3s
+        config_file << "simulation_end_time_ns=" << simulation_end_time_ns << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=dynamic_state" << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file << "enable_isl_utilization_tracking=false" << std::endl;
+        config_file << "dynamic_state_update_interval_ns=100000000" << std::endl;
+        config_file << "enable_fluid_flow_scheduler=true" << std::endl;
+        config_file << "fluid_flow_schedule_filename=tcp_flow_schedule.csv" << std::endl;
+        config_file.close();
+
+        // Topology
+        //
+        // Satellites:               0 ----- 1        2
+        //                          ||       ||       |
+        //                   ( ......... GSL channel ......... )
+        //                    ||    |               |    |
+        // Ground stations:   3     4               5    6
+        //
+        // Flow 0 (3 -> 5) is limited by the 4 Mbit/s ISL, flow 1 (4 -> 5) gets the rest of the
+        // GSL of satellite 1 (6 Mbit/s) until flow 2 (4 -> 6) starts at 1s and shares the GSL of
+        // ground station 4 with it (5 Mbit/s each). Flow 1 finishes at 1.4s, after which flow 2
+        // has the full 10 Mbit/s and finishes at 1.6s, and flow 0 (always 4 Mbit/s) finishes at 2s.
+
+        // Flow schedule
+        std::ofstream schedule_file;
+        schedule_file.open (temp_dir + "/tcp_flow_schedule.csv");
+        schedule_file << "0,3,5,1000000,0,," << std::endl;
+        schedule_file << "1,4,5,1000000,0,," << std::endl;
+        schedule_file << "2,4,6,500000,1000000000,," << std::endl;
+        schedule_file.close();
+
+        // TLES
+        std::ofstream tles_file;
+        tles_file.open (temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        tles_file << "Starlink-550 0" << std::endl;
+        tles_file << "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03" << std::endl;
+        tles_file << "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08" << std::endl;
+        tles_file << "Starlink-550 1" << std::endl;
+        tles_file << "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09" << std::endl;
+        tles_file << "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01" << std::endl;
+        tles_file << "Starlink-550 2" << std::endl;
+        tles_file << "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07" << std::endl;
+        tles_file << "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00" << std::endl;
+        tles_file.close();
+
+        // ISLs
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        // Ground stations
+        std::ofstream ground_stations_file;
+        ground_stations_file.open (temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "1,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "2,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file << "3,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file.close();
+
+        // GSL interfaces info
+        std::ofstream gsl_interfaces_info_file;
+        gsl_interfaces_info_file.open (temp_dir + "/gsl_interfaces_info.txt");
+        gsl_interfaces_info_file << "0,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "1,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "3,2,1.0" << std::endl;
+        gsl_interfaces_info_file << "4,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "5,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "6,1,1.0" << std::endl;
+        gsl_interfaces_info_file.close();
+
+        // Dynamic state (the same forwarding state throughout)
+        for (int64_t i = 0; i < simulation_end_time_ns; i += 100000000) {
+            std::ofstream fstate_file;
+            fstate_file.open (dyn_state_dir + "/fstate_" + std::to_string(i) + ".txt");
+            if (i == 0) {
+                fstate_file << "3,5,0,0,1" << std::endl;
+                fstate_file << "0,5,1,0,0" << std::endl;
+                fstate_file << "1,5,5,1,0" << std::endl;
+                fstate_file << "4,5,1,0,1" << std::endl;
+                fstate_file << "4,6,2,0,0" << std::endl;
+                fstate_file << "2,6,6,0,0" << std::endl;
+            }
+            fstate_file.close();
+
+            std::ofstream gsl_if_bandwidth_file;
+            gsl_if_bandwidth_file.open (dyn_state_dir + "/gsl_if_bandwidth_" + std::to_string(i) + ".txt");
+            gsl_if_bandwidth_file.close();
+        }
+
+        // Run the fluid flows
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+        FluidFlowScheduler fluidFlowScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        fluidFlowScheduler.WriteResults();
+        basicSimulation->Finalize();
+
+        // Completion times (up to the nanosecond rounding at every reallocation)
+        std::vector<int64_t> expected_end_time_ns = {2000000000, 1400000000, 1600000000};
+        std::vector<std::string> lines_csv = read_file_direct(temp_dir + "/logs_ns3/tcp_flows.csv");
+        ASSERT_EQUAL(3, lines_csv.size());
+        for (const std::string& line : lines_csv) {
+            std::vector<std::string> line_spl = split_string(line, ",");
+            int64_t flow_id = parse_int64(line_spl[0]);
+            ASSERT_EQUAL_APPROX(parse_int64(line_spl[5]), expected_end_time_ns.at(flow_id), 100);
+            ASSERT_EQUAL(parse_int64(line_spl[7]), parse_int64(line_spl[3]));
+            ASSERT_EQUAL(line_spl[8], "YES");
+        }
+
+        // Clean up
+        remove_file_if_exists(temp_dir + "/logs_ns3/tcp_flows.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class FluidFlowSchedulerBackgroundTestCase : public TestCase {
+public:
+    FluidFlowSchedulerBackgroundTestCase () : TestCase ("fluid-flow-scheduler-background") {};
+
+    // One-way delays of the UDP burst packets sent in [from_ns, until_ns)
+    std::vector<int64_t> OneWayDelaysNs(const std::map<int64_t, int64_t>& sent_ns, const std::map<int64_t, int64_t>& received_ns, int64_t from_ns, int64_t until_ns) {
+        std::vector<int64_t> delays_ns;
+        for (const std::pair<const int64_t, int64_t>& entry : received_ns) {
+            int64_t sent = sent_ns.at(entry.first);
+            if (sent >= from_ns && sent < until_ns) {
+                delays_ns.push_back(entry.second - sent);
+            }
+        }
+        return delays_ns;
+    }
+
+    void DoRun () {
+
+        const std::string temp_dir = ".tmp-fluid-flow-scheduler-background-test";
+        const std::string dyn_state_dir = temp_dir + "/dynamic_state";
+        mkdir_if_not_exists(temp_dir);
+        mkdir_if_not_exists(dyn_state_dir);
+
+        // A configuration file
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        int64_t simulation_end_time_ns = 4000000000; // 4s
+        config_file << "simulation_end_time_ns=" << simulation_end_time_ns << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=dynamic_state" << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file << "enable_isl_utilization_tracking=false" << std::endl;
+        config_file << "dynamic_state_update_interval_ns=100000000" << std::endl;
+        config_file << "enable_fluid_flow_scheduler=true" << std::endl;
+        config_file << "fluid_flow_schedule_filename=fluid_flow_schedule.csv" << std::endl;
+        config_file << "fluid_flow_background=true" << std::endl;
+        config_file << "fluid_flow_background_max_utilization=0.5" << std::endl;
+        config_file << "enable_tcp_flow_scheduler=true" << std::endl;
+        config_file << "tcp_flow_schedule_filename=tcp_flow_schedule.csv" << std::endl;
+        config_file << "tcp_flow_enable_logging_for_tcp_flow_ids=set()" << std::endl;
+        config_file << "enable_udp_burst_scheduler=true" << std::endl;
+        config_file << "udp_burst_schedule_filename=udp_burst_schedule.csv" << std::endl;
+        config_file << "udp_burst_enable_logging_for_udp_burst_ids=set(0)" << std::endl;
+        config_file.close();
+
+        // Topology
+        //
+        // Satellites:               0 ----- 1        2
+        //                          ||       ||       |
+        //                   ( ......... GSL channel ......... )
+        //                    ||    |               |    |
+        // Ground stations:   3     4               5    6
+        //
+        // The fluid flow (4 -> 6) may use at most half of each 10 Mbit/s GSL, so it finishes at 2s.
+        // Until then the GSL of ground station 4 and the GSL of satellite 2 are loaded at 0.5:
+        // the TCP flow (4 -> 5) can only get 5 Mbit/s out of ground station 4 (it would take
+        // about 1s otherwise), and the UDP burst (5 -> 6) packets take twice as long
+        // to transmit at satellite 2 (+1.2 ms) and wait in the M/M/1 queue (0.5 / 0.5 * 1.2 ms).
+
+        // Fluid flow schedule
+        std::ofstream fluid_flow_schedule_file;
+        fluid_flow_schedule_file.open (temp_dir + "/fluid_flow_schedule.csv");
+        fluid_flow_schedule_file << "0,4,6,1250000,0,," << std::endl;
+        fluid_flow_schedule_file.close();
+
+        // TCP flow schedule
+        std::ofstream tcp_flow_schedule_file;
+        tcp_flow_schedule_file.open (temp_dir + "/tcp_flow_schedule.csv");
+        tcp_flow_schedule_file << "0,4,5,1000000,0,," << std::endl;
+        tcp_flow_schedule_file.close();
+
+        // UDP burst schedule
+        std::ofstream udp_burst_schedule_file;
+        udp_burst_schedule_file.open (temp_dir + "/udp_burst_schedule.csv");
+        udp_burst_schedule_file << "0,5,6,1,0,4000000000,," << std::endl;
+        udp_burst_schedule_file.close();
+
+        // TLES
+        std::ofstream tles_file;
+        tles_file.open (temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        tles_file << "Starlink-550 0" << std::endl;
+        tles_file << "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03" << std::endl;
+        tles_file << "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08" << std::endl;
+        tles_file << "Starlink-550 1" << std::endl;
+        tles_file << "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09" << std::endl;
+        tles_file << "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01" << std::endl;
+        tles_file << "Starlink-550 2" << std::endl;
+        tles_file << "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07" << std::endl;
+        tles_file << "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00" << std::endl;
+        tles_file.close();
+
+        // ISLs
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        // Ground stations
+        std::ofstream ground_stations_file;
+        ground_stations_file.open (temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "1,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "2,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file << "3,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file.close();
+
+        // GSL interfaces info
+        std::ofstream gsl_interfaces_info_file;
+        gsl_interfaces_info_file.open (temp_dir + "/gsl_interfaces_info.txt");
+        gsl_interfaces_info_file << "0,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "1,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "3,2,1.0" << std::endl;
+        gsl_interfaces_info_file << "4,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "5,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "6,1,1.0" << std::endl;
+        gsl_interfaces_info_file.close();
+
+        // Dynamic state (the same forwarding state throughout)
+        for (int64_t i = 0; i < simulation_end_time_ns; i += 100000000) {
+            std::ofstream fstate_file;
+            fstate_file.open (dyn_state_dir + "/fstate_" + std::to_string(i) + ".txt");
+            if (i == 0) {
+                fstate_file << "4,5,1,0,1" << std::endl;
+                fstate_file << "1,5,5,1,0" << std::endl;
+                fstate_file << "5,4,1,0,1" << std::endl;
+                fstate_file << "1,4,4,1,0" << std::endl;
+                fstate_file << "4,6,2,0,0" << std::endl;
+                fstate_file << "5,6,2,0,0" << std::endl;
+                fstate_file << "2,6,6,0,0" << std::endl;
+            }
+            fstate_file.close();
+
+            std::ofstream gsl_if_bandwidth_file;
+            gsl_if_bandwidth_file.open (dyn_state_dir + "/gsl_if_bandwidth_" + std::to_string(i) + ".txt");
+            gsl_if_bandwidth_file.close();
+        }
+
+        // Run the fluid flow as background of the TCP flow and the UDP burst
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable());
+        TcpFlowScheduler tcpFlowScheduler(basicSimulation, topology);
+        FluidFlowScheduler fluidFlowScheduler(basicSimulation, topology);
+        UdpBurstScheduler udpBurstScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        tcpFlowScheduler.WriteResults();
+        fluidFlowScheduler.WriteResults();
+        udpBurstScheduler.WriteResults();
+        basicSimulation->Finalize();
+
+        // The fluid flow is written apart from the TCP flows, and finishes at the capped rate
+        std::vector<std::string> lines_fluid_csv = read_file_direct(temp_dir + "/logs_ns3/fluid_flows.csv");
+        ASSERT_EQUAL(1, lines_fluid_csv.size());
+        std::vector<std::string> fluid_spl = split_string(lines_fluid_csv.at(0), ",");
+        ASSERT_EQUAL(parse_int64(fluid_spl[0]), 0);
+        ASSERT_EQUAL_APPROX(parse_int64(fluid_spl[5]), 2000000000, 100);
+        ASSERT_EQUAL(parse_int64(fluid_spl[7]), 1250000);
+        ASSERT_EQUAL(fluid_spl[8], "YES");
+
+        // The TCP flow finishes, but slower than 5 Mbit/s would allow
+        std::vector<std::string> lines_tcp_csv = read_file_direct(temp_dir + "/logs_ns3/tcp_flows.csv");
+        ASSERT_EQUAL(1, lines_tcp_csv.size());
+        std::vector<std::string> tcp_spl = split_string(lines_tcp_csv.at(0), ",");
+        ASSERT_EQUAL(parse_int64(tcp_spl[1]), 4);
+        ASSERT_EQUAL(parse_int64(tcp_spl[2]), 5);
+        ASSERT_EQUAL(tcp_spl[8], "YES");
+        ASSERT_TRUE(parse_int64(tcp_spl[5]) > 1600000000);
+
+        // One-way delay of the UDP burst packets while the background load is there, and after
+        std::map<int64_t, int64_t> sent_ns;
+        for (const std::string& line : read_file_direct(temp_dir + "/logs_ns3/udp_burst_0_outgoing.csv")) {
+            std::vector<std::string> line_spl = split_string(line, ",");
+            sent_ns[parse_int64(line_spl[1])] = parse_int64(line_spl[2]);
+        }
+        std::map<int64_t, int64_t> received_ns;
+        for (const std::string& line : read_file_direct(temp_dir + "/logs_ns3/udp_burst_0_incoming.csv")) {
+            std::vector<std::string> line_spl = split_string(line, ",");
+            received_ns[parse_int64(line_spl[1])] = parse_int64(line_spl[2]);
+        }
+        std::vector<int64_t> loaded_delays_ns = OneWayDelaysNs(sent_ns, received_ns, 500000000, 1500000000);
+        std::vector<int64_t> unloaded_delays_ns = OneWayDelaysNs(sent_ns, received_ns, 2500000000, 3500000000);
+        ASSERT_TRUE(loaded_delays_ns.size() > 50);
+        ASSERT_TRUE(unloaded_delays_ns.size() > 50);
+        double loaded_delay_ns = std::accumulate(loaded_delays_ns.begin(), loaded_delays_ns.end(), 0.0) / loaded_delays_ns.size();
+        double unloaded_delay_ns = std::accumulate(unloaded_delays_ns.begin(), unloaded_delays_ns.end(), 0.0) / unloaded_delays_ns.size();
+        ASSERT_EQUAL_APPROX(loaded_delay_ns - unloaded_delay_ns, 2400000, 300000);
+
+        // Clean up
+        remove_file_if_exists(temp_dir + "/logs_ns3/fluid_flows.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/fluid_flows.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/tcp_flows.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/tcp_flows.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_burst_0_outgoing.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_burst_0_incoming.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_outgoing.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_outgoing.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_incoming.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/gsl-handover-helper.h"
+#include "ns3/udp-burst-scheduler.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GslHandoverTestCase : public TestCase {
+public:
+    GslHandoverTestCase () : TestCase ("gsl-handover") {};
+
+    void DoRun () {
+        const double earth_radius_m = 6371000.0;
+
+        // Ground station on the equator, satellite 0 is nearest but low, satellite 1 is farther but higher
+        Vector gs(earth_radius_m, 0, 0);
+        std::vector<Vector> satellites;
+        satellites.push_back(Vector(earth_radius_m + 200000.0, 400000.0, 0));   // 447 km, elevation 26.6 deg
+        satellites.push_back(Vector(earth_radius_m + 1000000.0, 100000.0, 0));  // 1005 km, elevation 84.3 deg
+        satellites.push_back(Vector(earth_radius_m + 550000.0, 0, 0));          // Not visible in the lists below
+        std::vector<uint32_t> visible = {0, 1};
+        ASSERT_EQUAL(0, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_NEAREST, -1, visible, satellites, gs));
+        ASSERT_EQUAL(1, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_HIGHEST_ELEVATION, -1, visible, satellites, gs));
+        ASSERT_EQUAL(0, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_STICKY, -1, visible, satellites, gs));
+        ASSERT_EQUAL(1, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_STICKY, 1, visible, satellites, gs));
+        ASSERT_EQUAL(0, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_STICKY, 2, visible, satellites, gs));
+        ASSERT_EQUAL(0, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_NEAREST, 1, visible, satellites, gs));
+        ASSERT_EQUAL(-1, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_NEAREST, -1, std::vector<uint32_t>(), satellites, gs));
+        ASSERT_EQUAL(-1, GslHandoverHelper::SelectServingSatellite(GslHandoverHelper::POLICY_STICKY, 1, std::vector<uint32_t>(), satellites, gs));
+
+        // Ring 0 - 1 - 2 - 3 - 0 with a long link 3 - 0, and satellite 4 without ISLs
+        std::vector<std::vector<std::pair<uint32_t, double>>> weighted_isls(5);
+        auto add_isl = [&](uint32_t a, uint32_t b, double length) {
+            weighted_isls[a].push_back(std::make_pair(b, length));
+            weighted_isls[b].push_back(std::make_pair(a, length));
+        };
+        add_isl(0, 1, 1.0);
+        add_isl(1, 2, 1.0);
+        add_isl(2, 3, 1.0);
+        add_isl(3, 0, 10.0);
+        std::vector<int32_t> next_hops = GslHandoverHelper::CalculateNextHopsTowards(0, weighted_isls);
+        ASSERT_EQUAL(5, next_hops.size());
+        ASSERT_EQUAL(0, next_hops[0]);
+        ASSERT_EQUAL(0, next_hops[1]);
+        ASSERT_EQUAL(1, next_hops[2]);
+        ASSERT_EQUAL(2, next_hops[3]);
+        ASSERT_EQUAL(-1, next_hops[4]);
+        next_hops = GslHandoverHelper::CalculateNextHopsTowards(3, weighted_isls);
+        ASSERT_EQUAL(1, next_hops[0]);
+        ASSERT_EQUAL(2, next_hops[1]);
+        ASSERT_EQUAL(3, next_hops[2]);
+        ASSERT_EQUAL(3, next_hops[3]);
+        ASSERT_EQUAL(-1, next_hops[4]);
+        next_hops = GslHandoverHelper::CalculateNextHopsTowards(4, weighted_isls);
+        ASSERT_EQUAL(4, next_hops[4]);
+        ASSERT_EQUAL(-1, next_hops[0]);
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GslHandoverEndToEndTestCase : public TestCase {
+public:
+    GslHandoverEndToEndTestCase () : TestCase ("gsl-handover-end-to-end") {};
+
+    // Rate (Mbit/s) of the UDP burst packets of 1500 byte received in [from_ns, until_ns)
+    double ReceivedRateMegabitPerS(const std::vector<std::string>& lines_incoming_csv, int64_t from_ns, int64_t until_ns) {
+        int64_t num_received = 0;
+        for (const std::string& line : lines_incoming_csv) {
+            int64_t timestamp_ns = parse_positive_int64(split_string(line, ",")[2]);
+            if (timestamp_ns >= from_ns && timestamp_ns < until_ns) {
+                num_received++;
+            }
+        }
+        return num_received * 1500 * 8.0 / ((until_ns - from_ns) / 1000.0);
+    }
+
+    void DoRun () {
+
+        const std::string temp_dir = ".tmp-gsl-handover-end-to-end-test";
+        mkdir_if_not_exists(temp_dir);
+
+        // A configuration file
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        int64_t simulation_end_time_ns = 3000000000; // 3s
+        config_file << "simulation_end_time_ns=" << simulation_end_time_ns << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=dynamic_state" << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=100" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=100" << std::endl;
+        config_file << "enable_isl_utilization_tracking=false" << std::endl;
+        config_file << "dynamic_state_update_interval_ns=100000000" << std::endl;
+        config_file << "gsl_handover_policy=nearest" << std::endl;
+        config_file << "gsl_handover_share_satellite_bandwidth=true" << std::endl;
+        config_file << "enable_udp_burst_scheduler=true" << std::endl;
+        config_file << "udp_burst_schedule_filename=udp_burst_schedule.csv" << std::endl;
+        config_file << "udp_burst_enable_logging_for_udp_burst_ids=set(0)" << std::endl;
+        config_file.close();
+
+        // Topology
+        //
+        // Satellites:         1 ----- 0      (moving in this direction ->)
+        //
+        // Ground stations:    3    2
+        //
+        // Satellite 0 is 2 degrees ahead of satellite 1 in the same orbit. Ground station 3 is
+        // below satellite 1 and is served by it throughout. Ground station 2 is near the
+        // ground track between the two: satellite 0 is nearest until about 1.05s (by 157 m
+        // at 1.0s), after which satellite 1 is (by 158 m at 1.1s).
+        //
+        // The UDP burst (2 -> 3) of 8 Mbit/s first goes up to satellite 0 and over the ISL to
+        // satellite 1. After the handover at 1.1s it goes up to satellite 1 directly, which
+        // then has to share its 10 Mbit/s GSL between the two ground stations it serves.
+
+        // UDP burst schedule
+        std::ofstream udp_burst_schedule_file;
+        udp_burst_schedule_file.open (temp_dir + "/udp_burst_schedule.csv");
+        udp_burst_schedule_file << "0,2,3,8,0,3000000000,," << std::endl;
+        udp_burst_schedule_file.close();
+
+        // TLES
+        std::ofstream tles_file;
+        tles_file.open (temp_dir + "/tles.txt");
+        tles_file << "1 2" << std::endl;
+        tles_file << "Starlink-550 0" << std::endl;
+        tles_file << "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03" << std::endl;
+        tles_file << "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08" << std::endl;
+        tles_file << "Starlink-550 1" << std::endl;
+        tles_file << "1 01479U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04" << std::endl;
+        tles_file << "2 01479  53.0000 335.0000 0000001   0.0000  55.2727 15.19000000    06" << std::endl;
+        tles_file.close();
+
+        // ISLs
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        // Ground stations
+        std::ofstream ground_stations_file;
+        ground_stations_file.open (temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,Between,41.616338,-82.914934,0.000000,588141.688355,-4731938.955625,4235970.863083" << std::endl;
+        ground_stations_file << "1,Below,41.017740,-83.983790,0.000000,504380.918049,-4785838.726981,4185923.272954" << std::endl;
+        ground_stations_file.close();
+
+        // GSL interfaces info
+        std::ofstream gsl_interfaces_info_file;
+        gsl_interfaces_info_file.open (temp_dir + "/gsl_interfaces_info.txt");
+        gsl_interfaces_info_file << "0,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "1,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "3,1,1.0" << std::endl;
+        gsl_interfaces_info_file.close();
+
+        // Run with the serving satellites decided during the simulation (no dynamic state files)
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ASSERT_TRUE(GslHandoverHelper::IsEnabled(basicSimulation));
+        GslHandoverHelper gslHandoverHelper(basicSimulation, topology);
+        UdpBurstScheduler udpBurstScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        udpBurstScheduler.WriteResults();
+        gslHandoverHelper.WriteResults(basicSimulation->GetLogsDir());
+        basicSimulation->Finalize();
+
+        // Both ground stations are served from the start, ground station 0 is handed over once
+        const std::vector<GslHandoverHelper::Handover>& handovers = gslHandoverHelper.GetHandovers();
+        ASSERT_EQUAL(3, handovers.size());
+        ASSERT_EQUAL(0, handovers.at(0).t_ns);
+        ASSERT_EQUAL(0, handovers.at(0).gs_id);
+        ASSERT_EQUAL(-1, handovers.at(0).from_sat_id);
+        ASSERT_EQUAL(0, handovers.at(0).to_sat_id);
+        ASSERT_EQUAL(0, handovers.at(1).t_ns);
+        ASSERT_EQUAL(1, handovers.at(1).gs_id);
+        ASSERT_EQUAL(-1, handovers.at(1).from_sat_id);
+        ASSERT_EQUAL(1, handovers.at(1).to_sat_id);
+        ASSERT_EQUAL(1100000000, handovers.at(2).t_ns);
+        ASSERT_EQUAL(0, handovers.at(2).gs_id);
+        ASSERT_EQUAL(0, handovers.at(2).from_sat_id);
+        ASSERT_EQUAL(1, handovers.at(2).to_sat_id);
+        ASSERT_EQUAL(1, gslHandoverHelper.GetServingSatellites().at(0));
+        ASSERT_EQUAL(1, gslHandoverHelper.GetServingSatellites().at(1));
+        std::vector<std::string> lines_handovers_csv = read_file_direct(temp_dir + "/logs_ns3/gsl_handovers.csv");
+        ASSERT_EQUAL(3, lines_handovers_csv.size());
+        ASSERT_EQUAL("1100000000,0,0,1", lines_handovers_csv.at(2));
+
+        // The GSL of satellite 1 is shared by the two ground stations, satellite 0 keeps its own
+        for (uint32_t sat_id = 0; sat_id < 2; sat_id++) {
+            Ptr<Node> node = topology->GetSatelliteNodes().Get(sat_id);
+            for (uint32_t i = 0; i < node->GetNDevices(); i++) {
+                if (node->GetDevice(i)->GetObject<GSLNetDevice>() != 0) {
+                    DataRateValue data_rate;
+                    node->GetDevice(i)->GetAttribute("DataRate", data_rate);
+                    ASSERT_EQUAL(data_rate.Get().GetBitRate(), sat_id == 0 ? 10000000 : 5000000);
+                }
+            }
+        }
+
+        // Traffic gets through over the ISL before the handover at the full 8 Mbit/s, and
+        // after it directly from satellite 1 at its share of the GSL
+        std::vector<std::string> lines_incoming_csv = read_file_direct(temp_dir + "/logs_ns3/udp_burst_0_incoming.csv");
+        ASSERT_EQUAL_APPROX(ReceivedRateMegabitPerS(lines_incoming_csv, 200000000, 1000000000), 8.0, 0.1);
+        ASSERT_EQUAL_APPROX(ReceivedRateMegabitPerS(lines_incoming_csv, 1500000000, 3000000000), 5.0, 0.1);
+
+        // Clean up
+        remove_file_if_exists(temp_dir + "/logs_ns3/gsl_handovers.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_burst_0_outgoing.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_burst_0_incoming.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_outgoing.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_incoming.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_outgoing.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/udp_bursts_incoming.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/gsl-channel.h"
+#include "ns3/gsl-net-device.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GslVoqTestCase : public TestCase {
+public:
+    GslVoqTestCase () : TestCase ("gsl-voq") {};
+
+    std::vector<uint32_t> m_receivers;
+
+    bool Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from) {
+        m_receivers.push_back(device->GetNode()->GetId());
+        return true;
+    }
+
+    // Order in which ground station node 1 (A) and 2 (B) receive the packets sent by the
+    // satellite (node 0): first one packet to B which occupies the transmitter, then four
+    // packets of 400 byte to A, and then two packets of 1400 byte to B
+    std::vector<uint32_t> RunScheduler(GSLNetDevice::VoqScheduler scheduler) {
+
+        // Nodes at fixed positions
+        NodeContainer nodes;
+        nodes.Create(3);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+
+        // One GSL device each on the same channel
+        GSLHelper gsl_helper;
+        gsl_helper.SetQueue("ns3::GSLQueue", "MaxSize", QueueSizeValue(QueueSize("100p")));
+        gsl_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+        gsl_helper.SetDeviceAttribute("VoqScheduler", EnumValue(scheduler));
+        gsl_helper.SetDeviceAttribute("DrrQuantum", UintegerValue(1500));
+        Ptr<GSLChannel> channel = CreateObject<GSLChannel>();
+        std::vector<Ptr<GSLNetDevice>> devices;
+        for (uint32_t i = 0; i < 3; i++) {
+            devices.push_back(gsl_helper.Install(nodes.Get(i), channel));
+            devices.back()->SetReceiveCallback(MakeCallback(&GslVoqTestCase::Receive, this));
+        }
+
+        // Send everything at once
+        m_receivers.clear();
+        devices[0]->Send(Create<Packet>(100), devices[2]->GetAddress(), 0x0800);
+        for (uint32_t i = 0; i < 4; i++) {
+            devices[0]->Send(Create<Packet>(400), devices[1]->GetAddress(), 0x0800);
+        }
+        for (uint32_t i = 0; i < 2; i++) {
+            devices[0]->Send(Create<Packet>(1400), devices[2]->GetAddress(), 0x0800);
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+
+        // Leave out the first packet
+        return std::vector<uint32_t>(m_receivers.begin() + 1, m_receivers.end());
+    }
+
+    void DoRun () {
+
+        // Single FIFO queue: in order of sending
+        std::vector<uint32_t> fifo = RunScheduler(GSLNetDevice::VOQ_NONE);
+        ASSERT_TRUE(fifo == std::vector<uint32_t>({1, 1, 1, 1, 2, 2}));
+
+        // Round-robin: one packet per destination in turn
+        std::vector<uint32_t> rr = RunScheduler(GSLNetDevice::VOQ_RR);
+        ASSERT_TRUE(rr == std::vector<uint32_t>({1, 2, 1, 2, 1, 1}));
+
+        // Deficit round-robin: up to 1500 byte per destination in turn (including the 2 byte PPP header),
+        // so three small packets to A for each large packet to B
+        std::vector<uint32_t> drr = RunScheduler(GSLNetDevice::VOQ_DRR);
+        ASSERT_TRUE(drr == std::vector<uint32_t>({1, 1, 1, 2, 1, 2}));
+
+    }
+};
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/julian-date.h"
+#include "ns3/satellite.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class JulianDateTestCase : public TestCase {
+public:
+    JulianDateTestCase () : TestCase ("julian-date") {};
+
+    void DoRun () {
+
+        JulianDate jd(18000, 12345678);
+
+        // Sub-millisecond offsets are kept
+        ASSERT_EQUAL((jd + NanoSeconds(1500)) - jd, NanoSeconds(1500));
+        ASSERT_EQUAL((jd + NanoSeconds(1)) - jd, NanoSeconds(1));
+        ASSERT_TRUE(jd + NanoSeconds(1) != jd);
+        ASSERT_TRUE(jd < jd + NanoSeconds(1));
+        ASSERT_TRUE(jd - NanoSeconds(1) < jd);
+
+        // Round trips, including negative offsets and offsets of several days
+        std::vector<Time> offsets = {
+                NanoSeconds(1), NanoSeconds(999999), NanoSeconds(1000001), NanoSeconds(123456789),
+                Seconds(86400) - NanoSeconds(1), Seconds(86400), Seconds(3 * 86400) + NanoSeconds(5),
+                NanoSeconds(-1), NanoSeconds(-2500), NanoSeconds(-123456789), Seconds(-3 * 86400) - NanoSeconds(5)
+        };
+        for (const Time& t : offsets) {
+            ASSERT_TRUE((jd + t) - t == jd);
+            ASSERT_TRUE((jd - t) + t == jd);
+            ASSERT_EQUAL((jd + t) - jd, t);
+            ASSERT_EQUAL(jd - (jd - t), t);
+            JulianDate moved = jd;
+            moved += t;
+            ASSERT_TRUE(moved == jd + t);
+            moved -= t;
+            ASSERT_TRUE(moved == jd);
+        }
+
+        // Negative offsets are the same as the opposite operation
+        ASSERT_TRUE(jd + NanoSeconds(-2500) == jd - NanoSeconds(2500));
+        ASSERT_TRUE(jd - NanoSeconds(-2500) == jd + NanoSeconds(2500));
+        ASSERT_EQUAL((jd + NanoSeconds(-2500)) - jd, NanoSeconds(-2500));
+
+        // Carry into the next day
+        JulianDate last_ms(18000, JulianDate::DayToMs - 1);
+        ASSERT_TRUE(last_ms + MilliSeconds(2) == JulianDate(18001, 1));
+        ASSERT_TRUE(last_ms + MilliSeconds(1) == JulianDate(18001, 0));
+        ASSERT_TRUE(last_ms + NanoSeconds(999999) < JulianDate(18001, 0));
+        ASSERT_EQUAL(JulianDate(18001, 0) - (last_ms + NanoSeconds(999999)), NanoSeconds(1));
+
+        // Borrow from the previous day
+        JulianDate midnight(18001, 0);
+        ASSERT_TRUE(midnight - MilliSeconds(1) == last_ms);
+        ASSERT_TRUE(midnight - NanoSeconds(1) == last_ms + NanoSeconds(999999));
+        ASSERT_TRUE((midnight + NanoSeconds(1)) - MilliSeconds(1) == last_ms + NanoSeconds(1));
+        ASSERT_TRUE(midnight - Seconds(86400) - NanoSeconds(1) == JulianDate(17999, JulianDate::DayToMs - 1) + NanoSeconds(999999));
+
+        // Differences across days
+        ASSERT_EQUAL(JulianDate(18002, 1) - JulianDate(18000, JulianDate::DayToMs - 1), MilliSeconds(JulianDate::DayToMs + 2));
+        ASSERT_EQUAL((JulianDate(18000, JulianDate::DayToMs - 1) - JulianDate(18002, 1)).GetNanoSeconds(), -((int64_t) JulianDate::DayToMs + 2) * 1000000);
+
+        // The position at minutes since the TLE epoch is the position at the same date
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName("ISS (ZARYA)");
+        satellite->SetTleInfo(
+                "1 25544U 98067A   20274.52061263  .00002472  00000-0  53335-4 0  9998",
+                "2 25544  51.6445 187.2657 0001412 107.7286  78.8629 15.48811122248346"
+        );
+        JulianDate epoch = satellite->GetTleEpoch();
+        std::vector<double> tsinces = {0.0, 1e-8, 0.5, 1.2345678, 90.0, 1440.75, -30.25};
+        for (double tsince : tsinces) {
+            Vector3D at_tsince = satellite->GetPositionAtTsince(tsince);
+            Vector3D at_date = satellite->GetPosition(epoch + NanoSeconds((int64_t) std::llround(tsince * 6e10)));
+            ASSERT_TRUE(CalculateDistance(at_tsince, at_date) <= 1e-3);
+        }
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/gsl-channel.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/point-to-point-laser-net-device.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LinkFramingTestCase : public TestCase {
+public:
+    LinkFramingTestCase () : TestCase ("link-framing") {};
+
+    struct Received {
+        uint16_t protocol;
+        uint32_t size_byte;
+        int64_t time_ns;
+    };
+    std::vector<Received> m_received;
+
+    bool Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from) {
+        m_received.push_back({protocol, packet->GetSize(), Simulator::Now().GetNanoSeconds()});
+        return true;
+    }
+
+    // An IPv4 packet and an IPv6 packet of 1000 byte (including the IP header) over a 1 Mbit/s link
+    void SendIpPackets(Ptr<NetDevice> from, Ptr<NetDevice> to) {
+        Ptr<Packet> ipv4 = Create<Packet>(1000 - 20);
+        Ipv4Header ipv4_header;
+        ipv4_header.SetPayloadSize(ipv4->GetSize());
+        ipv4->AddHeader(ipv4_header);
+        from->Send(ipv4, to->GetAddress(), 0x0800);
+        Ptr<Packet> ipv6 = Create<Packet>(1000 - 40);
+        Ipv6Header ipv6_header;
+        ipv6_header.SetPayloadLength(ipv6->GetSize());
+        ipv6->AddHeader(ipv6_header);
+        from->Send(ipv6, to->GetAddress(), 0x86DD);
+    }
+
+    std::vector<Received> RunGsl(GSLNetDevice::Framing framing) {
+        NodeContainer nodes;
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        GSLHelper gsl_helper;
+        gsl_helper.SetQueue("ns3::GSLQueue", "MaxSize", QueueSizeValue(QueueSize("100p")));
+        gsl_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+        gsl_helper.SetDeviceAttribute("Framing", EnumValue(framing));
+        Ptr<GSLChannel> channel = CreateObject<GSLChannel>();
+        Ptr<GSLNetDevice> dev_a = gsl_helper.Install(nodes.Get(0), channel);
+        Ptr<GSLNetDevice> dev_b = gsl_helper.Install(nodes.Get(1), channel);
+        dev_b->SetReceiveCallback(MakeCallback(&LinkFramingTestCase::Receive, this));
+        m_received.clear();
+        SendIpPackets(dev_a, dev_b);
+        Simulator::Run();
+        Simulator::Destroy();
+        return m_received;
+    }
+
+    std::vector<Received> RunIsl(PointToPointLaserNetDevice::Framing framing) {
+        NodeContainer nodes;
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        PointToPointLaserHelper p2p_laser_helper;
+        p2p_laser_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("100p")));
+        p2p_laser_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+        p2p_laser_helper.SetDeviceAttribute("Framing", EnumValue(framing));
+        NetDeviceContainer devices = p2p_laser_helper.Install(nodes.Get(0), nodes.Get(1));
+        devices.Get(1)->SetReceiveCallback(MakeCallback(&LinkFramingTestCase::Receive, this));
+        m_received.clear();
+        SendIpPackets(devices.Get(0), devices.Get(1));
+        Simulator::Run();
+        Simulator::Destroy();
+        return m_received;
+    }
+
+    void CheckFraming(const std::vector<Received>& ppp, const std::vector<Received>& none) {
+
+        // Either way the protocol arrives and the IP packet is passed up unchanged
+        ASSERT_EQUAL(2, ppp.size());
+        ASSERT_EQUAL(2, none.size());
+        for (const std::vector<Received>& received : {ppp, none}) {
+            ASSERT_EQUAL(0x0800, received[0].protocol);
+            ASSERT_EQUAL(1000, received[0].size_byte);
+            ASSERT_EQUAL(0x86DD, received[1].protocol);
+            ASSERT_EQUAL(1000, received[1].size_byte);
+        }
+
+        // Without the 2 byte PPP header, each frame takes 16 us less to transmit at 1 Mbit/s
+        ASSERT_EQUAL(16000, ppp[0].time_ns - none[0].time_ns);
+        ASSERT_EQUAL(32000, ppp[1].time_ns - none[1].time_ns);
+
+    }
+
+    void DoRun () {
+        CheckFraming(RunGsl(GSLNetDevice::FRAMING_PPP), RunGsl(GSLNetDevice::FRAMING_NONE));
+        CheckFraming(RunIsl(PointToPointLaserNetDevice::FRAMING_PPP), RunIsl(PointToPointLaserNetDevice::FRAMING_NONE));
+    }
+};
@@ -161,7 +161,7 @@ public:
         if (new_prop_speed) {
             gsl_helper.SetChannelAttribute ( "PropagationSpeed", DoubleValue(new_prop_speed_m_per_s));
         }
-        gsl_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("100p")));
+        gsl_helper.SetQueue("ns3::GSLQueue", "MaxSize", QueueSizeValue(QueueSize("100p")));
         gsl_helper.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("7Mbps")));
 
         // Traffic control helper
@@ -217,7 +217,7 @@ public:
             } else if (i == 3) {
                 ASSERT_EQUAL(gslNetDevice->GetIfIndex(), 1);
             }
-            Ptr<DropTailQueue<Packet>> queue = gslNetDevice->GetQueue()->GetObject<DropTailQueue<Packet>>();
+            Ptr<GSLQueue> queue = gslNetDevice->GetQueue();
             QueueSize qs = queue->GetMaxSize();
             ASSERT_EQUAL(qs.GetUnit(), ns3::PACKETS);
             ASSERT_EQUAL(qs.GetValue(), 100);
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/node-interface-table.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/gsl-helper.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class NodeInterfaceTableTestCase : public TestCase {
+public:
+    NodeInterfaceTableTestCase () : TestCase ("node-interface-table") {};
+
+    void DoRun () {
+
+        // Satellites 0 and 1 with an ISL, ground stations 2 and 3, each node with one GSL
+        NodeContainer satellites;
+        satellites.Create(2);
+        NodeContainer ground_stations;
+        ground_stations.Create(2);
+        NodeContainer nodes;
+        nodes.Add(satellites);
+        nodes.Add(ground_stations);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        InternetStackHelper internet;
+        internet.Install(nodes);
+        Ipv4AddressHelper ipv4_helper("10.0.0.0", "255.255.255.0");
+        PointToPointLaserHelper p2p_laser_helper;
+        ipv4_helper.Assign(p2p_laser_helper.Install(satellites.Get(0), satellites.Get(1)));
+        ipv4_helper.NewNetwork();
+        GSLHelper gsl_helper;
+        std::vector<std::tuple<int32_t, double>> node_gsl_if_info(4, std::make_tuple(1, 1.0));
+        NetDeviceContainer gsl_devices = gsl_helper.Install(satellites, ground_stations, node_gsl_if_info);
+        for (uint32_t i = 0; i < gsl_devices.GetN(); i++) {
+            ipv4_helper.Assign(gsl_devices.Get(i));
+            ipv4_helper.NewNetwork();
+        }
+
+        // Same as retrieved from the nodes
+        NodeInterfaceTable table(nodes);
+        ASSERT_EQUAL(4, table.GetNNodes());
+        for (uint32_t i = 0; i < nodes.GetN(); i++) {
+            Ptr<Ipv4> ipv4 = nodes.Get(i)->GetObject<Ipv4>();
+            ASSERT_TRUE(table.GetIpv4(i) == PeekPointer(nodes.Get(i)->GetObject<Ipv4L3Protocol>()));
+            ASSERT_EQUAL(ipv4->GetNInterfaces(), table.GetNInterfaces(i));
+            for (uint32_t j = 0; j < ipv4->GetNInterfaces(); j++) {
+                ASSERT_TRUE(table.GetNetDevice(i, j) == PeekPointer(ipv4->GetNetDevice(j)));
+                ASSERT_TRUE(table.GetGslNetDevice(i, j) == PeekPointer(ipv4->GetNetDevice(j)->GetObject<GSLNetDevice>()));
+                ASSERT_TRUE(table.GetIslNetDevice(i, j) == PeekPointer(ipv4->GetNetDevice(j)->GetObject<PointToPointLaserNetDevice>()));
+                ASSERT_EQUAL(ipv4->GetAddress(j, 0).GetLocal().Get(), table.GetLocalAddress(i, j).Get());
+            }
+        }
+
+        // Satellites: loop-back, ISL, GSL; ground stations: loop-back, GSL
+        ASSERT_EQUAL(3, table.GetNInterfaces(0));
+        ASSERT_TRUE(table.GetIslNetDevice(0, 1) != nullptr);
+        ASSERT_TRUE(table.GetGslNetDevice(0, 1) == nullptr);
+        ASSERT_TRUE(table.GetGslNetDevice(0, 2) != nullptr);
+        ASSERT_EQUAL(2, table.GetNInterfaces(3));
+        ASSERT_TRUE(table.GetGslNetDevice(3, 1) == PeekPointer(gsl_devices.Get(3)->GetObject<GSLNetDevice>()));
+        ASSERT_EQUAL(Ipv4Address("127.0.0.1").Get(), table.GetLocalAddress(2, 0).Get());
+
+        Simulator::Destroy();
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+
+#include "ns3/packet.h"
+#include "ns3/exp-util.h"
+#include "ns3/packet-event-tracer.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PacketEventTracerTestCase : public TestCase {
+public:
+    PacketEventTracerTestCase () : TestCase ("packet-event-tracer") {};
+
+    void DoRun () {
+        const std::string temp_dir = ".tmp-packet-event-tracer-test";
+        mkdir_if_not_exists(temp_dir);
+
+        // A ring buffer of only 4 records, such that it wraps around and fills up
+        std::vector<Ptr<Packet>> packets;
+        {
+            PacketEventTracer tracer(3);
+            tracer.Start(temp_dir + "/packet_events.bin");
+            for (uint32_t i = 0; i < 100; i++) {
+                packets.push_back(Create<Packet>(100 + i));
+                tracer.Add(i % 7, i % 3, (PacketEventTracer::EventType) (i % 4), packets.back());
+            }
+            ASSERT_EQUAL(100, tracer.GetNumRecords());
+            tracer.Close();
+        }
+
+        // All records are decoded in order
+        ASSERT_EQUAL(100, PacketEventTracer::DecodeToCsv(temp_dir + "/packet_events.bin", temp_dir + "/packet_events.csv"));
+        std::vector<std::string> lines = read_file_direct(temp_dir + "/packet_events.csv");
+        ASSERT_EQUAL(100, lines.size());
+        const std::vector<std::string> event_types = {"MacTx", "MacTxDrop", "PhyTxBegin", "PhyRxEnd"};
+        for (uint32_t i = 0; i < lines.size(); i++) {
+            std::vector<std::string> spl = split_string(lines[i], ",", 6);
+            ASSERT_EQUAL(0, parse_positive_int64(spl[0]));
+            ASSERT_EQUAL(i % 7, parse_positive_int64(spl[1]));
+            ASSERT_EQUAL(i % 3, parse_positive_int64(spl[2]));
+            ASSERT_EQUAL(packets[i]->GetUid(), parse_positive_int64(spl[3]));
+            ASSERT_EQUAL(100 + i, parse_positive_int64(spl[4]));
+            ASSERT_EQUAL(event_types[i % 4], spl[5]);
+        }
+
+        // Only a packet event trace can be decoded
+        ASSERT_EXCEPTION(PacketEventTracer::DecodeToCsv(temp_dir + "/packet_events.csv", temp_dir + "/packet_events_2.csv"));
+
+        remove_file_if_exists(temp_dir + "/packet_events.bin");
+        remove_file_if_exists(temp_dir + "/packet_events.csv");
+        remove_file_if_exists(temp_dir + "/packet_events_2.csv");
+        remove_dir_if_exists(temp_dir);
+    }
+};
@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+#include <cstring>
+
+#include "ns3/exp-util.h"
+#include "ns3/parallel-chunk-writer.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ParallelChunkWriterTestCase : public TestCase {
+public:
+    ParallelChunkWriterTestCase () : TestCase ("parallel-chunk-writer") {};
+
+    void DoRun () {
+        const std::string temp_dir = ".tmp-parallel-chunk-writer-test";
+        mkdir_if_not_exists(temp_dir);
+
+        // Single-threaded and multi-threaded (over several windows) produce the same file
+        for (uint32_t num_threads : {1, 3}) {
+            ParallelChunkWriter writer(num_threads);
+            ASSERT_EQUAL(num_threads, writer.GetNumThreads());
+            FILE* file = fopen((temp_dir + "/chunks.csv").c_str(), "wb");
+            writer.Write(file, 1000, [](size_t i, std::string& buffer) {
+                for (size_t j = 0; j < i % 3; j++) {
+                    ParallelChunkWriter::AppendFormat(buffer, "%u,%u,%s\n", (uint32_t) i, (uint32_t) j, std::string(200, 'x').c_str());
+                }
+            });
+            fclose(file);
+
+            // Lines in chunk order (chunks with i % 3 == 0 are empty)
+            std::vector<std::string> lines = read_file_direct(temp_dir + "/chunks.csv");
+            ASSERT_EQUAL(999, lines.size());
+            size_t line = 0;
+            for (size_t i = 0; i < 1000; i++) {
+                for (size_t j = 0; j < i % 3; j++) {
+                    std::vector<std::string> spl = split_string(lines[line], ",", 3);
+                    ASSERT_EQUAL(i, parse_positive_int64(spl[0]));
+                    ASSERT_EQUAL(j, parse_positive_int64(spl[1]));
+                    ASSERT_EQUAL(200, spl[2].size());
+                    line++;
+                }
+            }
+        }
+
+        // Binary appends are the raw bytes
+        std::string buffer;
+        ParallelChunkWriter::AppendBinary(buffer, (int32_t) 7);
+        ParallelChunkWriter::AppendBinary(buffer, (int64_t) -1);
+        ASSERT_EQUAL(12, buffer.size());
+        int32_t value;
+        memcpy(&value, buffer.data(), sizeof(int32_t));
+        ASSERT_EQUAL(7, value);
+
+        remove_file_if_exists(temp_dir + "/chunks.csv");
+        remove_dir_if_exists(temp_dir);
+    }
+};
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "ns3/satellite.h"
+#include "ns3/satellite-ephemeris.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteEphemerisTestCase : public TestCase {
+public:
+    SatelliteEphemerisTestCase () : TestCase ("satellite-ephemeris") {};
+
+    void DoRun () {
+
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName("ISS (ZARYA)");
+        satellite->SetTleInfo(
+                "1 25544U 98067A   20274.52061263  .00002472  00000-0  53335-4 0  9998",
+                "2 25544  51.6445 187.2657 0001412 107.7286  78.8629 15.48811122248346"
+        );
+        JulianDate start = satellite->GetTleEpoch() + Seconds(30);
+
+        // 100 ms step over 20 s: 202 samples, 4 segments
+        Time step = MilliSeconds(100);
+        Time duration = Seconds(20);
+        Ptr<SatelliteEphemeris> float64 = Create<SatelliteEphemeris>(satellite, start, step, duration, SatelliteEphemeris::STORAGE_FLOAT64);
+        Ptr<SatelliteEphemeris> float32 = Create<SatelliteEphemeris>(satellite, start, step, duration, SatelliteEphemeris::STORAGE_FLOAT32);
+        Ptr<SatelliteEphemeris> int32_mm = Create<SatelliteEphemeris>(satellite, start, step, duration, SatelliteEphemeris::STORAGE_INT32_MM);
+        ASSERT_EQUAL(202, float64->GetNumSamples());
+        ASSERT_EQUAL(202 * 24, float64->GetMemoryBytes());
+        ASSERT_EQUAL(202 * 12 + 4 * 24, float32->GetMemoryBytes());
+        ASSERT_EQUAL(202 * 12 + 4 * 24, int32_mm->GetMemoryBytes());
+        ASSERT_TRUE(float64->Covers(Seconds(0)));
+        ASSERT_TRUE(float64->Covers(duration));
+        ASSERT_FALSE(float64->Covers(NanoSeconds(-1)));
+        ASSERT_FALSE(float64->Covers(step * 202));
+
+        // Storage error within the documented bounds (segments of 6.4 s at < 8 km/s for float32)
+        ASSERT_EQUAL(0.0, float64->GetMaxStorageError());
+        ASSERT_TRUE(float32->GetMaxStorageError() <= std::sqrt(3.0) * std::ldexp(6.4 * 8000.0, -24));
+        ASSERT_TRUE(int32_mm->GetMaxStorageError() <= std::sqrt(3.0) * 0.0005);
+
+        // On the samples and in between them, compared to the propagated position
+        // (interpolation adds at most 11.5 * 0.1^2 / 8 = 14.375 mm per component)
+        for (int64_t t_ms = 0; t_ms <= 20000; t_ms += 25) {
+            Time t = MilliSeconds(t_ms);
+            Vector3D exact = satellite->GetPosition(start + t);
+            double interpolation_bound = (t_ms % 100 == 0 ? 1e-6 : std::sqrt(3.0) * 0.014375);
+            ASSERT_TRUE(CalculateDistance(float64->GetPosition(t), exact) <= interpolation_bound);
+            ASSERT_TRUE(CalculateDistance(float32->GetPosition(t), exact) <= interpolation_bound + float32->GetMaxStorageError());
+            ASSERT_TRUE(CalculateDistance(int32_mm->GetPosition(t), exact) <= interpolation_bound + int32_mm->GetMaxStorageError());
+        }
+
+        // Outside of the interval it is clamped
+        ASSERT_EQUAL_APPROX(CalculateDistance(float64->GetPosition(Seconds(-1)), float64->GetPosition(Seconds(0))), 0.0, 1e-9);
+        ASSERT_EQUAL_APPROX(CalculateDistance(float64->GetPosition(Seconds(30)), float64->GetPosition(step * 201)), 0.0, 1e-9);
+
+        // Concurrent propagation of the same satellite (each thread on its own copy of
+        // the record) gives the same positions as serial
+        const Satellite* sat = PeekPointer(satellite);
+        std::vector<Vector3D> serial;
+        for (int i = 0; i < 400; i++) {
+            serial.push_back(sat->GetPositionAtTsince(i * 0.5));
+        }
+        std::vector<Vector3D> concurrent(serial.size());
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&concurrent, sat, t]() {
+                elsetrec record = sat->GetSgp4Record();
+                for (size_t i = t; i < concurrent.size(); i += 4) {
+                    concurrent[i] = sat->GetPositionAtTsince(i * 0.5, record);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        for (size_t i = 0; i < serial.size(); i++) {
+            ASSERT_EQUAL(serial[i].x, concurrent[i].x);
+            ASSERT_EQUAL(serial[i].y, concurrent[i].y);
+            ASSERT_EQUAL(serial[i].z, concurrent[i].z);
+        }
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
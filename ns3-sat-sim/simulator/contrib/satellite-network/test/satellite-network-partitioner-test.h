@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+
+#include "ns3/satellite.h"
+#include "ns3/vector-extensions.h"
+#include "ns3/satellite-network-partitioner.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteNetworkPartitionerTestCase : public TestCase {
+public:
+    SatelliteNetworkPartitionerTestCase () : TestCase ("satellite-network-partitioner") {};
+
+    Ptr<Satellite> CreateSatellite(const std::string& tle1, const std::string& tle2) {
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName("Starlink-550");
+        satellite->SetTleInfo(tle1, tle2);
+        return satellite;
+    }
+
+    void DoRun () {
+
+        // Three planes (RAAN 335, 340 and 350), of which the first has two satellites
+        std::vector<Ptr<Satellite>> satellites;
+        satellites.push_back(CreateSatellite(
+                "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03",
+                "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08"
+        ));
+        satellites.push_back(CreateSatellite(
+                "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09",
+                "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01"
+        ));
+        satellites.push_back(CreateSatellite(
+                "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07",
+                "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00"
+        ));
+        satellites.push_back(CreateSatellite(
+                "1 01479U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+                "2 01479  53.0000 335.0000 0000001   0.0000 237.2727 15.19000000    01"
+        ));
+
+        // Planes are numbered by RAAN
+        std::vector<uint32_t> planes = SatelliteNetworkPartitioner::DetermineOrbitalPlanes(satellites);
+        ASSERT_EQUAL(4, planes.size());
+        ASSERT_EQUAL(0, planes[0]);
+        ASSERT_EQUAL(1, planes[1]);
+        ASSERT_EQUAL(2, planes[2]);
+        ASSERT_EQUAL(0, planes[3]);
+
+        // One system: everything on it
+        SatelliteNetworkPartitioner single(1);
+        for (uint32_t system_id : single.AssignSatellites(satellites)) {
+            ASSERT_EQUAL(0, system_id);
+        }
+
+        // Two systems: whole planes, two satellites each
+        SatelliteNetworkPartitioner partitioner(2);
+        std::vector<uint32_t> satellite_system_ids = partitioner.AssignSatellites(satellites);
+        ASSERT_EQUAL(0, satellite_system_ids[0]);
+        ASSERT_EQUAL(1, satellite_system_ids[1]);
+        ASSERT_EQUAL(1, satellite_system_ids[2]);
+        ASSERT_EQUAL(0, satellite_system_ids[3]);
+
+        // A ground station goes to the system of the nearest satellite
+        std::vector<Vector> ground_station_positions;
+        ground_station_positions.push_back(satellites[2]->GetPosition(satellites[2]->GetTleEpoch()) * 0.95);
+        ground_station_positions.push_back(satellites[3]->GetPosition(satellites[3]->GetTleEpoch()) * 0.95);
+        std::vector<uint32_t> ground_station_system_ids = partitioner.AssignGroundStations(ground_station_positions);
+        ASSERT_EQUAL(1, ground_station_system_ids[0]);
+        ASSERT_EQUAL(0, ground_station_system_ids[1]);
+
+        // A ring of ISLs 0 - 1 - 2 - 3 - 0 crosses the two systems twice (0 - 1 and 2 - 3)
+        std::vector<std::pair<int32_t, int32_t>> isls = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+        SatelliteNetworkPartitioner::Statistics statistics = SatelliteNetworkPartitioner::Evaluate(
+                2, satellite_system_ids, ground_station_system_ids, isls
+        );
+        ASSERT_EQUAL(2, statistics.num_satellites.size());
+        ASSERT_EQUAL(2, statistics.num_satellites[0]);
+        ASSERT_EQUAL(2, statistics.num_satellites[1]);
+        ASSERT_EQUAL(1, statistics.num_ground_stations[0]);
+        ASSERT_EQUAL(1, statistics.num_ground_stations[1]);
+        ASSERT_EQUAL(2, statistics.num_cut_isls[0]);
+        ASSERT_EQUAL(2, statistics.num_cut_isls[1]);
+        ASSERT_EQUAL(4, statistics.num_isls);
+        ASSERT_EQUAL(2, statistics.total_cut_isls);
+
+        // Uneven assignment: system 2 is empty, the ISLs of satellite 1 are both cut
+        statistics = SatelliteNetworkPartitioner::Evaluate(3, {0, 1, 0, 0}, {0, 0}, isls);
+        ASSERT_EQUAL(3, statistics.num_satellites.size());
+        ASSERT_EQUAL(3, statistics.num_satellites[0]);
+        ASSERT_EQUAL(1, statistics.num_satellites[1]);
+        ASSERT_EQUAL(0, statistics.num_satellites[2]);
+        ASSERT_EQUAL(2, statistics.num_ground_stations[0]);
+        ASSERT_EQUAL(0, statistics.num_ground_stations[1]);
+        ASSERT_EQUAL(0, statistics.num_ground_stations[2]);
+        ASSERT_EQUAL(2, statistics.num_cut_isls[0]);
+        ASSERT_EQUAL(2, statistics.num_cut_isls[1]);
+        ASSERT_EQUAL(0, statistics.num_cut_isls[2]);
+        ASSERT_EQUAL(2, statistics.total_cut_isls);
+
+        // On one system nothing is cut
+        statistics = SatelliteNetworkPartitioner::Evaluate(1, {0, 0, 0, 0}, {0, 0}, isls);
+        ASSERT_EQUAL(4, statistics.num_satellites[0]);
+        ASSERT_EQUAL(0, statistics.num_cut_isls[0]);
+        ASSERT_EQUAL(0, statistics.total_cut_isls);
+
+        // Perigee of a (nearly) circular orbit with 15.19 revolutions per day is about 510 km above the Earth
+        ASSERT_EQUAL_APPROX(6378135.0 + 510000.0, satellites[0]->GetPerigeeRadius(), 30000.0);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -5,8 +5,22 @@
 #include "end-to-end-test.h"
 #include "manual-two-sat-two-gs-test.h"
 #include "satellite-info-test.h"
+#include "satellite-ephemeris-test.h"
+#include "julian-date-test.h"
+#include "satellite-visibility-index-test.h"
+#include "gsl-handover-test.h"
+#include "node-interface-table-test.h"
+#include "fluid-flow-scheduler-test.h"
 #include "ground-station-info-test.h"
 #include "end-to-end-special-test.h"
+#include "topology-snapshot-test.h"
+#include "satellite-network-partitioner-test.h"
+#include "gsl-voq-test.h"
+#include "link-framing-test.h"
+#include "background-load-test.h"
+#include "utilization-tracker-test.h"
+#include "packet-event-tracer-test.h"
+#include "parallel-chunk-writer-test.h"
 
 using namespace ns3;
 
@@ -17,6 +31,10 @@ public:
         // Running it complete with reading in files etc.
         AddTestCase(new EndToEndTestCase, TestCase::QUICK);
         AddTestCase(new EndToEndSpecialTestCase, TestCase::QUICK);
+        AddTestCase(new TopologySnapshotTestCase, TestCase::QUICK);
+        AddTestCase(new FluidFlowSchedulerEndToEndTestCase, TestCase::QUICK);
+        AddTestCase(new FluidFlowSchedulerBackgroundTestCase, TestCase::QUICK);
+        AddTestCase(new GslHandoverEndToEndTestCase, TestCase::QUICK);
 
         // Running it by creating every component manually (not using satellite-network.cc/h)
         AddTestCase(new ManualTwoSatTwoGsFirstTest, TestCase::QUICK);
@@ -26,11 +44,28 @@ public:
         AddTestCase(new ManualTwoSatTwoGsDownBothFullTest, TestCase::QUICK);
         AddTestCase(new ManualTwoSatTwoGsChangingForwardingTest, TestCase::QUICK);
         AddTestCase(new ManualTwoSatTwoGsChangingRateTest, TestCase::QUICK);
+        AddTestCase(new GslVoqTestCase, TestCase::QUICK);
+        AddTestCase(new LinkFramingTestCase, TestCase::QUICK);
+        AddTestCase(new BackgroundLoadTestCase, TestCase::QUICK);
+        AddTestCase(new GslHandoverTestCase, TestCase::QUICK);
+        AddTestCase(new NodeInterfaceTableTestCase, TestCase::QUICK);
+        AddTestCase(new FluidFlowSchedulerTestCase, TestCase::QUICK);
 
         // Simple info wrappers
         AddTestCase(new SatelliteInfoTestCase, TestCase::QUICK);
+        AddTestCase(new SatelliteEphemerisTestCase, TestCase::QUICK);
+        AddTestCase(new JulianDateTestCase, TestCase::QUICK);
+        AddTestCase(new SatelliteVisibilityIndexTestCase, TestCase::QUICK);
         AddTestCase(new GroundStationInfoTestCase, TestCase::QUICK);
 
+        // Utilization tracking and tracing
+        AddTestCase(new UtilizationTrackerTestCase, TestCase::QUICK);
+        AddTestCase(new PacketEventTracerTestCase, TestCase::QUICK);
+        AddTestCase(new ParallelChunkWriterTestCase, TestCase::QUICK);
+
+        // Distributed simulation
+        AddTestCase(new SatelliteNetworkPartitionerTestCase, TestCase::QUICK);
+
     }
 };
 static SatelliteNetworkTestSuite SatelliteNetworkTestSuite;
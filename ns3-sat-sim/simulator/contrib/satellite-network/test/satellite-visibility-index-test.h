@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ns3/satellite-visibility-index.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteVisibilityIndexTestCase : public TestCase {
+public:
+    SatelliteVisibilityIndexTestCase () : TestCase ("satellite-visibility-index") {};
+
+    void DoRun () {
+        const double earth_radius_m = 6371000.0;
+        const double sat_radius_m = earth_radius_m + 550000.0;
+
+        // Ground station on the equator at longitude 179 degrees (the index wraps around)
+        Vector gs(earth_radius_m * std::cos(179.0 * M_PI / 180.0), earth_radius_m * std::sin(179.0 * M_PI / 180.0), 0);
+        std::vector<Vector> satellites;
+        satellites.push_back(Vector(gs.x / earth_radius_m * sat_radius_m, gs.y / earth_radius_m * sat_radius_m, 0)); // Overhead
+        satellites.push_back(Vector(-sat_radius_m, -1.0, 0));                                                          // Lon. -180, 1 degree away
+        satellites.push_back(Vector(sat_radius_m, 0, 0));                                                              // Other side
+        satellites.push_back(Vector(0, 0, sat_radius_m));                                                              // Above the north pole
+        SatelliteVisibilityIndex index(5.0);
+        index.Build(satellites);
+        ASSERT_EQUAL(4, index.GetNumSatellites());
+        ASSERT_EQUAL_APPROX(SatelliteVisibilityIndex::CalculateElevationDeg(gs, satellites[0]), 90.0, 1e-6);
+        ASSERT_TRUE(SatelliteVisibilityIndex::CalculateElevationDeg(gs, satellites[2]) < 0);
+        std::vector<uint32_t> visible = index.GetVisibleSatellites(gs, 25.0);
+        ASSERT_EQUAL(2, visible.size());
+        ASSERT_EQUAL(0, visible[0]);
+        ASSERT_EQUAL(1, visible[1]);
+        ASSERT_EQUAL(1, index.GetVisibleSatellites(gs, 90.0 - 1e-6).size());
+
+        // Same result as checking every satellite, for random positions and several cell sizes
+        // (including ones which do not divide 360 degrees)
+        std::mt19937 rng(12345);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        std::uniform_real_distribution<double> uniform_altitude(300000.0, 1300000.0);
+        auto random_direction = [&]() {
+            double x = normal(rng), y = normal(rng), z = normal(rng);
+            double n = std::sqrt(x * x + y * y + z * z);
+            return Vector(x / n, y / n, z / n);
+        };
+        for (double cell_size_deg : {1.0, 5.0, 7.0, 45.0, 180.0}) {
+            SatelliteVisibilityIndex random_index(cell_size_deg);
+            std::vector<Vector> random_satellites;
+            for (int i = 0; i < 1000; i++) {
+                Vector d = random_direction();
+                double r = earth_radius_m + uniform_altitude(rng);
+                random_satellites.push_back(Vector(d.x * r, d.y * r, d.z * r));
+            }
+            random_index.Build(random_satellites);
+            for (int g = 0; g < 50; g++) {
+                Vector d = g == 0 ? Vector(0, 0, 1) : random_direction();
+                Vector ground(d.x * earth_radius_m, d.y * earth_radius_m, d.z * earth_radius_m);
+                for (double min_elevation_deg : {0.0, 10.0, 25.0, 60.0}) {
+                    ASSERT_TRUE(random_index.GetVisibleSatellites(ground, min_elevation_deg) == random_index.GetVisibleSatellitesBruteForce(ground, min_elevation_deg));
+                }
+            }
+        }
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
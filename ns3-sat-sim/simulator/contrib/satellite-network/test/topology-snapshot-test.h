@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <tuple>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/topology-satellite-network-snapshot.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class TopologySnapshotTestCase : public TestCase {
+public:
+    TopologySnapshotTestCase () : TestCase ("topology-snapshot") {};
+
+    const std::string temp_dir = ".tmp-topology-snapshot-test";
+
+    void WriteInputs() {
+        mkdir_if_not_exists(temp_dir);
+
+        // A configuration file
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=1000000000" << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=." << std::endl;
+        config_file << "satellite_network_snapshot_filename=topology.snapshot" << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file << "enable_isl_utilization_tracking=false" << std::endl;
+        config_file.close();
+
+        // TLES
+        std::ofstream tles_file;
+        tles_file.open (temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        tles_file << "Starlink-550 0" << std::endl;
+        tles_file << "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03" << std::endl;
+        tles_file << "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08" << std::endl;
+        tles_file << "Starlink-550 1" << std::endl;
+        tles_file << "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09" << std::endl;
+        tles_file << "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01" << std::endl;
+        tles_file << "Starlink-550 2" << std::endl;
+        tles_file << "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07" << std::endl;
+        tles_file << "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00" << std::endl;
+        tles_file.close();
+
+        // ISLs
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file << "1 2" << std::endl;
+        isls_file.close();
+
+        // Ground stations
+        std::ofstream ground_stations_file;
+        ground_stations_file.open (temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "1,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file.close();
+
+        // GSL interfaces info
+        std::ofstream gsl_interfaces_info_file;
+        gsl_interfaces_info_file.open (temp_dir + "/gsl_interfaces_info.txt");
+        gsl_interfaces_info_file << "0,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "1,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "3,2,1.0" << std::endl;
+        gsl_interfaces_info_file << "4,1,1.0" << std::endl;
+        gsl_interfaces_info_file.close();
+    }
+
+    // (node id, interface id) -> (IPv4 address, mask, device type)
+    std::map<std::pair<uint32_t, uint32_t>, std::tuple<uint32_t, uint32_t, std::string>> BuildAndDescribe() {
+        std::map<std::pair<uint32_t, uint32_t>, std::tuple<uint32_t, uint32_t, std::string>> description;
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        for (uint32_t i = 0; i < topology->GetNodes().GetN(); i++) {
+            Ptr<Ipv4> ipv4 = topology->GetNodes().Get(i)->GetObject<Ipv4>();
+            for (uint32_t j = 1; j < ipv4->GetNInterfaces(); j++) {
+                description[std::make_pair(i, j)] = std::make_tuple(
+                        ipv4->GetAddress(j, 0).GetLocal().Get(),
+                        ipv4->GetAddress(j, 0).GetMask().Get(),
+                        ipv4->GetNetDevice(j)->GetInstanceTypeId().GetName()
+                );
+            }
+        }
+        basicSimulation->Finalize();
+        return description;
+    }
+
+    void DoRun () {
+        WriteInputs();
+        remove_file_if_exists(temp_dir + "/topology.snapshot");
+
+        // First build writes the snapshot, second build uses it
+        std::map<std::pair<uint32_t, uint32_t>, std::tuple<uint32_t, uint32_t, std::string>> from_inputs = BuildAndDescribe();
+        ASSERT_TRUE(file_exists(temp_dir + "/topology.snapshot"));
+        std::map<std::pair<uint32_t, uint32_t>, std::tuple<uint32_t, uint32_t, std::string>> from_snapshot = BuildAndDescribe();
+
+        // 2 ISLs (4 interfaces) and 7 GSL interfaces
+        ASSERT_EQUAL(11, from_inputs.size());
+        ASSERT_TRUE(from_inputs == from_snapshot);
+
+        // Different network inputs make the snapshot stale, and it is rewritten
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+        std::map<std::pair<uint32_t, uint32_t>, std::tuple<uint32_t, uint32_t, std::string>> from_changed = BuildAndDescribe();
+        ASSERT_EQUAL(9, from_changed.size());
+        ASSERT_TRUE(from_changed == BuildAndDescribe());
+
+        // A corrupt length (here of the first satellite name) is refused instead of allocated
+        std::ofstream corrupt_file(temp_dir + "/corrupt.snapshot", std::ios::binary);
+        uint32_t version = 1;
+        uint64_t fingerprint = 0;
+        uint32_t num_satellites = 1;
+        uint32_t name_length = 0xFFFFFFFF;
+        corrupt_file.write("SATNETSS", 8);
+        corrupt_file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        corrupt_file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+        corrupt_file.write(reinterpret_cast<const char*>(&num_satellites), sizeof(num_satellites));
+        corrupt_file.write(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
+        corrupt_file.close();
+        TopologySatelliteNetworkSnapshot snapshot;
+        ASSERT_EXCEPTION(snapshot.Read(temp_dir + "/corrupt.snapshot"));
+
+        // Clean-up
+        remove_file_if_exists(temp_dir + "/corrupt.snapshot");
+        remove_file_if_exists(temp_dir + "/topology.snapshot");
+        remove_file_if_exists(temp_dir + "/config_ns3.properties");
+        remove_file_if_exists(temp_dir + "/tles.txt");
+        remove_file_if_exists(temp_dir + "/isls.txt");
+        remove_file_if_exists(temp_dir + "/ground_stations.txt");
+        remove_file_if_exists(temp_dir + "/gsl_interfaces_info.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+        remove_dir_if_exists(temp_dir);
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+
+#include "ns3/utilization-tracker.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class UtilizationTrackerTestCase : public TestCase {
+public:
+    UtilizationTrackerTestCase () : TestCase ("utilization-tracker") {};
+
+    void DoRun () {
+
+        // Intervals of 100 ns: busy 50 ns in [0, 100), 50 ns in [100, 200) spread over two
+        // transmissions, fully busy in [200, 400), idle in [400, 1000)
+        UtilizationTracker tracker(100, 0);
+        tracker.Track(20, true);
+        tracker.Track(70, false);
+        tracker.Track(110, true);
+        tracker.Track(130, false);
+        tracker.Track(170, true);
+        tracker.Track(400, false);
+
+        // Only the first segment can no longer change at this point
+        ASSERT_EQUAL(1, tracker.GetCompletedSegments().size());
+        ASSERT_EQUAL(0, tracker.GetCompletedSegments()[0].start_ns);
+        ASSERT_EQUAL(200, tracker.GetCompletedSegments()[0].end_ns);
+        ASSERT_EQUAL_APPROX(0.5, tracker.GetCompletedSegments()[0].utilization, 1e-9);
+
+        // Taking it out does not affect the rest
+        tracker.ClearCompletedSegments();
+        tracker.Finalize(1050);
+        const std::vector<UtilizationTracker::Segment>& segments = tracker.GetCompletedSegments();
+        ASSERT_EQUAL(2, segments.size());
+        ASSERT_EQUAL(200, segments[0].start_ns);
+        ASSERT_EQUAL(400, segments[0].end_ns);
+        ASSERT_EQUAL_APPROX(1.0, segments[0].utilization, 1e-9);
+        ASSERT_EQUAL(400, segments[1].start_ns);
+        ASSERT_EQUAL(1000, segments[1].end_ns);
+        ASSERT_EQUAL_APPROX(0.0, segments[1].utilization, 1e-9);
+
+        // Quantized to 4 levels: 0.3 and 0.2 both become 0.25
+        UtilizationTracker quantized(100, 4);
+        quantized.Track(0, true);
+        quantized.Track(30, false);
+        quantized.Track(100, true);
+        quantized.Track(120, false);
+        quantized.Track(200, true);
+        quantized.Finalize(300);
+        ASSERT_EQUAL(2, quantized.GetCompletedSegments().size());
+        ASSERT_EQUAL(0, quantized.GetCompletedSegments()[0].start_ns);
+        ASSERT_EQUAL(200, quantized.GetCompletedSegments()[0].end_ns);
+        ASSERT_EQUAL_APPROX(0.25, quantized.GetCompletedSegments()[0].utilization, 1e-9);
+        ASSERT_EQUAL(200, quantized.GetCompletedSegments()[1].start_ns);
+        ASSERT_EQUAL(300, quantized.GetCompletedSegments()[1].end_ns);
+        ASSERT_EQUAL_APPROX(1.0, quantized.GetCompletedSegments()[1].utilization, 1e-9);
+
+        // Fractional utilization: 0.5 of [0, 100), 0.5 * 40 + 0.25 * 60 ns of [100, 200)
+        UtilizationTracker fractional(100, 0);
+        fractional.TrackUtilization(0, 0.5);
+        fractional.TrackUtilization(140, 0.25);
+        fractional.Track(200, false);
+        fractional.Finalize(300);
+        ASSERT_EQUAL(3, fractional.GetCompletedSegments().size());
+        ASSERT_EQUAL_APPROX(0.5, fractional.GetCompletedSegments()[0].utilization, 1e-9);
+        ASSERT_EQUAL(100, fractional.GetCompletedSegments()[1].start_ns);
+        ASSERT_EQUAL_APPROX(0.35, fractional.GetCompletedSegments()[1].utilization, 1e-9);
+        ASSERT_EQUAL_APPROX(0.0, fractional.GetCompletedSegments()[2].utilization, 1e-9);
+
+    }
+};
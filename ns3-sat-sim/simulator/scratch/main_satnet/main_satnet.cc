@@ -28,10 +28,12 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <chrono>
+#include <memory>
 #include <stdexcept>
 
 #include "ns3/basic-simulation.h"
 #include "ns3/tcp-flow-scheduler.h"
+#include "ns3/fluid-flow-scheduler.h"
 #include "ns3/udp-burst-scheduler.h"
 #include "ns3/pingmesh-scheduler.h"
 #include "ns3/topology-satellite-network.h"
@@ -39,6 +41,8 @@
 #include "ns3/arbiter-single-forward-helper.h"
 #include "ns3/ipv4-arbiter-routing-helper.h"
 #include "ns3/gsl-if-bandwidth-helper.h"
+#include "ns3/gsl-handover-helper.h"
+#include "ns3/hot-path-profiler.h"
 
 using namespace ns3;
 
@@ -69,12 +73,24 @@ int main(int argc, char *argv[]) {
 
     // Read topology, and install routing arbiters
     Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
-    ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
-    GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes());
+
+    // Forwarding state and GSL bandwidth either from the precomputed state files, or decided during the run by GSL handovers
+    std::unique_ptr<ArbiterSingleForwardHelper> arbiterHelper;
+    std::unique_ptr<GslIfBandwidthHelper> gslIfBandwidthHelper;
+    std::unique_ptr<GslHandoverHelper> gslHandoverHelper;
+    if (GslHandoverHelper::IsEnabled(basicSimulation)) { // Requires gsl_handover_policy
+        gslHandoverHelper.reset(new GslHandoverHelper(basicSimulation, topology));
+    } else {
+        arbiterHelper.reset(new ArbiterSingleForwardHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable()));
+        gslIfBandwidthHelper.reset(new GslIfBandwidthHelper(basicSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable()));
+    }
 
     // Schedule flows
     TcpFlowScheduler tcpFlowScheduler(basicSimulation, topology); // Requires enable_tcp_flow_scheduler=true
 
+    // Schedule flow-level (fluid) flows
+    FluidFlowScheduler fluidFlowScheduler(basicSimulation, topology); // Requires enable_fluid_flow_scheduler=true
+
     // Schedule UDP bursts
     UdpBurstScheduler udpBurstScheduler(basicSimulation, topology); // Requires enable_udp_burst_scheduler=true
 
@@ -87,15 +103,26 @@ int main(int argc, char *argv[]) {
     // Write flow results
     tcpFlowScheduler.WriteResults();
 
+    // Write fluid flow results
+    fluidFlowScheduler.WriteResults();
+
     // Write UDP burst results
     udpBurstScheduler.WriteResults();
 
     // Write pingmesh results
     pingmeshScheduler.WriteResults();
 
+    // Write GSL handover results
+    if (gslHandoverHelper) {
+        gslHandoverHelper->WriteResults(basicSimulation->GetLogsDir());
+    }
+
     // Collect utilization statistics
     topology->CollectUtilizationStatistics();
 
+    // Write hot path profiling results (only if compiled with SATNET_PROFILING)
+    HotPathProfiler::WriteResults(basicSimulation->GetLogsDir());
+
     // Finalize the simulation
     basicSimulation->Finalize();
 
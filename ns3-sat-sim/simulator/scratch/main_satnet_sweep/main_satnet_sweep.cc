@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/tcp-flow-scheduler.h"
+#include "ns3/fluid-flow-scheduler.h"
+#include "ns3/udp-burst-scheduler.h"
+#include "ns3/pingmesh-scheduler.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/tcp-optimizer.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/arbiter-single-forward-helper.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/gsl-if-bandwidth-helper.h"
+#include "ns3/gsl-handover-helper.h"
+#include "ns3/hot-path-profiler.h"
+
+using namespace ns3;
+
+// Configuration parameters which were used to build the shared topology, routing and
+// GSL bandwidth state, and as such must be the same in every run directory of the sweep
+const std::vector<std::string> SHARED_CONFIG_PARAMS = {
+        "simulation_end_time_ns",
+        "satellite_network_dir",
+        "satellite_network_routes_dir",
+        "satellite_network_force_static",
+        "dynamic_state_update_interval_ns",
+        "isl_data_rate_megabit_per_s",
+        "gsl_data_rate_megabit_per_s",
+        "isl_max_queue_size_pkts",
+        "gsl_max_queue_size_pkts",
+        "gsl_voq_scheduler",
+        "link_framing",
+        "enable_isl_utilization_tracking",
+        "isl_utilization_tracking_interval_ns",
+        "isl_utilization_tracking_quantization_levels",
+        "isl_utilization_tracking_flush_interval_ns",
+        "enable_gsl_utilization_tracking",
+        "gsl_utilization_tracking_interval_ns",
+        "gsl_utilization_tracking_quantization_levels",
+        "enable_queue_occupancy_tracking",
+        "queue_occupancy_tracking_interval_ns",
+        "enable_packet_event_tracing",
+        "packet_event_tracing_buffer_size",
+        "utilization_statistics_num_threads",
+        "utilization_binary_output",
+        "satellite_network_delay_cache_tolerance_ns",
+        "satellite_network_zero_copy",
+        "satellite_ephemeris_step_ns",
+        "satellite_ephemeris_storage",
+        "satellite_ephemeris_num_threads",
+        "satellite_network_lightweight_satellite_stacks",
+        "gsl_handover_policy",
+        "gsl_handover_min_elevation_deg",
+        "gsl_handover_share_satellite_bandwidth"
+};
+
+/**
+ * Run a single run directory of the sweep. This is executed in the forked child process,
+ * which has its own copy-on-write copy of the topology and of the scheduled routing and
+ * GSL bandwidth updates (or GSL handovers), all of which still start at t=0.
+ */
+int run_child(Ptr<BasicSimulation> baseSimulation, Ptr<TopologySatelliteNetwork> topology, GslHandoverHelper* gslHandoverHelper, const std::string& run_dir) {
+
+    // Hot path profiling only covers this run, not the topology built before the fork
+    HotPathProfiler::Reset();
+
+    // Load the basic simulation environment of this run directory
+    Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(run_dir);
+
+    // The network part of the configuration must be the one the topology was built with
+    for (const std::string& param : SHARED_CONFIG_PARAMS) {
+        if (basicSimulation->GetConfigParamOrDefault(param, "") != baseSimulation->GetConfigParamOrDefault(param, "")) {
+            throw std::runtime_error(format_string(
+                    "Config parameter %s differs from the base run directory", param.c_str()
+            ));
+        }
+    }
+
+    // Setting socket type: the TCP protocols were already created with the topology before the
+    // fork, so it is set on each of them rather than as a default
+    TypeIdValue socketType(TypeId::LookupByName("ns3::" + basicSimulation->GetConfigParamOrFail("tcp_socket_type")));
+    for (uint32_t i = 0; i < topology->GetNodes().GetN(); i++) {
+        Ptr<TcpL4Protocol> tcp = topology->GetNodes().Get(i)->GetObject<TcpL4Protocol>();
+        if (tcp != nullptr) { // Not installed on forwarding-only satellites
+            tcp->SetAttribute("SocketType", socketType);
+        }
+    }
+
+    // Optimize TCP
+    TcpOptimizer::OptimizeBasic(basicSimulation);
+
+    // Utilization statistics are written into this run directory
+    topology->SetBasicSimulation(basicSimulation);
+
+    // Schedule flows
+    TcpFlowScheduler tcpFlowScheduler(basicSimulation, topology); // Requires enable_tcp_flow_scheduler=true
+
+    // Schedule flow-level (fluid) flows
+    FluidFlowScheduler fluidFlowScheduler(basicSimulation, topology); // Requires enable_fluid_flow_scheduler=true
+
+    // Schedule UDP bursts
+    UdpBurstScheduler udpBurstScheduler(basicSimulation, topology); // Requires enable_udp_burst_scheduler=true
+
+    // Schedule pings
+    PingmeshScheduler pingmeshScheduler(basicSimulation, topology); // Requires enable_pingmesh_scheduler=true
+
+    // Run simulation
+    basicSimulation->Run();
+
+    // Write flow results
+    tcpFlowScheduler.WriteResults();
+
+    // Write fluid flow results
+    fluidFlowScheduler.WriteResults();
+
+    // Write UDP burst results
+    udpBurstScheduler.WriteResults();
+
+    // Write pingmesh results
+    pingmeshScheduler.WriteResults();
+
+    // Write GSL handover results
+    if (gslHandoverHelper != nullptr) {
+        gslHandoverHelper->WriteResults(basicSimulation->GetLogsDir());
+    }
+
+    // Collect utilization statistics
+    topology->CollectUtilizationStatistics();
+
+    // Write hot path profiling results (only if compiled with SATNET_PROFILING)
+    HotPathProfiler::WriteResults(basicSimulation->GetLogsDir());
+
+    // Finalize the simulation
+    basicSimulation->Finalize();
+
+    return 0;
+
+}
+
+int main(int argc, char *argv[]) {
+
+    // No buffering of printf
+    setbuf(stdout, nullptr);
+
+    // Retrieve run directories
+    CommandLine cmd;
+    std::string base_run_dir = "";
+    std::string run_dirs_str = "";
+    int64_t max_parallel = sysconf(_SC_NPROCESSORS_ONLN);
+    std::string usage = "Usage: ./waf --run=\"main_satnet_sweep --base_run_dir='<path/to/base/run/directory>' --run_dirs='<run/dir/a>,<run/dir/b>,...' [--max_parallel=<number of cores>]\"";
+    cmd.Usage(usage);
+    cmd.AddValue("base_run_dir",  "Run directory of which the config is used to build the shared topology", base_run_dir);
+    cmd.AddValue("run_dirs",  "Comma-separated run directories, each run with its own traffic", run_dirs_str);
+    cmd.AddValue("max_parallel",  "Maximum number of run directories running at the same time", max_parallel);
+    cmd.Parse(argc, argv);
+    if (base_run_dir.compare("") == 0 || run_dirs_str.compare("") == 0 || max_parallel <= 0) {
+        printf("%s\n", usage.c_str());
+        return 0;
+    }
+    std::vector<std::string> run_dirs = split_string(run_dirs_str, ",");
+
+    // Load basic simulation environment of the base
+    Ptr<BasicSimulation> baseSimulation = CreateObject<BasicSimulation>(base_run_dir);
+
+    // Read topology, and install routing arbiters
+    Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(baseSimulation, Ipv4ArbiterRoutingHelper());
+
+    // Forwarding state and GSL bandwidth either from the precomputed state files, or decided during the run by GSL handovers
+    std::unique_ptr<ArbiterSingleForwardHelper> arbiterHelper;
+    std::unique_ptr<GslIfBandwidthHelper> gslIfBandwidthHelper;
+    std::unique_ptr<GslHandoverHelper> gslHandoverHelper;
+    if (GslHandoverHelper::IsEnabled(baseSimulation)) { // Requires gsl_handover_policy
+        gslHandoverHelper.reset(new GslHandoverHelper(baseSimulation, topology));
+    } else {
+        arbiterHelper.reset(new ArbiterSingleForwardHelper(baseSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable()));
+        gslIfBandwidthHelper.reset(new GslIfBandwidthHelper(baseSimulation, topology->GetNodes(), topology->GetNodeInterfaceTable()));
+    }
+
+    // Run each run directory in its own forked process
+    std::cout << "SWEEP" << std::endl;
+    std::cout << "  > Number of run directories... " << run_dirs.size() << std::endl;
+    std::cout << "  > Maximum in parallel......... " << max_parallel << std::endl;
+    std::map<pid_t, std::string> running;
+    std::vector<std::string> failed;
+    size_t next_run_dir_idx = 0;
+    while (next_run_dir_idx < run_dirs.size() || !running.empty()) {
+
+        // Start as many as allowed
+        if (next_run_dir_idx < run_dirs.size() && (int64_t) running.size() < max_parallel) {
+            const std::string run_dir = run_dirs.at(next_run_dir_idx);
+            next_run_dir_idx++;
+            std::cout.flush();
+            pid_t pid = fork();
+            if (pid < 0) {
+                throw std::runtime_error("Unable to fork for run directory: " + run_dir);
+
+            } else if (pid == 0) {
+
+                // Console output of the child goes into its own run directory
+                mkdir_if_not_exists(run_dir + "/logs_ns3");
+                FILE* console = freopen((run_dir + "/logs_ns3/console.txt").c_str(), "w", stdout);
+                if (console == nullptr) {
+                    _exit(1);
+                }
+                dup2(fileno(stdout), fileno(stderr));
+
+                // Run it, and exit without running the destructors of the parent's state
+                int exit_code = 1;
+                try {
+                    exit_code = run_child(baseSimulation, topology, gslHandoverHelper.get(), run_dir);
+                } catch (std::exception& e) {
+                    std::cout << "Run failed: " << e.what() << std::endl;
+                }
+                std::cout.flush();
+                fflush(stdout);
+                _exit(exit_code);
+
+            }
+            running[pid] = run_dir;
+            std::cout << "  > Started " << run_dir << " (pid " << pid << ")" << std::endl;
+            continue;
+        }
+
+        // Wait for any to finish
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            throw std::runtime_error("Waiting for the forked runs failed");
+        }
+        std::map<pid_t, std::string>::iterator it = running.find(pid);
+        if (it == running.end()) {
+            continue;
+        }
+        bool success = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        std::cout << "  > " << (success ? "Finished " : "FAILED ") << it->second << std::endl;
+        if (!success) {
+            failed.push_back(it->second);
+        }
+        running.erase(it);
+
+    }
+    std::cout << "  > Completed " << (run_dirs.size() - failed.size()) << "/" << run_dirs.size() << " run directories" << std::endl;
+    std::cout << std::endl;
+
+    // Finalize the base
+    baseSimulation->Finalize();
+
+    return failed.empty() ? 0 : 1;
+
+}
@@ -0,0 +1,122 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "hot-path-profiler.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+// Relaxed atomics, as positions may also be retrieved outside of the simulation thread
+static std::atomic<uint64_t> g_hotPathCalls[HotPathProfiler::NUM_COMPONENTS];
+static std::atomic<uint64_t> g_hotPathTotalNs[HotPathProfiler::NUM_COMPONENTS];
+
+bool
+HotPathProfiler::IsEnabled (void)
+{
+#ifdef SATNET_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+HotPathProfiler::Add (Component component, int64_t duration_ns)
+{
+  g_hotPathCalls[component].fetch_add (1, std::memory_order_relaxed);
+  g_hotPathTotalNs[component].fetch_add (duration_ns, std::memory_order_relaxed);
+}
+
+uint64_t
+HotPathProfiler::GetCalls (Component component)
+{
+  return g_hotPathCalls[component].load (std::memory_order_relaxed);
+}
+
+uint64_t
+HotPathProfiler::GetTotalNs (Component component)
+{
+  return g_hotPathTotalNs[component].load (std::memory_order_relaxed);
+}
+
+std::string
+HotPathProfiler::GetName (Component component)
+{
+  switch (component)
+    {
+    case SATELLITE_POSITION: return "SatellitePositionHelper::GetPosition";
+    case ARBITER_DECIDE: return "ArbiterSatnet::Decide";
+    case GSL_CHANNEL_TRANSMIT: return "GSLChannel::TransmitTo";
+    case GSL_CHANNEL_DELAY: return "GSLChannel::GetDelay";
+    case ISL_CHANNEL_TRANSMIT: return "PointToPointLaserChannel::TransmitStart";
+    case ISL_CHANNEL_DELAY: return "PointToPointLaserChannel::GetDelay";
+    case FORWARDING_STATE_UPDATE: return "ArbiterSingleForwardHelper::UpdateForwardingState";
+    case GSL_BANDWIDTH_UPDATE: return "GslIfBandwidthHelper::UpdateGslIfBandwidth";
+    default: NS_ABORT_MSG ("Unknown hot path component: " << component);
+    }
+  return "";
+}
+
+void
+HotPathProfiler::Reset (void)
+{
+  for (int i = 0; i < NUM_COMPONENTS; i++)
+    {
+      g_hotPathCalls[i].store (0);
+      g_hotPathTotalNs[i].store (0);
+    }
+}
+
+void
+HotPathProfiler::WriteResults (const std::string &logs_dir)
+{
+  if (!IsEnabled ())
+    {
+      return;
+    }
+
+  FILE *file_txt = fopen ((logs_dir + "/profiling_results.txt").c_str (), "w+");
+  NS_ABORT_MSG_IF (file_txt == nullptr, "Could not open " << logs_dir << "/profiling_results.txt");
+  FILE *file_csv = fopen ((logs_dir + "/profiling_results.csv").c_str (), "w+");
+  NS_ABORT_MSG_IF (file_csv == nullptr, "Could not open " << logs_dir << "/profiling_results.csv");
+
+  fprintf (file_txt, "%-52s%-16s%-20s%s\n", "Component", "Calls", "Total (ms)", "Per call (ns)");
+  for (int i = 0; i < NUM_COMPONENTS; i++)
+    {
+      Component component = (Component) i;
+      uint64_t calls = GetCalls (component);
+      uint64_t total_ns = GetTotalNs (component);
+      double per_call_ns = calls == 0 ? 0.0 : (double) total_ns / (double) calls;
+      fprintf (file_txt, "%-52s%-16" PRIu64 "%-20.2f%.1f\n",
+               GetName (component).c_str (), calls, total_ns / 1e6, per_call_ns);
+      fprintf (file_csv, "%s,%" PRIu64 ",%" PRIu64 ",%.1f\n",
+               GetName (component).c_str (), calls, total_ns, per_call_ns);
+    }
+
+  fclose (file_txt);
+  fclose (file_csv);
+}
+
+} // namespace ns3
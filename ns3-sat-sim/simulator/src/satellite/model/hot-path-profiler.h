@@ -0,0 +1,111 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef HOT_PATH_PROFILER_H
+#define HOT_PATH_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * @brief Call counters and wall-clock timers of the simulation hot paths.
+ *
+ * The timers are only compiled in if SATNET_PROFILING is defined, e.g.:
+ *
+ *   CXXFLAGS="-DSATNET_PROFILING" ./waf configure --build-profile=optimized
+ *
+ * Otherwise SATNET_PROFILE_SCOPE expands to nothing and the hot paths are untouched.
+ * Timers are inclusive: a component which calls another one (e.g., a channel delay
+ * computation which retrieves satellite positions) also accounts for its time.
+ */
+class HotPathProfiler
+{
+public:
+  enum Component
+  {
+    SATELLITE_POSITION = 0,
+    ARBITER_DECIDE,
+    GSL_CHANNEL_TRANSMIT,
+    GSL_CHANNEL_DELAY,
+    ISL_CHANNEL_TRANSMIT,
+    ISL_CHANNEL_DELAY,
+    FORWARDING_STATE_UPDATE,
+    GSL_BANDWIDTH_UPDATE,
+    NUM_COMPONENTS
+  };
+
+  /**
+   * @brief Times the enclosing scope and accounts it to a component.
+   */
+  class Scope
+  {
+  public:
+    Scope (Component component)
+      : m_component (component),
+        m_start (std::chrono::steady_clock::now ())
+    {
+    }
+    ~Scope ()
+    {
+      HotPathProfiler::Add (m_component, std::chrono::duration_cast<std::chrono::nanoseconds> (
+                              std::chrono::steady_clock::now () - m_start).count ());
+    }
+  private:
+    Component m_component;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  /**
+   * @brief Whether the library was compiled with SATNET_PROFILING.
+   */
+  static bool IsEnabled (void);
+
+  static void Add (Component component, int64_t duration_ns);
+  static uint64_t GetCalls (Component component);
+  static uint64_t GetTotalNs (Component component);
+  static std::string GetName (Component component);
+  static void Reset (void);
+
+  /**
+   * @brief Write the summary to <logs_dir>/profiling_results.txt and .csv, next to
+   *        timing_results.txt and .csv. Nothing is written if profiling is not enabled.
+   *
+   * CSV line format: <component>,<calls>,<total (ns)>,<ns per call>
+   *
+   * @param logs_dir logs directory of the run
+   */
+  static void WriteResults (const std::string &logs_dir);
+};
+
+} // namespace ns3
+
+#ifdef SATNET_PROFILING
+#define SATNET_PROFILE_SCOPE(component) \
+  ns3::HotPathProfiler::Scope satnet_profile_scope_ (ns3::HotPathProfiler::component)
+#else
+#define SATNET_PROFILE_SCOPE(component)
+#endif
+
+#endif /* HOT_PATH_PROFILER_H */
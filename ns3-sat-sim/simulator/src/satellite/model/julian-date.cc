@@ -22,6 +22,7 @@
 #include "julian-date.h"
 
 #include <cmath>
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <sstream>
@@ -45,6 +46,7 @@ const uint32_t JulianDate::J2000Epoch = 2451545;      //!< 1 Jan 2000, 12h
 const uint32_t JulianDate::Posix1992 = 8035;          //!< 1 Jan 1992 (Unix days)
 const uint32_t JulianDate::HourToMs = 3600000;        //!< millisecs in an hour
 const uint32_t JulianDate::DayToMs = HourToMs*24;     //!< millisecs in a day
+const uint64_t JulianDate::DayToNs = DayToMs*1000000ULL; //!< nanosecs in a day
 const Time JulianDate::TtToTai = MilliSeconds(32184); //!< TT - TAI (in ms)
 const Time JulianDate::TaiToGps = MilliSeconds(19000);//!< TAI - GPST (in ms)
 
@@ -70,6 +72,7 @@ JulianDate::JulianDate ()
   // the date since complete IERS data is available
   m_days = static_cast<uint32_t> ((MinYear - PosixYear)*365.25);
   m_ms_day = 0;
+  m_ns_ms = 0;
   m_time_scale = DateTime::UTC;
 }
 
@@ -91,7 +94,7 @@ JulianDate::JulianDate (const std::string &date, TimeSystem ts)
 double
 JulianDate::GetDouble (TimeSystem ts) const
 {
-  double base = m_days + m_ms_day/static_cast<double> (DayToMs);
+  double base = m_days + GetNsDay ()/static_cast<double> (DayToNs);
 
   if (ts != DateTime::POSIX)
     return base += PosixEpoch;
@@ -201,7 +204,7 @@ JulianDate::SetDate (double jd)
   jd -= PosixEpoch;
 
   m_days = static_cast<uint32_t> (jd);
-  m_ms_day = static_cast<uint32_t> ((jd - m_days)*DayToMs);
+  SetNsDay (std::min (static_cast<uint64_t> ((jd - m_days)*DayToNs), DayToNs - 1));
   m_time_scale = DateTime::UTC;
 }
 
@@ -211,6 +214,7 @@ JulianDate::SetDate (uint32_t days, uint32_t ms_day)
   // POSIX/Unix epoch is used internally
   m_days = days;
   m_ms_day = ms_day;
+  m_ns_ms = 0;
   m_time_scale = DateTime::POSIX;
 }
 
@@ -245,6 +249,7 @@ JulianDate::SetDate (const std::string &date, TimeSystem ts)
   m_days = 367*dt.year - 7*(dt.year + (dt.month+9)/12)/4 + 275*dt.month/9 +
            dt.day - static_cast<uint32_t>(PosixEpoch - 1721013.5);
   m_ms_day = (dt.hours*3600 + dt.minutes*60 + dt.seconds)*1000 + dt.millisecs;
+  m_ns_ms = 0;
   m_time_scale = ts;
 
   *this += OffsetToUtc ();
@@ -257,14 +262,13 @@ JulianDate::operator+ (const Time &t) const
 
   // if time is negative, call operator- with a positive time
   if (t.IsStrictlyNegative ())
-    return *this - MilliSeconds (-t.GetMilliSeconds ());
+    return *this - NanoSeconds (-t.GetNanoSeconds ());
 
-  jd.m_days = static_cast<uint32_t> (t.GetDays ());
-  jd.m_ms_day = static_cast<uint32_t> (t.GetMilliSeconds () % DayToMs);
+  uint64_t ns = static_cast<uint64_t> (t.GetNanoSeconds ());
+  uint64_t ns_day = GetNsDay () + ns % DayToNs;
 
-  jd.m_ms_day += m_ms_day;
-  jd.m_days += m_days + jd.m_ms_day/DayToMs;
-  jd.m_ms_day %= DayToMs;
+  jd.m_days = m_days + static_cast<uint32_t> (ns/DayToNs + ns_day/DayToNs);
+  jd.SetNsDay (ns_day % DayToNs);
   jd.m_time_scale = m_time_scale;
 
   return jd;
@@ -283,20 +287,23 @@ JulianDate::operator- (const Time &t) const
 
   // if time is negative, call operator+ with a positive time
   if (t.IsStrictlyNegative ())
-    return *this + MilliSeconds (-t.GetMilliSeconds ());
+    return *this + NanoSeconds (-t.GetNanoSeconds ());
 
-  jd.m_days = static_cast<uint32_t> (t.GetDays ());
-  jd.m_ms_day = static_cast<uint32_t> (t.GetMilliSeconds () % DayToMs);
+  uint64_t ns = static_cast<uint64_t> (t.GetNanoSeconds ());
+  uint64_t days = ns/DayToNs;
+  uint64_t ns_sub = ns % DayToNs;
+  uint64_t ns_day = GetNsDay ();
 
-  if (jd.m_ms_day > m_ms_day)
+  if (ns_sub > ns_day)
   {
-    jd.m_ms_day = DayToMs - (jd.m_ms_day - m_ms_day);
-    jd.m_days += 1;
+    ns_day = DayToNs - (ns_sub - ns_day);
+    days += 1;
   }
   else
-    jd.m_ms_day = m_ms_day - jd.m_ms_day;
+    ns_day = ns_day - ns_sub;
 
-  jd.m_days = m_days - jd.m_days;
+  jd.m_days = m_days - static_cast<uint32_t> (days);
+  jd.SetNsDay (ns_day);
   jd.m_time_scale = m_time_scale;
 
   return jd;
@@ -311,10 +318,10 @@ JulianDate::operator-= (const Time &t)
 Time
 JulianDate::operator- (const JulianDate &jd) const
 {
-  Time t1 = ns3::Days(m_days) + ns3::MilliSeconds(m_ms_day);
-  Time t2 = ns3::Days(jd.m_days) + ns3::MilliSeconds(jd.m_ms_day);
+  int64_t days = static_cast<int64_t> (m_days) - static_cast<int64_t> (jd.m_days);
+  int64_t ns_day = static_cast<int64_t> (GetNsDay ()) - static_cast<int64_t> (jd.GetNsDay ());
 
-  return t1 - t2;
+  return NanoSeconds (days*static_cast<int64_t> (DayToNs) + ns_day);
 }
 
 bool
@@ -322,7 +329,7 @@ JulianDate::operator< (const JulianDate &jd) const {
   if(m_days != jd.m_days)
     return m_days < jd.m_days;
 
-  return m_ms_day < jd.m_ms_day;
+  return GetNsDay () < jd.GetNsDay ();
 }
 
 bool
@@ -330,7 +337,7 @@ JulianDate::operator<= (const JulianDate &jd) const {
   if(m_days != jd.m_days)
     return m_days < jd.m_days;
 
-  return m_ms_day <= jd.m_ms_day;
+  return GetNsDay () <= jd.GetNsDay ();
 }
 
 bool
@@ -338,7 +345,7 @@ JulianDate::operator> (const JulianDate &jd) const {
   if(m_days != jd.m_days)
     return m_days > jd.m_days;
 
-  return m_ms_day > jd.m_ms_day;
+  return GetNsDay () > jd.GetNsDay ();
 }
 
 bool
@@ -346,7 +353,7 @@ JulianDate::operator>= (const JulianDate &jd) const {
   if(m_days != jd.m_days)
     return m_days > jd.m_days;
 
-  return m_ms_day >= jd.m_ms_day;
+  return GetNsDay () >= jd.GetNsDay ();
 }
 
 bool
@@ -354,7 +361,7 @@ JulianDate::operator== (const JulianDate &jd) const {
   if(m_days != jd.m_days)
     return false;
 
-  return m_ms_day == jd.m_ms_day;
+  return GetNsDay () == jd.GetNsDay ();
 }
 
 bool
@@ -362,7 +369,7 @@ JulianDate::operator!= (const JulianDate &jd) const {
   if(m_days != jd.m_days)
     return true;
 
-  return m_ms_day != jd.m_ms_day;
+  return GetNsDay () != jd.GetNsDay ();
 }
 
 std::ostream&
@@ -455,6 +462,19 @@ JulianDate::GregorianDate (uint32_t days, uint32_t ms_day)
   return dt;
 }
 
+uint64_t
+JulianDate::GetNsDay (void) const
+{
+  return m_ms_day*1000000ULL + m_ns_ms;
+}
+
+void
+JulianDate::SetNsDay (uint64_t ns_day)
+{
+  m_ms_day = static_cast<uint32_t> (ns_day/1000000);
+  m_ns_ms = static_cast<uint32_t> (ns_day % 1000000);
+}
+
 Time
 JulianDate::OffsetFromUtc () const
 {
@@ -81,6 +81,7 @@ public:
   static const uint32_t Posix1992;                //!< 1 Jan 1992 (POSIX days)
   static const uint32_t HourToMs;                 //!< milliseconds in an hour
   static const uint32_t DayToMs;                  //!< milliseconds in a day
+  static const uint64_t DayToNs;                  //!< nanoseconds in a day
   static const Time TtToTai;                      //!< offset from TT to TAI
   static const Time TaiToGps;                     //!< offset from TAI to GPST
 
@@ -93,7 +94,7 @@ public:
    * @brief JulianDate constructor receiving the Julian days as parameter.
    *
    * This constructor has lower precision as there may be some inaccuracy at the
-   * millisecond level due to double type limited precision.
+   * sub-millisecond level due to double type limited precision.
    *
    * @param jd The Julian days.
    */
@@ -366,8 +367,21 @@ private:
    */
   Time OffsetToUtc (void) const;
 
+  /**
+   * @brief Time of the day, including the sub-millisecond part.
+   * @return the nanoseconds of the day (since midnight).
+   */
+  uint64_t GetNsDay (void) const;
+
+  /**
+   * @brief Set the time of the day, including the sub-millisecond part.
+   * @param ns_day Nanoseconds of the day (since midnight), less than a day.
+   */
+  void SetNsDay (uint64_t ns_day);
+
   uint32_t m_days;                                //!< full days since epoch.
   uint32_t m_ms_day;                              //!< milliseconds of the day.
+  uint32_t m_ns_ms;                               //!< nanoseconds of the millisecond.
   TimeSystem m_time_scale;                        //!< external time system.
 };
 
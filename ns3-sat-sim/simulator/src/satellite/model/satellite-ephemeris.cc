@@ -0,0 +1,180 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#include "satellite-ephemeris.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+const uint32_t SatelliteEphemeris::SamplesPerSegment = 64;
+
+SatelliteEphemeris::SatelliteEphemeris (Ptr<Satellite> sat, const JulianDate &start,
+                                        Time step, Time duration, Storage storage)
+  : m_start (start),
+    m_step_ns (step.GetNanoSeconds ()),
+    m_storage (storage),
+    m_max_storage_error (0)
+{
+  NS_ABORT_MSG_IF (!sat || !sat->IsInitialized (), "Satellite has no TLE information");
+  NS_ABORT_MSG_IF (m_step_ns <= 0, "Ephemeris step must be strictly positive");
+  NS_ABORT_MSG_IF (duration.IsStrictlyNegative (), "Ephemeris duration cannot be negative");
+
+  // One sample beyond the duration, such that it is always interpolated
+  m_num_samples = static_cast<uint32_t> (duration.GetNanoSeconds ()/m_step_ns + 2);
+
+  uint32_t num_segments = (m_num_samples + SamplesPerSegment - 1)/SamplesPerSegment;
+  if (m_storage == STORAGE_FLOAT64)
+    m_float64.reserve (3*m_num_samples);
+  else
+    m_anchors.reserve (num_segments);
+  if (m_storage == STORAGE_FLOAT32)
+    m_float32.reserve (3*m_num_samples);
+  if (m_storage == STORAGE_INT32_MM)
+    m_int32_mm.reserve (3*m_num_samples);
+
+  // minutes since the TLE epoch of the first sample
+  double tsince_start = (m_start - sat->GetTleEpoch ()).GetNanoSeconds ()/6e10;
+
+  // Propagated on a copy of the record, such that ephemerides of the same
+  // satellite can be sampled concurrently (copied once, not for each sample)
+  elsetrec record = sat->GetSgp4Record ();
+
+  for (uint32_t i = 0; i < m_num_samples; i++)
+    {
+      Vector3D exact = sat->GetPositionAtTsince (tsince_start + i*m_step_ns/6e10, record);
+      double r[3] = {exact.x, exact.y, exact.z};
+
+      if (m_storage == STORAGE_FLOAT64)
+        {
+          m_float64.insert (m_float64.end (), r, r + 3);
+          continue;
+        }
+
+      if (i % SamplesPerSegment == 0)
+        m_anchors.push_back (exact);
+      const Vector3D &anchor = m_anchors.back ();
+      double a[3] = {anchor.x, anchor.y, anchor.z};
+
+      for (int c = 0; c < 3; c++)
+        {
+          if (m_storage == STORAGE_FLOAT32)
+            {
+              m_float32.push_back (static_cast<float> (r[c] - a[c]));
+            }
+          else
+            {
+              double mm = std::round ((r[c] - a[c])*1000);
+              NS_ABORT_MSG_IF (std::abs (mm) > std::numeric_limits<int32_t>::max (),
+                               "Satellite moves more than 2147 km within an ephemeris segment, "
+                               "the step is too large for millimeter offsets");
+              m_int32_mm.push_back (static_cast<int32_t> (mm));
+            }
+        }
+
+      m_max_storage_error = std::max (m_max_storage_error, CalculateDistance (GetSample (i), exact));
+    }
+}
+
+bool
+SatelliteEphemeris::Covers (Time t) const
+{
+  int64_t ns = t.GetNanoSeconds ();
+  return ns >= 0 && ns <= (m_num_samples - 1)*m_step_ns;
+}
+
+Vector3D
+SatelliteEphemeris::GetPosition (Time t) const
+{
+  int64_t ns = std::min (std::max (t.GetNanoSeconds (), (int64_t) 0), (m_num_samples - 1)*m_step_ns);
+  uint32_t i = std::min (static_cast<uint32_t> (ns/m_step_ns), m_num_samples - 2);
+  double frac = (ns - i*m_step_ns)/static_cast<double> (m_step_ns);
+
+  Vector3D p0 = GetSample (i);
+  Vector3D p1 = GetSample (i + 1);
+  return Vector3D (p0.x + (p1.x - p0.x)*frac,
+                   p0.y + (p1.y - p0.y)*frac,
+                   p0.z + (p1.z - p0.z)*frac);
+}
+
+Vector3D
+SatelliteEphemeris::GetSample (uint32_t i) const
+{
+  switch (m_storage)
+    {
+    case STORAGE_FLOAT64:
+      return Vector3D (m_float64[3*i], m_float64[3*i + 1], m_float64[3*i + 2]);
+    case STORAGE_FLOAT32:
+      {
+        const Vector3D &a = m_anchors[i/SamplesPerSegment];
+        return Vector3D (a.x + m_float32[3*i], a.y + m_float32[3*i + 1], a.z + m_float32[3*i + 2]);
+      }
+    default:
+      {
+        const Vector3D &a = m_anchors[i/SamplesPerSegment];
+        return Vector3D (a.x + m_int32_mm[3*i]/1000.0,
+                         a.y + m_int32_mm[3*i + 1]/1000.0,
+                         a.z + m_int32_mm[3*i + 2]/1000.0);
+      }
+    }
+}
+
+JulianDate
+SatelliteEphemeris::GetStartTime (void) const
+{
+  return m_start;
+}
+
+Time
+SatelliteEphemeris::GetStep (void) const
+{
+  return NanoSeconds (m_step_ns);
+}
+
+SatelliteEphemeris::Storage
+SatelliteEphemeris::GetStorage (void) const
+{
+  return m_storage;
+}
+
+uint32_t
+SatelliteEphemeris::GetNumSamples (void) const
+{
+  return m_num_samples;
+}
+
+uint64_t
+SatelliteEphemeris::GetMemoryBytes (void) const
+{
+  return m_anchors.size ()*sizeof (Vector3D) + m_float64.size ()*sizeof (double)
+         + m_float32.size ()*sizeof (float) + m_int32_mm.size ()*sizeof (int32_t);
+}
+
+double
+SatelliteEphemeris::GetMaxStorageError (void) const
+{
+  return m_max_storage_error;
+}
+
+} // namespace ns3
@@ -0,0 +1,142 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Simon               2020
+ */
+
+#ifndef SATELLITE_EPHEMERIS_H
+#define SATELLITE_EPHEMERIS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include "julian-date.h"
+#include "satellite.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * @brief Precomputed trajectory of a satellite, sampled at a fixed step.
+ *
+ * The SGP4/SDP4 positions (ITRF) are sampled once from the start time onwards,
+ * after which positions are linearly interpolated between the two surrounding
+ * samples. Samples are grouped in segments of SamplesPerSegment, and in the
+ * compact storage modes each sample is stored relative to the first sample of
+ * its segment (the anchor, kept in double precision):
+ *
+ *  - STORAGE_FLOAT64: absolute positions as doubles (24 bytes per sample).
+ *  - STORAGE_FLOAT32: offsets to the anchor as floats (12 bytes per sample).
+ *    The error per component is at most 2^-24 times the largest offset in the
+ *    segment, which is at most SamplesPerSegment * step * v for a speed v.
+ *    For LEO (v < 8 km/s) at a 10 ms step this is below 0.3 mm, at 100 ms
+ *    below 3 mm and at 1 s below 3 cm.
+ *  - STORAGE_INT32_MM: offsets to the anchor as millimeters (12 bytes per
+ *    sample). The error per component is at most 0.5 mm for any step, but all
+ *    offsets of a segment must be within +/- 2147 km.
+ *
+ * The linear interpolation adds an error of at most a * step^2 / 8 for an
+ * acceleration a. The samples are in the rotating ITRF frame, where the
+ * Coriolis and centrifugal terms add to the gravitational acceleration, so
+ * for LEO a < 11.5 m/s^2 and the error is below 0.15 mm at a 10 ms step,
+ * below 15 mm at 100 ms and below 1.5 m at 1 s.
+ *
+ * The storage error actually incurred is measured when sampling and available
+ * through GetMaxStorageError ().
+ */
+class SatelliteEphemeris : public SimpleRefCount<SatelliteEphemeris>
+{
+public:
+  enum Storage
+  {
+    STORAGE_FLOAT64,
+    STORAGE_FLOAT32,
+    STORAGE_INT32_MM
+  };
+
+  static const uint32_t SamplesPerSegment;        //!< samples per anchor
+
+  /**
+   * @brief Sample the trajectory of a satellite.
+   * @param sat Satellite with its TLE information set.
+   * @param start Absolute time of the first sample.
+   * @param step Time between two samples (strictly positive).
+   * @param duration Time after the start which must at least be covered.
+   * @param storage How the samples are stored.
+   */
+  SatelliteEphemeris (Ptr<Satellite> sat, const JulianDate &start, Time step,
+                      Time duration, Storage storage);
+
+  /**
+   * @brief Whether a time is covered by the samples.
+   * @param t Time since the start.
+   * @return true iff 0 <= t <= the time of the last sample.
+   */
+  bool Covers (Time t) const;
+
+  /**
+   * @brief Get the interpolated position.
+   * @param t Time since the start (clamped to the covered interval).
+   * @return the satellite's position, in meters, on ITRF coordinate frame.
+   */
+  Vector3D GetPosition (Time t) const;
+
+  JulianDate GetStartTime (void) const;
+  Time GetStep (void) const;
+  Storage GetStorage (void) const;
+  uint32_t GetNumSamples (void) const;
+
+  /**
+   * @brief Memory used by the samples and anchors.
+   * @return the size in bytes.
+   */
+  uint64_t GetMemoryBytes (void) const;
+
+  /**
+   * @brief Largest distance between a stored and an exact sample.
+   * @return the distance in meters (0 for STORAGE_FLOAT64).
+   */
+  double GetMaxStorageError (void) const;
+
+private:
+  /**
+   * @brief Decode a stored sample.
+   * @param i Sample index.
+   * @return the sample position, in meters.
+   */
+  Vector3D GetSample (uint32_t i) const;
+
+  JulianDate m_start;                     //!< absolute time of the first sample.
+  int64_t m_step_ns;                      //!< time between two samples.
+  Storage m_storage;                      //!< storage mode.
+  uint32_t m_num_samples;                 //!< number of samples.
+  std::vector<Vector3D> m_anchors;        //!< first sample of each segment.
+  std::vector<double> m_float64;          //!< x,y,z of each sample (STORAGE_FLOAT64).
+  std::vector<float> m_float32;           //!< x,y,z offsets (STORAGE_FLOAT32).
+  std::vector<int32_t> m_int32_mm;        //!< x,y,z offsets (STORAGE_INT32_MM).
+  double m_max_storage_error;             //!< measured storage error (m).
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_EPHEMERIS_H */
@@ -24,17 +24,21 @@
 
 #include "ns3/simulator.h"
 #include "ns3/nstime.h"
+#include "ns3/abort.h"
+#include "hot-path-profiler.h"
 
 namespace ns3 {
 
 ATTRIBUTE_HELPER_CPP (SatellitePositionHelper);
 
 SatellitePositionHelper::SatellitePositionHelper (void)
+  : m_tsinceStart (0)
 {
   SetStartTime (JulianDate ());
 }
 
 SatellitePositionHelper::SatellitePositionHelper (Ptr<Satellite> sat)
+  : m_tsinceStart (0)
 {
   SetSatellite (sat);
   SetStartTime (sat->GetTleEpoch ());
@@ -43,6 +47,7 @@ SatellitePositionHelper::SatellitePositionHelper (Ptr<Satellite> sat)
 SatellitePositionHelper::SatellitePositionHelper(
   Ptr<Satellite> sat, const JulianDate &t
 )
+  : m_tsinceStart (0)
 {
   SetSatellite (sat);
   SetStartTime (t);
@@ -51,12 +56,19 @@ SatellitePositionHelper::SatellitePositionHelper(
 Vector3D
 SatellitePositionHelper::GetPosition (void) const
 {
+  SATNET_PROFILE_SCOPE (SATELLITE_POSITION);
+
   if (!m_sat)
     return Vector3D (0,0,0);
 
-  JulianDate cur = m_start + Simulator::Now ();
+  Time now = Simulator::Now ();
+  if (m_ephemeris && m_ephemeris->Covers (now))
+    return m_ephemeris->GetPosition (now);
 
-  return m_sat->GetPosition (cur);
+  // minutes since the TLE epoch, from the simulation time in nanoseconds
+  double tsince = m_tsinceStart + now.GetNanoSeconds ()/6e10;
+
+  return m_sat->GetPositionAtTsince (tsince);
 }
 
 Vector3D
@@ -92,12 +104,35 @@ void
 SatellitePositionHelper::SetSatellite (Ptr<Satellite> sat)
 {
   m_sat = sat;
+  UpdateTsinceStart ();
 }
 
 void
 SatellitePositionHelper::SetStartTime (const JulianDate &t)
 {
   m_start = t;
+  m_ephemeris = 0;
+  UpdateTsinceStart ();
+}
+
+Ptr<SatelliteEphemeris>
+SatellitePositionHelper::GetEphemeris (void) const
+{
+  return m_ephemeris;
+}
+
+void
+SatellitePositionHelper::SetEphemeris (Ptr<SatelliteEphemeris> ephemeris)
+{
+  NS_ABORT_MSG_IF (ephemeris && !(ephemeris->GetStartTime () == m_start),
+                   "Ephemeris is not sampled from the start time");
+  m_ephemeris = ephemeris;
+}
+
+void
+SatellitePositionHelper::UpdateTsinceStart (void)
+{
+  m_tsinceStart = (m_sat ? (m_start - m_sat->GetTleEpoch ()).GetNanoSeconds ()/6e10 : 0);
 }
 
 std::ostream
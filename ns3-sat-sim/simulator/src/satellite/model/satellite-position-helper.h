@@ -29,6 +29,7 @@
 #include "ns3/attribute-helper.h"
 
 #include "ns3/satellite.h"
+#include "ns3/satellite-ephemeris.h"
 
 namespace ns3 {
 
@@ -91,6 +92,10 @@ public:
 
   /**
    * @brief Set the underlying satellite object.
+   *
+   * Its TLE information must already be set, as the time between its TLE epoch
+   * and the start time is only computed here and in SetStartTime ().
+   *
    * @param satellite object with SGP4/SDP4 propagation models built-in.
    */
   void SetSatellite (Ptr<Satellite> sat);
@@ -101,9 +106,32 @@ public:
    */
   void SetStartTime(const JulianDate &t);
 
+  /**
+   * @brief Get the precomputed trajectory.
+   * @return the ephemeris, or zero if positions are propagated on every call.
+   */
+  Ptr<SatelliteEphemeris> GetEphemeris (void) const;
+
+  /**
+   * @brief Use a precomputed trajectory for positions within its interval.
+   *
+   * The ephemeris must be sampled from the start time. Setting another start
+   * time afterwards clears it. Velocities are still propagated.
+   *
+   * @param ephemeris ephemeris of the satellite (zero to propagate again).
+   */
+  void SetEphemeris (Ptr<SatelliteEphemeris> ephemeris);
+
 private:
+  /**
+   * @brief Update the minutes from the TLE epoch to the start time.
+   */
+  void UpdateTsinceStart (void);
+
   Ptr<Satellite> m_sat;               //!< pointer to the Satellite object.
   JulianDate m_start;                         //!< simulation's absolute start time.
+  double m_tsinceStart;                       //!< minutes from the TLE epoch to the start time.
+  Ptr<SatelliteEphemeris> m_ephemeris;        //!< precomputed trajectory (optional).
 };
 
 /**
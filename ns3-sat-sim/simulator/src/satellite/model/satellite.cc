@@ -22,6 +22,7 @@
 #include "satellite.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <stdint.h>
 #include <string>
@@ -34,6 +35,7 @@
 #include "ns3/type-id.h"
 #include "ns3/vector.h"
 
+#include "iers-data.h"
 #include "vector-extensions.h"
 
 namespace ns3 {
@@ -58,7 +60,8 @@ Satellite::GetTypeId (void)
 }
 
 Satellite::Satellite (void) :
-  m_name (""), m_tle1 (""), m_tle2 ("")
+  m_name (""), m_tle1 (""), m_tle2 (""), m_tle_epoch_days (0),
+  m_tle_epoch_day_fraction (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
@@ -86,7 +89,7 @@ Satellite::GetTleInfo (void) const
 JulianDate
 Satellite::GetTleEpoch (void) const {
   if (IsInitialized ())
-    return JulianDate (m_sgp4_record.jdsatepoch);
+    return m_tle_epoch;
 
   return JulianDate ();
 }
@@ -94,14 +97,13 @@ Satellite::GetTleEpoch (void) const {
 Vector3D
 Satellite::GetPosition (const JulianDate &t) const
 {
-  double r[3], v[3];
-  //double delta = (t - GetTleEpoch ())*1440;
-  double delta = (t - GetTleEpoch ()).GetMinutes();
-
   if (!IsInitialized ())
     return Vector3D ();
 
-  sgp4 (WGeoSys, m_sgp4_record, delta, r, v);
+  double r[3], v[3];
+
+  // nanoseconds to minutes
+  sgp4 (WGeoSys, m_sgp4_record, (t - m_tle_epoch).GetNanoSeconds ()/6e10, r, v);
 
   if (m_sgp4_record.error != 0)
     return Vector3D ();
@@ -110,12 +112,64 @@ Satellite::GetPosition (const JulianDate &t) const
   return rTemeTorItrf (Vector3D (r[0], r[1], r[2]), t)*1000;
 }
 
+Vector3D
+Satellite::GetPositionAtTsince (double tsince) const
+{
+  return GetPositionAtTsince (tsince, m_sgp4_record);
+}
+
+Vector3D
+Satellite::GetPositionAtTsince (double tsince, elsetrec &record) const
+{
+  double r[3], v[3];
+
+  if (!IsInitialized ())
+    return Vector3D ();
+
+  sgp4 (WGeoSys, record, tsince, r, v);
+
+  if (record.error != 0)
+    return Vector3D ();
+
+  // The date of the frame conversion is kept as plain days and fraction of a
+  // day (no Time or JulianDate objects), the same as GetPosition () would use
+  double fraction = m_tle_epoch_day_fraction + tsince/1440.0;
+  double days = floor (fraction);
+  uint32_t posixDays = static_cast<uint32_t> (m_tle_epoch_days + static_cast<int64_t> (days));
+  fraction -= days;
+
+  // Polar motion and UT1-UTC of the day (see JulianDate::GetPolarMotion ()
+  // and JulianDate::GetGmst ())
+  const std::vector<IersData::EopParameters> &eop = IersData::EopValues;
+  uint32_t pos = posixDays - JulianDate::Posix1992;
+  double xp = 0, yp = 0, dut1 = 0;
+  if (pos < eop.size ())
+    {
+      xp = eop[pos].xp;
+      yp = eop[pos].yp;
+      dut1 = trunc (eop[pos].dut1*1000)/JulianDate::DayToMs;
+    }
+  double ut1Fraction = fraction + dut1;
+  double ut1Days = posixDays + floor (ut1Fraction);
+  ut1Fraction -= floor (ut1Fraction);
+  double gmst = gstime ((ut1Days + ut1Fraction) + JulianDate::PosixEpoch);
+
+  // vector r is in km so it needs to be converted to meters
+  return PefToItrf (xp, yp)*(TemeToPef (gmst)*Vector3D (r[0], r[1], r[2]))*1000;
+}
+
+const elsetrec&
+Satellite::GetSgp4Record (void) const
+{
+  return m_sgp4_record;
+}
+
 Vector3D
 Satellite::GetVelocity (const JulianDate &t) const
 {
   double r[3], v[3];
   //double delta = (t - GetTleEpoch ())*1440;
-  double delta = (t - GetTleEpoch ()).GetMinutes();
+  double delta = (t - GetTleEpoch ()).GetNanoSeconds ()/6e10;
 
   if (!IsInitialized ())
     return Vector3D ();
@@ -183,6 +237,19 @@ Satellite::GetOrbitalPeriod (void) const
   return MilliSeconds (60000*2*M_PI/m_sgp4_record.no);
 }
 
+double
+Satellite::GetPerigeeRadius (void) const
+{
+  if (!IsInitialized ())
+    return 0;
+
+  double tumin, mu, radiusearthkm, xke, j2, j3, j4, j3oj2;
+  getgravconst (WGeoSys, tumin, mu, radiusearthkm, xke, j2, j3, j4, j3oj2);
+
+  // altp is in Earth radii above the surface, radius is in km
+  return (1.0 + m_sgp4_record.altp) * radiusearthkm * 1000;
+}
+
 void
 Satellite::SetName (const std::string &name)
 {
@@ -215,6 +282,11 @@ Satellite::SetTleInfo (const std::string &line1, const std::string &line2)
   twoline2rv (
     l1, l2, 'c', 'e', 'i', WGeoSys, start, stop, delta, m_sgp4_record
   );
+  m_tle_epoch = JulianDate (m_sgp4_record.jdsatepoch);
+  int64_t epochNs = (m_tle_epoch - JulianDate (0, 0)).GetNanoSeconds ();
+  m_tle_epoch_days = epochNs/static_cast<int64_t> (JulianDate::DayToNs);
+  m_tle_epoch_day_fraction =
+    (epochNs % static_cast<int64_t> (JulianDate::DayToNs))/static_cast<double> (JulianDate::DayToNs);
 
   // call propagator to check if it has been properly initialized
   sgp4 (WGeoSys, m_sgp4_record, 0, r, v);
@@ -258,7 +330,12 @@ Satellite::PefToItrf (const JulianDate &t)
 {
   std::pair<double, double> eop = t.GetPolarMotion ();
 
-  const double &xp = eop.first, &yp = eop.second;
+  return PefToItrf (eop.first, eop.second);
+}
+
+Satellite::Matrix
+Satellite::PefToItrf (double xp, double yp)
+{
   const double cosxp = cos (xp), cosyp = cos (yp);
   const double sinxp = sin (xp), sinyp = sin (yp);
 
@@ -282,7 +359,12 @@ Satellite::PefToItrf (const JulianDate &t)
 Satellite::Matrix
 Satellite::TemeToPef (const JulianDate &t)
 {
-  const double gmst = t.GetGmst ();
+  return TemeToPef (t.GetGmst ());
+}
+
+Satellite::Matrix
+Satellite::TemeToPef (double gmst)
+{
   const double cosg = cos (gmst), sing = sin (gmst);
 
   // [from AIAA-2006-6753 Report, Page 32, Appendix C - TEME Coordinate System]
@@ -71,6 +71,11 @@ namespace ns3 {
  * frame to be usable within ns-3: International Terrestrial Reference Frame
  * (ITRF). The conversion itself requires Earth Orientation Parameters (EOP)
  * that are provided by the JulianDate class.
+ *
+ * sgp4 () writes its error code and deep-space integrator state into the
+ * record, so the const member functions are not safe to call concurrently on
+ * the same satellite. Threads which propagate the same satellite each pass
+ * their own copy of the record (see GetSgp4Record ()) to GetPositionAtTsince.
  */
 class Satellite : public Object {
 public:
@@ -127,6 +132,41 @@ public:
    */
   Vector3D GetPosition (const JulianDate &t) const;
 
+  /**
+   * @brief Get the prediction for the satellite's position at a given time
+   *        since the TLE epoch.
+   *
+   * This is the entry point for callers which keep track of the time since
+   * the TLE epoch themselves, such that no Julian date differences have to be
+   * computed for the propagation.
+   *
+   * @param tsince Minutes since the TLE epoch.
+   * @return an ns3::Vector3D object containing the satellite's position,
+   *         in meters, on ITRF coordinate frame.
+   */
+  Vector3D GetPositionAtTsince (double tsince) const;
+
+  /**
+   * @brief Get the prediction for the satellite's position at a given time
+   *        since the TLE epoch, propagating the given record instead of the
+   *        satellite's own.
+   * @param tsince Minutes since the TLE epoch.
+   * @param record Copy of the satellite's SGP4/SDP4 record (GetSgp4Record ()),
+   *        which can be reused for all positions of a trajectory.
+   *
+   * No ns3::Time or JulianDate objects are created, such that threads which
+   * each propagate their own record do not contend on anything.
+   * @return an ns3::Vector3D object containing the satellite's position,
+   *         in meters, on ITRF coordinate frame.
+   */
+  Vector3D GetPositionAtTsince (double tsince, elsetrec &record) const;
+
+  /**
+   * @brief Get the SGP4/SDP4 record of the satellite.
+   * @return the record.
+   */
+  const elsetrec& GetSgp4Record (void) const;
+
   /**
    * @brief Get the prediction for the satellite's velocity at a given time.
    * @param t When.
@@ -150,6 +190,13 @@ public:
    */
   Time GetOrbitalPeriod (void) const;
 
+  /**
+   * @brief Get the satellite's perigee radius.
+   * @return the distance from the Earth's center to the perigee of the
+   *         satellite's (mean) orbit, in meters.
+   */
+  double GetPerigeeRadius (void) const;
+
   /**
    * @brief Set satellite's name.
    * @param name Satellite's name.
@@ -180,6 +227,12 @@ public:
    */
   static std::string ExtractTleSatInfo (const std::string &info);
 
+  /**
+   * @brief Check if the satellite has already been initialized.
+   * @return a boolean indicating whether the satellite is initialized.
+   */
+  bool IsInitialized (void) const;
+
 private:
   /// row of a Matrix
   struct Row {
@@ -211,12 +264,6 @@ private:
     Row m[3];
   };
 
-  /**
-   * @brief Check if the satellite has already been initialized.
-   * @return a boolean indicating whether the satellite is initialized.
-   */
-  bool IsInitialized (void) const;
-
   /**
    * @brief Retrieve the matrix for converting from PEF to ITRF at a given time.
    * @param t When.
@@ -224,6 +271,14 @@ private:
    */
   static Matrix PefToItrf (const JulianDate &t);
 
+  /**
+   * @brief Retrieve the matrix for converting from PEF to ITRF.
+   * @param xp Polar motion along x (radians).
+   * @param yp Polar motion along y (radians).
+   * @return the PEF-ITRF conversion matrix.
+   */
+  static Matrix PefToItrf (double xp, double yp);
+
   /**
    * @brief Retrieve the matrix for converting from TEME to PEF at a given time.
    * @param t When.
@@ -231,6 +286,13 @@ private:
    */
   static Matrix TemeToPef (const JulianDate &t);
 
+  /**
+   * @brief Retrieve the matrix for converting from TEME to PEF.
+   * @param gmst Greenwich mean sidereal time (radians).
+   * @return the TEME-PEF conversion matrix.
+   */
+  static Matrix TemeToPef (double gmst);
+
   /**
    * @brief Retrieve the satellite's position vector in ITRF coordinates.
    * @param t When.
@@ -247,9 +309,13 @@ private:
     const Vector3D &rteme, const Vector3D &vteme, const JulianDate& t
   );
 
+
   std::string m_name;                               //!< satellite's name.
   std::string m_tle1, m_tle2;                       //!< satellite's TLE data.
   mutable elsetrec m_sgp4_record;                   //!< SGP4/SDP4 record.
+  JulianDate m_tle_epoch;                           //!< TLE epoch (of the record).
+  int64_t m_tle_epoch_days;                         //!< TLE epoch, whole days (POSIX).
+  double m_tle_epoch_day_fraction;                  //!< TLE epoch, fraction of the day.
 };
 
 }